@@ -13,12 +13,28 @@
 /**
  * @brief Constructs an Actor, initializes and starts it.
  */
-Actor::Actor() : mScene(Scene::ActiveScene), mActorState(ActorState::Active), mTransform(Transform(this))
+Actor::Actor() : mScene(Scene::ActiveScene), mActorState(ActorState::Active), mTransform(this), mSceneSlot(InvalidSlot)
 {
     Actor::Initialize();
     Actor::Start();
 }
 
+/**
+ * @brief Destructor. Removes the actor from its scene, then deletes its components,
+ * each of them unregistering from the actor, the renderer and the physics.
+ */
+Actor::~Actor()
+{
+    if (mScene)
+    {
+        mScene->RemoveActor(this);
+    }
+    while (!mComponents.empty())
+    {
+        delete mComponents.back();
+    }
+}
+
 /**
  * @brief Initializes the actor. Called upon creation.
  */
@@ -41,9 +57,41 @@ void Actor::Start()
  */
 void Actor::AttachScene(Scene& scene)
 {
+    if (mComponentsScheduled && mScene != &scene)
+    {
+        UnscheduleComponents();
+    }
     mScene = &scene;
 }
 
+/**
+ * @brief Registers the components in the scheduler of the scene. Called when the actor enters the scene.
+ */
+void Actor::ScheduleComponents()
+{
+    if (!mScene) return;
+
+    mComponentsScheduled = true;
+    for (Component* component : mComponents)
+    {
+        mScene->GetComponentScheduler().Register(component);
+    }
+}
+
+/**
+ * @brief Unregisters the components from the scheduler of the scene. Called when the actor leaves the scene.
+ */
+void Actor::UnscheduleComponents()
+{
+    if (!mComponentsScheduled) return;
+
+    mComponentsScheduled = false;
+    for (Component* component : mComponents)
+    {
+        mScene->GetComponentScheduler().Unregister(component);
+    }
+}
+
 /**
  * @brief Adds a component to the actor.
  * @param component Pointer to the component to add.
@@ -51,6 +99,11 @@ void Actor::AttachScene(Scene& scene)
 void Actor::AddComponent(Component* component)
 {
     mComponents.push_back(component);
+    if (mComponentsScheduled)
+    {
+        ComponentScheduler::CheckSharedWrite("the component pools of the scene");
+        mScene->GetComponentScheduler().Register(component);
+    }
 }
 
 /**
@@ -59,6 +112,12 @@ void Actor::AddComponent(Component* component)
  */
 void Actor::RemoveComponent(Component* component)
 {
+    if (mComponentsScheduled)
+    {
+        ComponentScheduler::CheckSharedWrite("the component pools of the scene");
+        mScene->GetComponentScheduler().Unregister(component);
+    }
+    std::fill(mComponentTable.begin(), mComponentTable.end(), nullptr);
     auto it = std::find(mComponents.begin(), mComponents.end(), component);
     if(it != mComponents.end())
     {
@@ -73,6 +132,7 @@ void Actor::RemoveComponent(Component* component)
  */
 void Actor::SetActive(ActorState state)
 {
+    ComponentScheduler::CheckWrite(this);
     mActorState = state;
 }
 
@@ -88,16 +148,23 @@ void Actor::UpdateComponentsTransform()
 }
 
 /**
- * @brief Updates all components and the actor itself.
+ * @brief Updates the actor itself. Components are updated here only when the actor is not in a scene,
+ * otherwise the scene runs them type by type before the actors.
  */
 void Actor::Update()
 {
-    for(Component* component : mComponents)
+    if (!mComponentsScheduled)
     {
-        component->Update();
+        for(Component* component : mComponents)
+        {
+            component->Update();
+        }
     }
     UpdateActor();
-    mTransform.ComputeWorldTransform();
+    if (!mTransform.IsInHierarchy())
+    {
+        mTransform.ComputeWorldTransform();
+    }
 }
 
 /**
@@ -108,11 +175,34 @@ void Actor::UpdateActor()
 }
 
 /**
- * @brief Destroys the actor and removes it from the scene.
+ * @brief Queues the actor for destruction. It is removed and deleted at the end of the scene update.
  */
 void Actor::Destroy()
 {
-    mScene->RemoveActor(this);
+    if (mScene)
+    {
+        mScene->DestroyActor(this);
+    }
+}
+
+/**
+ * @brief Attaches the actor to a parent. Its location, rotation and scale become relative to the parent.
+ * @param pParent The parent, or nullptr to detach the actor.
+ */
+void Actor::AttachTo(Actor* pParent)
+{
+    ComponentScheduler::CheckSharedWrite("the transform hierarchy of the scene");
+    mTransform.SetParent(pParent ? &pParent->mTransform : nullptr);
+}
+
+/**
+ * @brief Returns the parent of the actor.
+ * @return Pointer to the parent, or nullptr if the actor is not attached.
+ */
+Actor* Actor::GetParent() const
+{
+    Transform* parent = mTransform.GetParent();
+    return parent ? parent->owner : nullptr;
 }
 
 /**
@@ -121,7 +211,12 @@ void Actor::Destroy()
  */
 void Actor::SetName(std::string name)
 {
-    mName = name;
+    std::string oldName = std::move(mName);
+    mName = std::move(name);
+    if (mScene)
+    {
+        mScene->OnActorRenamed(this, oldName);
+    }
 }
 
 /**
@@ -151,6 +246,15 @@ Vec3 Actor::GetScale()
     return mTransform.scale;
 }
 
+/**
+ * @brief Gets the position of the actor in world space, including its parents, as of the last transform update.
+ * @return Position as Vec3.
+ */
+Vec3 Actor::GetWorldLocation() const
+{
+    return mTransform.GetWorldPosition();
+}
+
 /**
  * @brief Gets the transform of the actor.
  * @return Reference to the Transform.
@@ -180,9 +284,9 @@ Scene* Actor::GetScene()
 
 /**
  * @brief Gets the list of components attached to the actor.
- * @return Vector of component pointers.
+ * @return Reference to the vector of component pointers.
  */
-std::vector<Component*> Actor::GetComponents()
+const std::vector<Component*>& Actor::GetComponents() const
 {
     return mComponents;
 }
@@ -193,6 +297,7 @@ std::vector<Component*> Actor::GetComponents()
  */
 void Actor::SetLocation(Vec3 loc)
 {
+    ComponentScheduler::CheckWrite(this);
     mTransform.position = loc;
     mTransform.SetNeedsUpdate(true);
 }
@@ -203,6 +308,7 @@ void Actor::SetLocation(Vec3 loc)
  */
 void Actor::AddLocation(Vec3 loc)
 {
+    ComponentScheduler::CheckWrite(this);
     mTransform.position += loc;
     mTransform.SetNeedsUpdate(true);
 }
@@ -213,6 +319,7 @@ void Actor::AddLocation(Vec3 loc)
  */
 void Actor::SetScale(Vec3 scale)
 {
+    ComponentScheduler::CheckWrite(this);
     mTransform.scale = scale;
     mTransform.SetNeedsUpdate(true);
 }
@@ -223,6 +330,7 @@ void Actor::SetScale(Vec3 scale)
  */
 void Actor::SetRotation(Quaternion rotation)
 {
+    ComponentScheduler::CheckWrite(this);
     mTransform.rotation = rotation;
     mTransform.SetNeedsUpdate(true);
 }
@@ -233,6 +341,7 @@ void Actor::SetRotation(Quaternion rotation)
  */
 void Actor::Rotate(Vec3 rotation)
 {
+    ComponentScheduler::CheckWrite(this);
     mTransform.Rotate(rotation);
 }
 
@@ -242,6 +351,7 @@ void Actor::Rotate(Vec3 rotation)
  */
 void Actor::RotateX(float rotation)
 {
+    ComponentScheduler::CheckWrite(this);
     mTransform.RotateX(rotation);
 }
 
@@ -251,6 +361,7 @@ void Actor::RotateX(float rotation)
  */
 void Actor::RotateY(float rotation)
 {
+    ComponentScheduler::CheckWrite(this);
     mTransform.RotateY(rotation);
 }
 
@@ -260,5 +371,6 @@ void Actor::RotateY(float rotation)
  */
 void Actor::RotateZ(float rotation)
 {
+    ComponentScheduler::CheckWrite(this);
     mTransform.RotateZ(rotation);
 }
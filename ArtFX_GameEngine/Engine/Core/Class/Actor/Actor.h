@@ -45,6 +45,30 @@ private:
      */
     std::vector<Component*> mComponents;
 
+    /**
+     * @brief Whether the components are updated by the scene scheduler instead of by Update.
+     */
+    bool mComponentsScheduled = false;
+
+    /**
+     * @brief Components found by GetComponent, indexed by ComponentTypeId.
+     * Only hits are stored, so adding a component keeps them valid and removing one clears the table.
+     */
+    std::vector<Component*> mComponentTable;
+
+    friend class Scene;
+
+    /**
+     * @brief Index of the actor in the actor list of its scene, or InvalidSlot if it is not in the list.
+     */
+    size_t mSceneSlot;
+
+public:
+    /**
+     * @brief Scene slot of an actor that is not in the actor list of a scene.
+     */
+    static constexpr size_t InvalidSlot = static_cast<size_t>(-1);
+
 public:
     /**
      * @brief Actor constructor.
@@ -52,9 +76,9 @@ public:
     Actor();
 
     /**
-     * @brief Virtual destructor.
+     * @brief Virtual destructor. Removes the actor from its scene and deletes its components.
      */
-    virtual ~Actor() = default;
+    virtual ~Actor();
 
 protected:
     /**
@@ -69,7 +93,7 @@ public:
     virtual void Start();
 
     /**
-     * @brief Updates the actor and its components.
+     * @brief Updates the actor, and its components when the scene does not schedule them.
      */
     virtual void Update();
 
@@ -79,7 +103,7 @@ public:
     virtual void UpdateActor();
 
     /**
-     * @brief Destroys the actor and removes it from the scene.
+     * @brief Queues the actor for destruction. It is removed and deleted at the end of the scene update.
      */
     virtual void Destroy();
     
@@ -90,6 +114,16 @@ public:
      */
     void AttachScene(Scene& scene);
 
+    /**
+     * @brief Registers the components in the scheduler of the scene. Called when the actor enters the scene.
+     */
+    void ScheduleComponents();
+
+    /**
+     * @brief Unregisters the components from the scheduler of the scene. Called when the actor leaves the scene.
+     */
+    void UnscheduleComponents();
+
     /**
      * @brief Adds a component to the actor.
      * @param component Pointer to the component to add.
@@ -133,17 +167,37 @@ public:
     }
 
     /**
-     * @brief Sets the name of the actor.
+     * @brief Sets the name of the actor and updates the name index of its scene.
+     * Subclasses may assign mName directly only in their constructor, before the actor is added to a scene.
      * @param name New name.
      */
     void SetName(std::string name);
+
+    /**
+     * @brief Attaches the actor to a parent. Its location, rotation and scale become relative to the parent.
+     * Attaching an actor to one of its children logs an error and does nothing.
+     * @param pParent The parent, or nullptr to detach the actor.
+     */
+    void AttachTo(Actor* pParent);
+
+    /**
+     * @brief Returns the parent of the actor.
+     * @return Pointer to the parent, or nullptr if the actor is not attached.
+     */
+    Actor* GetParent() const;
     
     /**
-     * @brief Returns the position of the actor.
+     * @brief Returns the position of the actor, relative to its parent if it has one.
      * @return Position (Vec3).
      */
     Vec3 GetLocation();
 
+    /**
+     * @brief Returns the position of the actor in world space, as of the last transform update.
+     * @return Position (Vec3).
+     */
+    Vec3 GetWorldLocation() const;
+
     /**
      * @brief Returns the rotation of the actor.
      * @return Rotation (Quaternion).
@@ -176,23 +230,43 @@ public:
 
     /**
      * @brief Returns the list of components attached to the actor.
-     * @return Vector of component pointers.
+     * @return Reference to the vector of component pointers. Copy it before deleting components.
      */
-    std::vector<Component*> GetComponents();
+    const std::vector<Component*>& GetComponents() const;
+
+    /**
+     * @brief Returns the state of the actor.
+     * @return The state, Dead once the actor is queued for destruction.
+     */
+    ActorState GetState() const
+    {
+        return mActorState;
+    }
 
     /**
      * @brief Returns the first component of the specified type attached to the actor.
-     * @tparam T Type of the component to search for.
+     * The first lookup of a type walks the components with Component::IsA, the next ones read the component table.
+     * @tparam T Type of the component to search for, declared with COMPONENT_TYPE.
      * @return Pointer to the component or nullptr if not found.
      */
     template<typename T>T* GetComponent()
     {
+        ComponentTypeId type = T::StaticType();
+        if(type < mComponentTable.size() && mComponentTable[type])
+        {
+            return static_cast<T*>(mComponentTable[type]);
+        }
+
         for(auto component : mComponents)
         {
-            T* result = dynamic_cast<T*>(component);
-            if(result)
+            if(component->IsA(type))
             {
-                return result;
+                if(type >= mComponentTable.size())
+                {
+                    mComponentTable.resize(type + 1, nullptr);
+                }
+                mComponentTable[type] = component;
+                return static_cast<T*>(component);
             }
         }
         return nullptr;
@@ -0,0 +1,137 @@
+/**
+ * @file ActorPool.cpp
+ * @brief Implementation of the ActorPool class, which recycles actors built from a prefab.
+ */
+
+#include "ActorPool.h"
+
+#include "Actor.h"
+#include "Core/Class/Scene/Scene.h"
+#include "Core/Physic/Component/BoxCollisionComponent.h"
+#include "Core/Physic/Component/PolyCollisionComponent.h"
+#include "Core/Physic/Component/RigidbodyComponent.h"
+#include "Core/Physic/Component/SphereCollisionComponent.h"
+#include "Core/Render/Asset.h"
+#include "Core/Render/Component/MeshComponent.h"
+#include "Debug/Log.h"
+
+/**
+ * @brief Constructs a pool and builds its instances in the active scene.
+ * @param pPrefab Template of the instances.
+ * @param pCapacity Number of instances built up front.
+ */
+ActorPool::ActorPool(const ActorPrefab& pPrefab, size_t pCapacity) : mPrefab(pPrefab), mScene(Scene::ActiveScene)
+{
+    mActors.reserve(pCapacity);
+    mFreeActors.reserve(pCapacity);
+    for (size_t i = 0; i < pCapacity; i++)
+    {
+        Instantiate();
+    }
+}
+
+/**
+ * @brief Builds a new instance and adds it to the free list.
+ */
+void ActorPool::Instantiate()
+{
+    Actor* actor = new Actor();
+    actor->SetName(mPrefab.name + "_" + std::to_string(mActors.size()));
+    mScene->AddActor(actor);
+
+    MeshComponent* meshComponent = new MeshComponent(actor);
+    meshComponent->SetMesh(Asset::GetMesh(mPrefab.meshName));
+    if (!mPrefab.textureName.empty())
+    {
+        meshComponent->AddTexture(Asset::GetTexture(mPrefab.textureName));
+    }
+
+    if (mPrefab.hasRigidbody)
+    {
+        new RigidbodyComponent(actor);
+        switch (mPrefab.collisionType)
+        {
+        case CollisionType::Box:
+            new BoxCollisionComponent(actor);
+            break;
+        case CollisionType::Sphere:
+            new SphereCollisionComponent(actor);
+            break;
+        case CollisionType::Mesh:
+            new PolyCollisionComponent(actor);
+            break;
+        default:
+            Log::Error(LogType::Error, "ActorPool does not support this collision type for " + mPrefab.name);
+            break;
+        }
+    }
+
+    mActors.push_back(actor);
+    Deactivate(actor);
+    mFreeActors.push_back(actor);
+}
+
+/**
+ * @brief Pauses and hides an instance, and takes its rigidbody out of the physics world.
+ * @param pActor The instance.
+ */
+void ActorPool::Deactivate(Actor* pActor)
+{
+    pActor->SetActive(ActorState::Paused);
+    pActor->UnscheduleComponents();
+    pActor->GetComponent<MeshComponent>()->SetVisible(false);
+
+    RigidbodyComponent* rigidbody = pActor->GetComponent<RigidbodyComponent>();
+    if (rigidbody && rigidbody->GetPhysicEngine())
+    {
+        rigidbody->GetPhysicEngine()->RemoveRigidbody(rigidbody);
+    }
+}
+
+/**
+ * @brief Takes a free instance and places it in the scene. The pool grows, with a warning, when it is empty.
+ * @param pLocation Location of the instance.
+ * @param pRotation Rotation of the instance.
+ * @return The spawned instance.
+ */
+Actor* ActorPool::Spawn(const Vec3& pLocation, const Quaternion& pRotation)
+{
+    if (mFreeActors.empty())
+    {
+        Log::Warning(LogType::Application, "ActorPool of " + mPrefab.name + " is empty, building a new instance");
+        Instantiate();
+    }
+
+    Actor* actor = mFreeActors.back();
+    mFreeActors.pop_back();
+
+    actor->SetLocation(pLocation);
+    actor->SetRotation(pRotation);
+    actor->SetScale(mPrefab.scale);
+    actor->SetActive(ActorState::Active);
+    actor->ScheduleComponents();
+    actor->GetComponent<MeshComponent>()->SetVisible(true);
+
+    RigidbodyComponent* rigidbody = actor->GetComponent<RigidbodyComponent>();
+    if (rigidbody && rigidbody->GetCollisionComponent())
+    {
+        rigidbody->ClearAll();
+        rigidbody->SetMass(mPrefab.mass);
+        rigidbody->SetFriction(mPrefab.friction);
+        rigidbody->SetRestitution(mPrefab.restitution);
+        mScene->GetPhysicEngine().AddRigidbody(rigidbody);
+    }
+    return actor;
+}
+
+/**
+ * @brief Returns an instance to the pool.
+ * @param pActor The instance, spawned by this pool.
+ */
+void ActorPool::Despawn(Actor* pActor)
+{
+    if (!pActor || pActor->GetState() != ActorState::Active) return;
+
+    Deactivate(pActor);
+    mFreeActors.push_back(pActor);
+}
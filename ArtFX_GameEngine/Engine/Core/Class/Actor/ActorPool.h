@@ -0,0 +1,163 @@
+/**
+ * @file ActorPool.h
+ * @brief Declaration of the ActorPrefab description and the ActorPool class, which recycles actors built from it.
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+
+#include "Core/Physic/Component/BaseCollisionComponent.h"
+#include "Math/Quaternion.h"
+#include "Math/Vec3.h"
+
+class Actor;
+class PhysicEngine;
+class Scene;
+
+/**
+ * @struct ActorPrefab
+ * @brief Template of an actor made of a mesh and an optional rigidbody with its collision shape.
+ */
+struct ActorPrefab
+{
+    /**
+     * @brief Base name of the instances, followed by their index in the pool.
+     */
+    std::string name = "PooledActor";
+
+    /**
+     * @brief Name of the mesh in Asset.
+     */
+    std::string meshName;
+
+    /**
+     * @brief Name of the texture in Asset, or empty for none.
+     */
+    std::string textureName;
+
+    /**
+     * @brief Scale given to each spawned instance.
+     */
+    Vec3 scale = Vec3::one;
+
+    /**
+     * @brief Whether the instances have a rigidbody and a collision shape.
+     */
+    bool hasRigidbody = false;
+
+    /**
+     * @brief Collision shape of the instances. Box, Sphere and Mesh are supported.
+     */
+    CollisionType collisionType = CollisionType::Sphere;
+
+    /**
+     * @brief Mass given to the rigidbody on spawn, 0 for a static body.
+     */
+    float mass = 1.0f;
+
+    /**
+     * @brief Friction given to the rigidbody on spawn.
+     */
+    float friction = 1.0f;
+
+    /**
+     * @brief Restitution given to the rigidbody on spawn.
+     */
+    float restitution = 0.0f;
+};
+
+/**
+ * @class ActorPool
+ * @brief Builds a fixed number of actors from a prefab up front and hands them out on spawn.
+ *
+ * The meshes, shaders and collision shapes are built once per instance when the pool is created.
+ * A despawned instance stays in the scene, paused and hidden, with its rigidbody out of the physics world.
+ * Spawning resets its components from the prefab and puts it back, reusing the capacity of the scene,
+ * scheduler and physics lists, so once every instance has been spawned once the global allocator is not used.
+ * The instances belong to the scene, which deletes them when unloaded. They must be returned with Despawn, not destroyed.
+ */
+class ActorPool
+{
+private:
+    /**
+     * @brief Template of the instances.
+     */
+    ActorPrefab mPrefab;
+
+    /**
+     * @brief Scene owning the instances.
+     */
+    Scene* mScene;
+
+    /**
+     * @brief All the instances built by the pool.
+     */
+    std::vector<Actor*> mActors;
+
+    /**
+     * @brief Instances ready to be spawned.
+     */
+    std::vector<Actor*> mFreeActors;
+
+    /**
+     * @brief Builds a new instance and adds it to the free list.
+     */
+    void Instantiate();
+
+    /**
+     * @brief Pauses and hides an instance, and takes its rigidbody out of the physics world.
+     * @param pActor The instance.
+     */
+    void Deactivate(Actor* pActor);
+
+public:
+    /**
+     * @brief Constructs a pool and builds its instances in the active scene.
+     * @param pPrefab Template of the instances.
+     * @param pCapacity Number of instances built up front.
+     */
+    ActorPool(const ActorPrefab& pPrefab, size_t pCapacity);
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    ActorPool(const ActorPool&) = delete;
+
+    /**
+     * @brief Deleted assignment operator.
+     */
+    ActorPool& operator=(const ActorPool&) = delete;
+
+    /**
+     * @brief Takes a free instance and places it in the scene. The pool grows, with a warning, when it is empty.
+     * @param pLocation Location of the instance.
+     * @param pRotation Rotation of the instance.
+     * @return The spawned instance.
+     */
+    Actor* Spawn(const Vec3& pLocation, const Quaternion& pRotation);
+
+    /**
+     * @brief Returns an instance to the pool.
+     * @param pActor The instance, spawned by this pool.
+     */
+    void Despawn(Actor* pActor);
+
+    /**
+     * @brief Gets the number of instances ready to be spawned.
+     * @return The number of free instances.
+     */
+    size_t GetFreeCount() const
+    {
+        return mFreeActors.size();
+    }
+
+    /**
+     * @brief Gets the number of instances built by the pool.
+     * @return The number of instances.
+     */
+    size_t GetCapacity() const
+    {
+        return mActors.size();
+    }
+};
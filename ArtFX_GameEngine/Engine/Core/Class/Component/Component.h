@@ -1,5 +1,9 @@
 ﻿#pragma once
 
+#include <atomic>
+#include <cstdint>
+#include "ComponentAccess.h"
+#include "ComponentStorage.h"
 #include "Math/Transform.h"
 
 /**
@@ -9,6 +13,23 @@
 
 class Actor;
 
+/**
+ * @brief Identifier of a component class, used to index the component table of the actors.
+ */
+using ComponentTypeId = uint32_t;
+
+/**
+ * @brief Declares the type identifier of a component class. Must be the first line of every class deriving from Component,
+ * otherwise Actor::GetComponent would return its closest declared base.
+ * @param ClassName The component class.
+ * @param BaseName The component class it derives from.
+ */
+#define COMPONENT_TYPE(ClassName, BaseName) \
+public: \
+    static ComponentTypeId StaticType() { static const ComponentTypeId type = Component::NextTypeId(); return type; } \
+    bool IsA(ComponentTypeId pType) const override { return pType == StaticType() || BaseName::IsA(pType); } \
+private:
+
 /**
  * @class Component
  * @brief Base class for components attached to an Actor.
@@ -30,8 +51,45 @@ protected:
      * @brief Update order of the component.
      */
     int mUpdateOrder;
+
+private:
+    friend class ComponentScheduler;
+
+    /**
+     * @brief Index of the pool holding the component in its scene scheduler, or ComponentScheduler::NoPool.
+     */
+    int mPoolIndex = -1;
+
+    /**
+     * @brief Index of the component in its pool, or in the pending components while it waits for its pool.
+     */
+    size_t mPoolSlot = 0;
+
+    /**
+     * @brief Number of type identifiers given so far.
+     */
+    static inline std::atomic<ComponentTypeId> TypeCount = 0;
     
 public:
+    /**
+     * @brief Gives the next free type identifier. Identifiers are dense, starting at 0, in order of first use.
+     * @return A new type identifier.
+     */
+    static ComponentTypeId NextTypeId() { return TypeCount++; }
+
+    /**
+     * @brief Gets the type identifier of the class.
+     * @return The identifier of Component.
+     */
+    static ComponentTypeId StaticType() { static const ComponentTypeId type = NextTypeId(); return type; }
+
+    /**
+     * @brief Checks if the component is an instance of a class, walking up the declared bases without RTTI.
+     * @param pType Type identifier of the class.
+     * @return True if the component is of this class or derives from it.
+     */
+    virtual bool IsA(ComponentTypeId pType) const { return pType == StaticType(); }
+
     /**
      * @brief Constructor for the Component class.
      * @param owner Pointer to the owning Actor.
@@ -66,6 +124,32 @@ public:
      */
     int GetUpdateOrder() const { return mUpdateOrder; }
 
+    /**
+     * @brief Gets the phase of the frame in which the scene updates the component.
+     * @return UpdatePhase::PrePhysics unless overridden.
+     */
+    virtual UpdatePhase GetUpdatePhase() const { return UpdatePhase::PrePhysics; }
+
+    /**
+     * @brief Gets what the update of the component reads and writes. Every component of a type must return the same.
+     * Components that only touch their owner can be updated in parallel by the scene.
+     * @return Everything unless overridden, so the component is updated on the main thread.
+     */
+    virtual ComponentAccess GetAccess() const { return {}; }
+
+    /**
+     * @brief Gets the function updating a batch of components of this exact type without virtual dispatch.
+     * Overridden by POOLED_COMPONENT.
+     * @return nullptr unless overridden, the scheduler then calls the virtual Update of each component.
+     */
+    virtual ComponentBatchUpdate GetBatchUpdate() const { return nullptr; }
+
+    /**
+     * @brief Checks if the component is updated by a scene scheduler rather than by its actor.
+     * @return True if the component is registered in a ComponentScheduler.
+     */
+    bool IsScheduled() const { return mPoolIndex != -1; }
+
     /**
      * @brief Called when the world transform is updated.
      */
@@ -0,0 +1,67 @@
+/**
+ * @file ComponentAccess.h
+ * @brief Update phases and data access declared by the components, used by the ComponentScheduler.
+ */
+
+#pragma once
+#include <cstdint>
+
+/**
+ * @enum UpdatePhase
+ * @brief Update passes of a frame, run by the scene in this order.
+ */
+enum class UpdatePhase : uint8_t
+{
+    PrePhysics,   /**< Before the physics step. Default of the components. */
+    PostPhysics,  /**< After the physics step, the rigidbodies are at their new positions. */
+    Late          /**< After the other phases, for cameras and anything following another actor. */
+};
+
+/**
+ * @brief Number of update phases.
+ */
+constexpr int UpdatePhaseCount = 3;
+
+/**
+ * @enum AccessFlags
+ * @brief Data a component may touch during its update, combined as flags.
+ */
+enum AccessFlags : uint32_t
+{
+    AccessNone = 0,                 /**< Nothing besides the component itself. */
+    AccessOwner = 1 << 0,           /**< The owner actor: its transform, state and other components. */
+    AccessOtherActors = 1 << 1,     /**< Any other actor of the scene and its components. */
+    AccessScene = 1 << 2,           /**< The actor lists of the scene, spawning or destroying actors. */
+    AccessPhysics = 1 << 3,         /**< The physics world and the rigidbodies it steps. */
+    AccessRender = 1 << 4,          /**< The renderer and the GPU resources. */
+    AccessInput = 1 << 5,           /**< The input state. */
+    AccessAll = 0xFFFFFFFF          /**< Anything, the default of the components. */
+};
+
+/**
+ * @struct ComponentAccess
+ * @brief What a component reads and writes during its update.
+ */
+struct ComponentAccess
+{
+    /**
+     * @brief AccessFlags read by the update.
+     */
+    uint32_t reads = AccessAll;
+
+    /**
+     * @brief AccessFlags written by the update.
+     */
+    uint32_t writes = AccessAll;
+
+    /**
+     * @brief Checks if the components of a type can be updated in parallel with each other.
+     * They must only write their owner, and not read other actors that may be written at the same time.
+     * Shared data that is only read, such as the input or the physics world, is never written during the pass.
+     * @return True if two components of different actors never touch the same data.
+     */
+    bool IsOwnerLocal() const
+    {
+        return (writes & ~AccessOwner) == 0 && (reads & AccessOtherActors) == 0;
+    }
+};
@@ -0,0 +1,315 @@
+/**
+ * @file ComponentScheduler.cpp
+ * @brief Implementation of the ComponentScheduler class, which updates the components of a scene type by type.
+ */
+
+#include "ComponentScheduler.h"
+
+#include <algorithm>
+#include <functional>
+#include "Component.h"
+#include "Core/Class/Actor/Actor.h"
+#include "Core/Class/Scene/Scene.h"
+#include "Core/Physic/PhysicEngine.h"
+#include "Core/Thread/JobSystem.h"
+#include "Debug/Log.h"
+#include "Debug/Profiler.h"
+
+/**
+ * @brief Registers a component. Registering a scheduled component does nothing.
+ * The component joins its pool at the next update, its dynamic type is not known yet while constructing.
+ * @param pComponent The component to register.
+ */
+void ComponentScheduler::Register(Component* pComponent)
+{
+    if (pComponent->mPoolIndex != NoPool) return;
+
+    pComponent->mPoolIndex = PendingPool;
+    pComponent->mPoolSlot = mPendingComponents.size();
+    mPendingComponents.push_back(pComponent);
+}
+
+/**
+ * @brief Unregisters a component. Safe to call during the update.
+ * @param pComponent The component to unregister.
+ */
+void ComponentScheduler::Unregister(Component* pComponent)
+{
+    int poolIndex = pComponent->mPoolIndex;
+    if (poolIndex == NoPool) return;
+
+    pComponent->mPoolIndex = NoPool;
+    if (poolIndex == PendingPool)
+    {
+        // The pending list is only walked by the flush, its order does not matter
+        Component* last = mPendingComponents.back();
+        mPendingComponents[pComponent->mPoolSlot] = last;
+        last->mPoolSlot = pComponent->mPoolSlot;
+        mPendingComponents.pop_back();
+        return;
+    }
+
+    std::vector<Component*>& components = mPools[poolIndex].components;
+    if (mUpdating)
+    {
+        // Do not move the other components while their pool is iterated
+        components[pComponent->mPoolSlot] = nullptr;
+        mHasHoles = true;
+        return;
+    }
+
+    Component* last = components.back();
+    components[pComponent->mPoolSlot] = last;
+    last->mPoolSlot = pComponent->mPoolSlot;
+    components.pop_back();
+}
+
+/**
+ * @brief Updates the scheduled components of a phase, pool by pool in update order.
+ * Components registered during the update wait for the next one.
+ * @param pPhase The phase to run.
+ */
+void ComponentScheduler::Update(UpdatePhase pPhase)
+{
+#if PROFILER_ENABLED
+    static const char* const PhaseScopes[UpdatePhaseCount] = {"Components::PrePhysics", "Components::PostPhysics", "Components::Late"};
+    PROFILE_SCOPE(PhaseScopes[static_cast<int>(pPhase)]);
+#endif
+    FlushPendingComponents();
+
+    mUpdating = true;
+    for (int poolIndex : mPoolOrder[static_cast<int>(pPhase)])
+    {
+        const ComponentPool& pool = mPools[poolIndex];
+        if (mJobSystem && pool.access.IsOwnerLocal() && pool.components.size() >= ParallelMinComponents)
+        {
+            UpdateParallel(pool);
+        }
+        else
+        {
+            UpdateBatch(pool, pool.components.data(), pool.components.size());
+        }
+    }
+    mUpdating = false;
+
+    if (mHasHoles)
+    {
+        CompactPools();
+    }
+}
+
+/**
+ * @brief Unschedules every component and removes all the pools.
+ */
+void ComponentScheduler::Clear()
+{
+    for (ComponentPool& pool : mPools)
+    {
+        for (Component* component : pool.components)
+        {
+            if (component) component->mPoolIndex = NoPool;
+        }
+    }
+    for (Component* component : mPendingComponents)
+    {
+        component->mPoolIndex = NoPool;
+    }
+
+    mPools.clear();
+    for (std::vector<int>& order : mPoolOrder)
+    {
+        order.clear();
+    }
+    mPendingComponents.clear();
+    mHasHoles = false;
+}
+
+/**
+ * @brief Moves the pending components into their pools.
+ * The pools of stored types that received components are sorted back in address order.
+ */
+void ComponentScheduler::FlushPendingComponents()
+{
+    if (mPendingComponents.empty()) return;
+
+    mSortedPools.clear();
+    for (Component* component : mPendingComponents)
+    {
+        int poolIndex = FindOrCreatePool(component);
+        ComponentPool& pool = mPools[poolIndex];
+        component->mPoolIndex = poolIndex;
+        component->mPoolSlot = pool.components.size();
+        pool.components.push_back(component);
+        if (pool.update && (mSortedPools.empty() || mSortedPools.back() != poolIndex))
+        {
+            mSortedPools.push_back(poolIndex);
+        }
+    }
+    mPendingComponents.clear();
+
+    std::sort(mSortedPools.begin(), mSortedPools.end());
+    mSortedPools.erase(std::unique(mSortedPools.begin(), mSortedPools.end()), mSortedPools.end());
+    for (int poolIndex : mSortedPools)
+    {
+        std::vector<Component*>& components = mPools[poolIndex].components;
+        std::sort(components.begin(), components.end(), std::less<Component*>());
+        for (size_t i = 0; i < components.size(); i++)
+        {
+            components[i]->mPoolSlot = i;
+        }
+    }
+}
+
+/**
+ * @brief Gets the pool of a component type, update phase and order, creating it if needed.
+ * A scene only has a few dozen component types, so a linear search is enough.
+ * @param pComponent A component of the pool.
+ * @return Index of the pool.
+ */
+int ComponentScheduler::FindOrCreatePool(const Component* pComponent)
+{
+    std::type_index type = typeid(*pComponent);
+    int updateOrder = pComponent->GetUpdateOrder();
+    UpdatePhase phase = pComponent->GetUpdatePhase();
+    for (int i = 0; i < static_cast<int>(mPools.size()); i++)
+    {
+        if (mPools[i].type == type && mPools[i].updateOrder == updateOrder && mPools[i].phase == phase) return i;
+    }
+
+    int poolIndex = static_cast<int>(mPools.size());
+    mPools.push_back({ type, updateOrder, phase, pComponent->GetAccess(), pComponent->GetBatchUpdate(), {} });
+
+    std::vector<int>& order = mPoolOrder[static_cast<int>(phase)];
+    auto it = std::upper_bound(order.begin(), order.end(), updateOrder,
+        [this](int pOrder, int pIndex) { return pOrder < mPools[pIndex].updateOrder; });
+    order.insert(it, poolIndex);
+    return poolIndex;
+}
+
+/**
+ * @brief Updates a batch of components of a pool, through the non virtual update of their type when it has one.
+ * @param pPool The pool.
+ * @param pComponents The components, with possible holes.
+ * @param pCount Number of components.
+ */
+void ComponentScheduler::UpdateBatch(const ComponentPool& pPool, Component* const* pComponents, size_t pCount)
+{
+    if (pPool.update)
+    {
+        pPool.update(pComponents, pCount);
+        return;
+    }
+    for (size_t i = 0; i < pCount; i++)
+    {
+        if (pComponents[i])
+        {
+            pComponents[i]->Update();
+        }
+    }
+}
+
+/**
+ * @brief Updates the components of an owner local pool over the job system.
+ * Actors linked to a parent or children stay on the calling thread, moving them marks the others dirty.
+ * No component can be registered or removed meanwhile, that would write the scene.
+ * The active scene and the physics world are thread local, so each job runs with the ones of the calling thread.
+ * @param pPool The pool.
+ */
+void ComponentScheduler::UpdateParallel(const ComponentPool& pPool)
+{
+    mParallelComponents.clear();
+    mSerialComponents.clear();
+    for (Component* component : pPool.components)
+    {
+        if (!component) continue;
+
+        const Transform& transform = component->GetOwner()->GetTransform();
+        if (transform.GetParent() || !transform.GetChildren().empty())
+        {
+            mSerialComponents.push_back(component);
+        }
+        else
+        {
+            mParallelComponents.push_back(component);
+        }
+    }
+
+#ifdef _DEBUG
+    if (HasSharedOwner())
+    {
+        Log::Error(LogType::Error, std::string("Components of type ") + pPool.type.name() +
+            " share an owner and can not be updated in parallel, the pool runs on the main thread");
+        UpdateBatch(pPool, pPool.components.data(), pPool.components.size());
+        return;
+    }
+#endif
+
+    Scene* scene = Scene::ActiveScene;
+    PhysicEngine* physicEngine = &PhysicEngine::GetInstance();
+    mJobSystem->ParallelFor(mParallelComponents.size(), ParallelBatchSize, [this, &pPool, scene, physicEngine](size_t pBegin, size_t pEnd)
+    {
+        Scene* previousScene = Scene::ActiveScene;
+        PhysicEngine* previousPhysicEngine = PhysicEngine::GetThreadInstance();
+        Scene::ActiveScene = scene;
+        PhysicEngine::SetThreadInstance(physicEngine);
+#ifdef _DEBUG
+        // One component at a time, so a conflicting write is reported with its owner
+        for (size_t i = pBegin; i < pEnd; i++)
+        {
+            ParallelOwner = mParallelComponents[i]->GetOwner();
+            UpdateBatch(pPool, mParallelComponents.data() + i, 1);
+        }
+        ParallelOwner = nullptr;
+#else
+        UpdateBatch(pPool, mParallelComponents.data() + pBegin, pEnd - pBegin);
+#endif
+        Scene::ActiveScene = previousScene;
+        PhysicEngine::SetThreadInstance(previousPhysicEngine);
+    });
+
+    UpdateBatch(pPool, mSerialComponents.data(), mSerialComponents.size());
+}
+
+#ifdef _DEBUG
+/**
+ * @brief Logs a write that races with the other components of a parallel pool.
+ * @param pTarget Description of the written data.
+ */
+void ComponentScheduler::ReportConflict(const std::string& pTarget)
+{
+    Log::Error(LogType::Error, "Conflicting write: a component of " + ParallelOwner->GetName() +
+        " updated in parallel wrote " + pTarget + ", its GetAccess must not declare it owner local");
+}
+
+/**
+ * @brief Checks that no two components of a parallel pool share their owner.
+ * @return True if an owner appears twice.
+ */
+bool ComponentScheduler::HasSharedOwner()
+{
+    std::vector<Actor*> owners;
+    owners.reserve(mParallelComponents.size());
+    for (Component* component : mParallelComponents)
+    {
+        owners.push_back(component->GetOwner());
+    }
+    std::sort(owners.begin(), owners.end());
+    return std::adjacent_find(owners.begin(), owners.end()) != owners.end();
+}
+#endif
+
+/**
+ * @brief Removes the holes left in the pools during the update.
+ */
+void ComponentScheduler::CompactPools()
+{
+    for (ComponentPool& pool : mPools)
+    {
+        std::erase(pool.components, nullptr);
+        for (size_t i = 0; i < pool.components.size(); i++)
+        {
+            pool.components[i]->mPoolSlot = i;
+        }
+    }
+    mHasHoles = false;
+}
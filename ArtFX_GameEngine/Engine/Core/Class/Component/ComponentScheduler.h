@@ -0,0 +1,254 @@
+/**
+ * @file ComponentScheduler.h
+ * @brief Declaration of the ComponentScheduler class, which updates the components of a scene type by type.
+ */
+
+#pragma once
+#include <array>
+#include <string>
+#include <typeindex>
+#include <vector>
+#include "ComponentAccess.h"
+#include "ComponentStorage.h"
+
+class Actor;
+class Component;
+class JobSystem;
+
+/**
+ * @struct ComponentPool
+ * @brief Dense list of the components of one type sharing the same update phase and order.
+ */
+struct ComponentPool
+{
+    /**
+     * @brief Dynamic type of the components.
+     */
+    std::type_index type;
+
+    /**
+     * @brief Update order shared by the components.
+     */
+    int updateOrder;
+
+    /**
+     * @brief Update phase shared by the components.
+     */
+    UpdatePhase phase;
+
+    /**
+     * @brief What the components read and write, declared by their type.
+     */
+    ComponentAccess access;
+
+    /**
+     * @brief Non virtual update of the type when it is stored in a ComponentStorage, nullptr otherwise.
+     */
+    ComponentBatchUpdate update;
+
+    /**
+     * @brief Components of the pool. Holes left by removals during an update are compacted after it.
+     * The components of a stored type are kept in address order, so the pass walks their storage forward.
+     */
+    std::vector<Component*> components;
+};
+
+/**
+ * @class ComponentScheduler
+ * @brief Stores the components of a scene in per-type pools and updates each pool as one linear pass.
+ *
+ * Each update phase runs its pools by increasing update order, so every component of a type is updated in a row
+ * instead of jumping between actors. A component is registered when its actor enters the scene, but only joins its
+ * pool at the start of the next update, once its dynamic type is known. Each component stores its pool and slot,
+ * so removals are O(1).
+ *
+ * The types created in numbers are declared with POOLED_COMPONENT: their components live by value in the chunks
+ * of their ComponentStorage, and their pool is updated by a loop calling their Update directly instead of through
+ * the virtual table. The other types keep a virtual call per component.
+ *
+ * Pools whose type only touches its owner are split over the job system. In debug builds, a component updated
+ * in parallel that writes another actor or the scene is reported with Log::Error.
+ */
+class ComponentScheduler
+{
+private:
+    /**
+     * @brief All the pools, never reordered so the pool index stored in the components stays valid.
+     */
+    std::vector<ComponentPool> mPools;
+
+    /**
+     * @brief Indices of the pools of each phase sorted by update order, pools of equal order keep their creation order.
+     */
+    std::array<std::vector<int>, UpdatePhaseCount> mPoolOrder;
+
+    /**
+     * @brief Job system running the owner local pools, or nullptr to update everything on the calling thread.
+     */
+    JobSystem* mJobSystem = nullptr;
+
+    /**
+     * @brief Components of the pool being updated that run in parallel. Kept between updates to avoid reallocations.
+     */
+    std::vector<Component*> mParallelComponents;
+
+    /**
+     * @brief Components of the pool being updated that stay on the calling thread.
+     */
+    std::vector<Component*> mSerialComponents;
+
+#ifdef _DEBUG
+    /**
+     * @brief Owner of the component updated in parallel by this thread, nullptr outside of a parallel pool.
+     */
+    static inline thread_local Actor* ParallelOwner = nullptr;
+
+    /**
+     * @brief Logs a write that races with the other components of a parallel pool.
+     * @param pTarget Description of the written data.
+     */
+    static void ReportConflict(const std::string& pTarget);
+
+    /**
+     * @brief Checks that no two components of a parallel pool share their owner.
+     * @return True if an owner appears twice.
+     */
+    bool HasSharedOwner();
+#endif
+
+    /**
+     * @brief Components registered since the last update.
+     */
+    std::vector<Component*> mPendingComponents;
+
+    /**
+     * @brief Pools of stored types to sort back in address order after a flush. Kept between updates to avoid reallocations.
+     */
+    std::vector<int> mSortedPools;
+
+    /**
+     * @brief Whether the pools are being updated.
+     */
+    bool mUpdating = false;
+
+    /**
+     * @brief Whether components were removed during the update and left holes in their pools.
+     */
+    bool mHasHoles = false;
+
+    /**
+     * @brief Moves the pending components into their pools.
+     */
+    void FlushPendingComponents();
+
+    /**
+     * @brief Gets the pool of a component type, update phase and order, creating it if needed.
+     * @param pComponent A component of the pool.
+     * @return Index of the pool.
+     */
+    int FindOrCreatePool(const Component* pComponent);
+
+    /**
+     * @brief Updates a batch of components of a pool, through the non virtual update of their type when it has one.
+     * @param pPool The pool.
+     * @param pComponents The components, with possible holes.
+     * @param pCount Number of components.
+     */
+    static void UpdateBatch(const ComponentPool& pPool, Component* const* pComponents, size_t pCount);
+
+    /**
+     * @brief Updates the components of an owner local pool over the job system.
+     * Actors linked to a parent or children stay on the calling thread, moving them marks the others dirty.
+     * @param pPool The pool.
+     */
+    void UpdateParallel(const ComponentPool& pPool);
+
+    /**
+     * @brief Removes the holes left in the pools during the update.
+     */
+    void CompactPools();
+
+public:
+    /**
+     * @brief Pool index of a component waiting for the next update.
+     */
+    static constexpr int PendingPool = -2;
+
+    /**
+     * @brief Pool index of a component that is not scheduled.
+     */
+    static constexpr int NoPool = -1;
+
+    /**
+     * @brief Registers a component. Registering a scheduled component does nothing.
+     * @param pComponent The component to register.
+     */
+    void Register(Component* pComponent);
+
+    /**
+     * @brief Unregisters a component. Safe to call during the update.
+     * @param pComponent The component to unregister.
+     */
+    void Unregister(Component* pComponent);
+
+    /**
+     * @brief Minimum number of components in a pool before it is split over the job system.
+     */
+    static constexpr size_t ParallelMinComponents = 64;
+
+    /**
+     * @brief Number of components a worker updates at once.
+     */
+    static constexpr size_t ParallelBatchSize = 32;
+
+    /**
+     * @brief Updates the scheduled components of a phase, pool by pool in update order.
+     * @param pPhase The phase to run.
+     */
+    void Update(UpdatePhase pPhase);
+
+    /**
+     * @brief Sets the job system running the owner local pools.
+     * @param pJobSystem The job system, or nullptr to update everything on the calling thread.
+     */
+    void SetJobSystem(JobSystem* pJobSystem)
+    {
+        mJobSystem = pJobSystem;
+    }
+
+    /**
+     * @brief In debug builds, reports a write to an actor by a parallel component of another actor. Does nothing in release.
+     * @param pActor The written actor.
+     */
+    static void CheckWrite([[maybe_unused]] Actor* pActor)
+    {
+#ifdef _DEBUG
+        if (ParallelOwner && ParallelOwner != pActor) ReportConflict("another actor");
+#endif
+    }
+
+    /**
+     * @brief In debug builds, reports a write to data shared by the scene from a parallel component. Does nothing in release.
+     * @param pTarget Description of the written data.
+     */
+    static void CheckSharedWrite([[maybe_unused]] const char* pTarget)
+    {
+#ifdef _DEBUG
+        if (ParallelOwner) ReportConflict(pTarget);
+#endif
+    }
+
+    /**
+     * @brief Unschedules every component and removes all the pools.
+     */
+    void Clear();
+
+    /**
+     * @brief Gets the number of pools.
+     * @return The number of component type and update order pairs seen by the scheduler.
+     */
+    size_t GetPoolCount() const
+    {
+        return mPools.size();
+    }
+};
@@ -0,0 +1,149 @@
+/**
+ * @file ComponentStorage.h
+ * @brief Declaration of the ComponentStorage class, which stores the components of a hot type contiguously.
+ */
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <typeinfo>
+#include <vector>
+
+class Component;
+
+/**
+ * @brief Updates a batch of components of one exact type, holes included, without virtual dispatch.
+ */
+using ComponentBatchUpdate = void (*)(Component* const* pComponents, size_t pCount);
+
+/**
+ * @class ComponentStorage
+ * @brief Stores the components of one type by value in chunks of contiguous slots.
+ *
+ * The components are still created with new and owned by their actor: the class operators added by
+ * POOLED_COMPONENT place them in the slots of the storage of their type, so the components of a type sit next to
+ * each other in memory instead of being spread over the heap. Freed slots are reused before a new chunk is
+ * allocated, so once a scene has reached its size, spawning and destroying components does not touch the global
+ * allocator. Classes deriving from a pooled type with a different size fall back to the global allocator.
+ * @tparam T The component type.
+ */
+template<typename T>
+class ComponentStorage
+{
+private:
+    /**
+     * @brief Uninitialized memory of one component.
+     */
+    struct alignas(T) Slot
+    {
+        std::byte data[sizeof(T)];
+    };
+
+    /**
+     * @brief Number of components per chunk.
+     */
+    static constexpr size_t ChunkSize = 64;
+
+    /**
+     * @brief Allocated chunks, never released before the end of the program so the components never move.
+     */
+    std::vector<std::unique_ptr<Slot[]>> mChunks;
+
+    /**
+     * @brief Free slots, the last freed one is reused first while it is still in cache.
+     */
+    std::vector<Slot*> mFreeSlots;
+
+    /**
+     * @brief Protects the storage, scenes streamed in the background create their components on another thread.
+     */
+    std::mutex mMutex;
+
+    /**
+     * @brief Gets the storage of the type.
+     * @return The storage.
+     */
+    static ComponentStorage& GetInstance()
+    {
+        static ComponentStorage storage;
+        return storage;
+    }
+
+public:
+    /**
+     * @brief Allocates the memory of a component, used by the operator new of the pooled class.
+     * @param pSize Size of the dynamic type being created.
+     * @return The memory of the component.
+     */
+    static void* Allocate(size_t pSize)
+    {
+        if (pSize != sizeof(T)) return ::operator new(pSize);
+
+        ComponentStorage& storage = GetInstance();
+        std::lock_guard lock(storage.mMutex);
+        if (storage.mFreeSlots.empty())
+        {
+            Slot* chunk = storage.mChunks.emplace_back(new Slot[ChunkSize]).get();
+            // Pushed backwards so the slots are handed out in address order
+            for (size_t i = ChunkSize; i > 0; i--)
+            {
+                storage.mFreeSlots.push_back(chunk + i - 1);
+            }
+        }
+        Slot* slot = storage.mFreeSlots.back();
+        storage.mFreeSlots.pop_back();
+        return slot;
+    }
+
+    /**
+     * @brief Frees the memory of a component, used by the operator delete of the pooled class.
+     * @param pPointer The memory of the component.
+     * @param pSize Size of the dynamic type being destroyed.
+     */
+    static void Free(void* pPointer, size_t pSize)
+    {
+        if (!pPointer) return;
+        if (pSize != sizeof(T))
+        {
+            ::operator delete(pPointer);
+            return;
+        }
+
+        ComponentStorage& storage = GetInstance();
+        std::lock_guard lock(storage.mMutex);
+        storage.mFreeSlots.push_back(static_cast<Slot*>(pPointer));
+    }
+
+    /**
+     * @brief Updates a batch of components whose dynamic type is exactly T, calling T::Update directly.
+     * @param pComponents The components, with possible holes.
+     * @param pCount Number of components.
+     */
+    static void UpdateBatch(Component* const* pComponents, size_t pCount)
+    {
+        for (size_t i = 0; i < pCount; i++)
+        {
+            if (pComponents[i])
+            {
+                static_cast<T*>(pComponents[i])->T::Update();
+            }
+        }
+    }
+};
+
+/**
+ * @brief Stores the components of a class in its ComponentStorage and lets the scheduler update them without virtual
+ * dispatch. Must follow COMPONENT_TYPE in the class, and only be used for types created in numbers.
+ * @param ClassName The component class.
+ */
+#define POOLED_COMPONENT(ClassName) \
+public: \
+    static void* operator new(size_t pSize) { return ComponentStorage<ClassName>::Allocate(pSize); } \
+    static void operator delete(void* pPointer, size_t pSize) { ComponentStorage<ClassName>::Free(pPointer, pSize); } \
+    ComponentBatchUpdate GetBatchUpdate() const override \
+    { \
+        return typeid(*this) == typeid(ClassName) ? &ComponentStorage<ClassName>::UpdateBatch : nullptr; \
+    } \
+private:
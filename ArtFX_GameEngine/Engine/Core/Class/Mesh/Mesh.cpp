@@ -5,8 +5,10 @@
 
 #include "Mesh.h"
 #include <algorithm>
+#include "MeshOptimizer.h"
 #include "Core/Render/Asset.h"
 #include "Core/Render/OpenGL/VertexArray.h"
+#include "Core/Render/Shader/ShaderCache.h"
 #include "Debug/Log.h"
 
 /// Default constructor for Mesh.
@@ -14,20 +16,35 @@ Mesh::Mesh() : mVertexArray(nullptr)
 {
 }
 
-/// Constructs a Mesh from a list of vertices.
+/// Constructs a Mesh from a list of vertices and the triangles indexing them.
 /// @param vertices The vertices to initialize the mesh with.
-Mesh::Mesh(std::vector<Vertex> vertices) : mVertices(std::move(vertices)), mVertexArray(nullptr)
+/// @param indices Three indices into the vertices per triangle.
+/// @param pUploadToGpu Whether to create the vertex array and shaders. False for headless simulations.
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, bool pUploadToGpu) : mVertices(std::move(vertices)),
+mIndices(std::move(indices)), mVertexArray(nullptr)
 {
-    float* verticeInfo = ToVerticeArray();
-    mVertexArray = new VertexArray(verticeInfo, mVertices.size());
-    delete[] verticeInfo;
-    verticeInfo = nullptr;
-    mVertexShader.Load("BasicMesh.vert", ShaderType::VERTEX);
-    mFragmentShader.Load("BasicMesh.frag", ShaderType::FRAGMENT);
-    mShaderProgram.Compose({&mVertexShader, &mFragmentShader });
-    AddTexture(&Asset::GetTexture("BaseTexture"));
     CalculateRadius();
     CalculateBoundingBox();
+    CalculateMassProperties();
+    if (pUploadToGpu)
+    {
+        UploadToGpu();
+        AddTexture(&Asset::GetTexture("BaseTexture"));
+    }
+}
+
+/// Creates the vertex array and gets the shared mesh program. Must run on the thread owning the GL context.
+/// A mesh built on another thread without upload is uploaded later this way, its base texture is not set.
+/// The vertices are quantized to 16 bytes, the bounding box must be computed before.
+void Mesh::UploadToGpu()
+{
+    std::vector<unsigned char> packedVertices;
+    bool halfTexCoords = MeshOptimizer::QuantizeVertices(mVertices, mBoundingBox, packedVertices, mVertexTransform);
+    mVertexArray = new VertexArray(packedVertices.data(), static_cast<unsigned int>(mVertices.size()), VertexLayout::Compact(halfTexCoords),
+        mIndices.data(), static_cast<unsigned int>(mIndices.size()));
+    mShaderProgram = ShaderCache::GetProgram({{"BasicMesh.vert", ShaderType::VERTEX}, {"BasicMesh.frag", ShaderType::FRAGMENT}});
+    mInstancedShaderProgram = ShaderCache::GetProgram({{"BasicMesh.vert", ShaderType::VERTEX}, {"BasicMesh.frag", ShaderType::FRAGMENT}},
+        "#define INSTANCED\n");
 }
 
 /// Unloads mesh resources and deletes the vertex array.
@@ -55,11 +72,12 @@ void Mesh::AddTexture(Texture* pTexture)
     mTextures.emplace_back(pTexture);
 }
 
-/// Sets the shader program for the mesh.
-/// @param pShaderProgram Reference to the shader program.
-void Mesh::SetShaderProgram(ShaderProgram& pShaderProgram)
+/// Sets the shader program for the mesh. The instanced variant no longer matches, so the mesh is not instanced anymore.
+/// @param pShaderProgram Pointer to the shader program, which must outlive the mesh.
+void Mesh::SetShaderProgram(ShaderProgram* pShaderProgram)
 {
     mShaderProgram = pShaderProgram;
+    mInstancedShaderProgram = nullptr;
 }
 
 /// Sets the vertex array object for the mesh.
@@ -95,27 +113,6 @@ void Mesh::SetRadius(float radius)
     mRadius = radius;
 }
 
-/// Converts the mesh's vertices to a float array.
-/// @return Pointer to the float array (caller must delete[]).
-float* Mesh::ToVerticeArray()
-{
-    float* array = new float[mVertices.size() * 8];
-    int counter = 0;
-    for (int i = 0; i < mVertices.size(); i++)
-    {
-        array[counter] = mVertices[i].position.x;
-        array[counter + 1] = mVertices[i].position.y;
-        array[counter + 2] = mVertices[i].position.z;
-        array[counter + 3] = mVertices[i].normal.x;
-        array[counter + 4] = mVertices[i].normal.y;
-        array[counter + 5] = mVertices[i].normal.z;
-        array[counter + 6] = mVertices[i].texCoord.x;
-        array[counter + 7] = mVertices[i].texCoord.y;
-        counter += 8;
-    }
-    return array;
-}
-
 /// Calculates the bounding sphere radius of the mesh.
 void Mesh::CalculateRadius()
 {
@@ -125,13 +122,14 @@ void Mesh::CalculateRadius()
         return;
     }
     
+    // Averaged over the corners of the triangles
     Vec3 center = Vec3::zero;
 
-    for (const Vertex& vertex : mVertices)
+    for (unsigned int index : mIndices)
     {
-        center += vertex.position;
+        center += mVertices[index].position;
     }
-    center /= static_cast<float>(mVertices.size());
+    center /= static_cast<float>(std::max<size_t>(mIndices.size(), 1));
     
     float maxDistanceSquared = 0.0f;
     for (const Vertex& vertex : mVertices)
@@ -165,3 +163,132 @@ void Mesh::CalculateBoundingBox()
 
     mBoundingBox = boundingBox;
 }
+
+
+/// Calculates the mass properties of the mesh.
+/// Integrates over the volume enclosed by the triangles (divergence theorem, Eberly's polyhedral mass properties)
+/// and expresses the result for a uniform density and a unit mass.
+void Mesh::CalculateMassProperties()
+{
+    if (mVertices.empty())
+    {
+        mMassProperties = MassProperties();
+        return;
+    }
+
+    auto subexpressions = [](double w0, double w1, double w2, double& f1, double& f2, double& f3, double& g0, double& g1, double& g2)
+    {
+        double temp0 = w0 + w1;
+        f1 = temp0 + w2;
+        double temp1 = w0 * w0;
+        double temp2 = temp1 + w1 * temp0;
+        f2 = temp2 + w2 * f1;
+        f3 = w0 * temp1 + w1 * temp2 + w2 * f2;
+        g0 = f2 + w0 * (f1 + w0);
+        g1 = f2 + w1 * (f1 + w1);
+        g2 = f2 + w2 * (f1 + w2);
+    };
+
+    // 1, x, y, z, x^2, y^2, z^2, xy, yz, zx
+    double integral[10] = {};
+    for (size_t i = 0; i + 2 < mIndices.size(); i += 3)
+    {
+        const Vec3& p0 = mVertices[mIndices[i]].position;
+        const Vec3& p1 = mVertices[mIndices[i + 1]].position;
+        const Vec3& p2 = mVertices[mIndices[i + 2]].position;
+
+        double a1 = p1.x - p0.x, b1 = p1.y - p0.y, c1 = p1.z - p0.z;
+        double a2 = p2.x - p0.x, b2 = p2.y - p0.y, c2 = p2.z - p0.z;
+        double d0 = b1 * c2 - b2 * c1;
+        double d1 = a2 * c1 - a1 * c2;
+        double d2 = a1 * b2 - a2 * b1;
+
+        double f1x, f2x, f3x, g0x, g1x, g2x;
+        double f1y, f2y, f3y, g0y, g1y, g2y;
+        double f1z, f2z, f3z, g0z, g1z, g2z;
+        subexpressions(p0.x, p1.x, p2.x, f1x, f2x, f3x, g0x, g1x, g2x);
+        subexpressions(p0.y, p1.y, p2.y, f1y, f2y, f3y, g0y, g1y, g2y);
+        subexpressions(p0.z, p1.z, p2.z, f1z, f2z, f3z, g0z, g1z, g2z);
+
+        integral[0] += d0 * f1x;
+        integral[1] += d0 * f2x;
+        integral[2] += d1 * f2y;
+        integral[3] += d2 * f2z;
+        integral[4] += d0 * f3x;
+        integral[5] += d1 * f3y;
+        integral[6] += d2 * f3z;
+        integral[7] += d0 * (p0.y * g0x + p1.y * g1x + p2.y * g2x);
+        integral[8] += d1 * (p0.z * g0y + p1.z * g1y + p2.z * g2y);
+        integral[9] += d2 * (p0.x * g0z + p1.x * g1z + p2.x * g2z);
+    }
+
+    integral[0] /= 6.0;
+    integral[1] /= 24.0;
+    integral[2] /= 24.0;
+    integral[3] /= 24.0;
+    integral[4] /= 60.0;
+    integral[5] /= 60.0;
+    integral[6] /= 60.0;
+    integral[7] /= 120.0;
+    integral[8] /= 120.0;
+    integral[9] /= 120.0;
+
+    Vec3 size = mBoundingBox.max - mBoundingBox.min;
+    double boxVolume = static_cast<double>(size.x) * size.y * size.z;
+    double volume = integral[0];
+
+    // Open or flat meshes enclose no meaningful volume, approximate them with a solid box
+    if (fabs(volume) <= std::max(boxVolume * 1e-3, 1e-9))
+    {
+        Vec3 size2 = size * size;
+        Vec3 center = (mBoundingBox.min + mBoundingBox.max) * 0.5f;
+
+        mMassProperties.volume = static_cast<float>(boxVolume);
+        mMassProperties.centerOfMass = center;
+        mMassProperties.inertia = Mat3();
+        mMassProperties.inertia.m[0][0] = (size2.y + size2.z) / 12.0f;
+        mMassProperties.inertia.m[1][1] = (size2.x + size2.z) / 12.0f;
+        mMassProperties.inertia.m[2][2] = (size2.x + size2.y) / 12.0f;
+    }
+    else
+    {
+        // Inward-facing winding only flips the sign of every integral
+        double sign = volume < 0.0 ? -1.0 : 1.0;
+        double inverseVolume = 1.0 / volume;
+
+        Vec3 center(static_cast<float>(integral[1] * inverseVolume),
+                    static_cast<float>(integral[2] * inverseVolume),
+                    static_cast<float>(integral[3] * inverseVolume));
+
+        double xx = (integral[5] + integral[6]) * inverseVolume - (center.y * center.y + center.z * center.z);
+        double yy = (integral[4] + integral[6]) * inverseVolume - (center.z * center.z + center.x * center.x);
+        double zz = (integral[4] + integral[5]) * inverseVolume - (center.x * center.x + center.y * center.y);
+        double xy = -(integral[7] * inverseVolume - center.x * center.y);
+        double yz = -(integral[8] * inverseVolume - center.y * center.z);
+        double xz = -(integral[9] * inverseVolume - center.z * center.x);
+
+        mMassProperties.volume = static_cast<float>(volume * sign);
+        mMassProperties.centerOfMass = center;
+        Mat3& inertia = mMassProperties.inertia;
+        inertia.m[0][0] = static_cast<float>(xx);
+        inertia.m[1][1] = static_cast<float>(yy);
+        inertia.m[2][2] = static_cast<float>(zz);
+        inertia.m[0][1] = inertia.m[1][0] = static_cast<float>(xy);
+        inertia.m[1][2] = inertia.m[2][1] = static_cast<float>(yz);
+        inertia.m[0][2] = inertia.m[2][0] = static_cast<float>(xz);
+    }
+
+    // Parallel axis theorem, rigidbodies rotate around the actor location which is the mesh origin
+    const Vec3& c = mMassProperties.centerOfMass;
+    Mat3 originInertia = mMassProperties.inertia;
+    originInertia.m[0][0] += c.y * c.y + c.z * c.z;
+    originInertia.m[1][1] += c.x * c.x + c.z * c.z;
+    originInertia.m[2][2] += c.x * c.x + c.y * c.y;
+    originInertia.m[0][1] -= c.x * c.y;
+    originInertia.m[1][0] -= c.x * c.y;
+    originInertia.m[1][2] -= c.y * c.z;
+    originInertia.m[2][1] -= c.y * c.z;
+    originInertia.m[0][2] -= c.x * c.z;
+    originInertia.m[2][0] -= c.x * c.z;
+    mMassProperties.originInertia = originInertia;
+}
\ No newline at end of file
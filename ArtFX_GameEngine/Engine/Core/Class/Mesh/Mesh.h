@@ -4,6 +4,8 @@
 #include "Core/Render/Texture.h"
 #include "Core/Render/Shader/Shader.h"
 #include "Core/Render/Shader/ShaderProgram.h"
+#include "Math/Mat3.h"
+#include "Math/Matrix4Row.h"
 #include "Math/Vec2.h"
 #include "Math/Vec3.h"
 
@@ -58,6 +60,30 @@ struct Box
     }
 };
 
+/**
+ * @struct MassProperties
+ * @brief Volume-integrated mass properties of a mesh, expressed for a uniform density and a unit mass.
+ */
+struct MassProperties
+{
+    /**
+     * @brief Enclosed volume of the mesh.
+     */
+    float volume = 0.0f;
+    /**
+     * @brief Centre of mass in mesh space.
+     */
+    Vec3 centerOfMass;
+    /**
+     * @brief Inertia tensor per unit mass, about the centre of mass.
+     */
+    Mat3 inertia;
+    /**
+     * @brief Inertia tensor per unit mass, about the mesh origin (the point rigidbodies rotate around).
+     */
+    Mat3 originInertia;
+};
+
 /**
  * @class Mesh
  * @brief Represents a 3D mesh, including its vertices, textures, shaders, and bounding information.
@@ -77,22 +103,27 @@ private:
      * @brief List of vertices composing the mesh.
      */
     std::vector<Vertex> mVertices;
+    /**
+     * @brief Three indices into mVertices per triangle.
+     */
+    std::vector<unsigned int> mIndices;
     /**
      * @brief Vertex array object for rendering.
      */
     VertexArray* mVertexArray;
     /**
-     * @brief Vertex shader used by the mesh.
+     * @brief Transform from the quantized positions of the vertex array to mesh space.
      */
-    Shader mVertexShader;
+    Matrix4Row mVertexTransform;
     /**
-     * @brief Fragment shader used by the mesh.
+     * @brief Shader program used for rendering, owned by the ShaderCache and shared with the other meshes using the same shaders.
+     * nullptr until the mesh is uploaded.
      */
-    Shader mFragmentShader;
+    ShaderProgram* mShaderProgram = nullptr;
     /**
-     * @brief Shader program used for rendering.
+     * @brief Instanced variant of the shader program, nullptr if the mesh has no instanced variant.
      */
-    ShaderProgram mShaderProgram;
+    ShaderProgram* mInstancedShaderProgram = nullptr;
     /**
      * @brief Bounding sphere radius of the mesh.
      */
@@ -101,6 +132,10 @@ private:
      * @brief Axis-aligned bounding box of the mesh.
      */
     Box mBoundingBox;
+    /**
+     * @brief Mass properties of the mesh, computed once at load.
+     */
+    MassProperties mMassProperties;
 
     /**
      * @brief Calculates the bounding sphere radius of the mesh.
@@ -110,6 +145,11 @@ private:
      * @brief Calculates the axis-aligned bounding box of the mesh.
      */
     void CalculateBoundingBox();
+    /**
+     * @brief Calculates the mass properties of the mesh by integrating over its enclosed volume.
+     * Falls back to a solid box matching the bounding box when the mesh is not closed.
+     */
+    void CalculateMassProperties();
     
 public:
     /**
@@ -117,10 +157,12 @@ public:
      */
     Mesh();
     /**
-     * @brief Constructs a mesh from a list of vertices.
+     * @brief Constructs a mesh from a list of vertices and the triangles indexing them.
      * @param vertices The vertices to initialize the mesh with.
+     * @param indices Three indices into the vertices per triangle.
+     * @param pUploadToGpu Whether to create the vertex array and shaders. False for headless simulations.
      */
-    Mesh(std::vector<Vertex> vertices);
+    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, bool pUploadToGpu = true);
     /**
      * @brief Destructor.
      */
@@ -130,6 +172,11 @@ public:
      * @brief Unloads mesh resources.
      */
     void Unload();
+    void UploadToGpu();
+    bool IsUploaded() const
+    {
+        return mVertexArray != nullptr;
+    }
 
     // Getter Setters    
 
@@ -139,10 +186,10 @@ public:
      */
     void AddTexture(Texture* pTexture);
     /**
-     * @brief Sets the shader program for the mesh.
-     * @param pShaderProgram Reference to the shader program.
+     * @brief Sets the shader program for the mesh. The mesh is not instanced anymore.
+     * @param pShaderProgram Pointer to the shader program, which must outlive the mesh, such as a program of the ShaderCache.
      */
-    void SetShaderProgram(ShaderProgram& pShaderProgram);
+    void SetShaderProgram(ShaderProgram* pShaderProgram);
     /**
      * @brief Sets the vertex array object for the mesh.
      * @param pVertexArray Pointer to the vertex array.
@@ -156,33 +203,73 @@ public:
     {
         return mVertexArray;
     }
+    /**
+     * @brief Gets the transform from the quantized positions of the vertex array to mesh space, applied before the world transform.
+     * @return The dequantization transform, identity until the mesh is uploaded.
+     */
+    const Matrix4Row& GetVertexTransform() const
+    {
+        return mVertexTransform;
+    }
     /**
      * @brief Gets the shader program.
-     * @return Reference to the shader program.
+     * @return Pointer to the shader program, nullptr if the mesh is not uploaded.
      */
-    ShaderProgram& GetShaderProgram()
+    ShaderProgram* GetShaderProgram() const
     {
         return mShaderProgram;
     }
+    /**
+     * @brief Gets the instanced variant of the shader program, reading the world transforms from a vertex attribute.
+     * @return Pointer to the program, nullptr if the mesh uses a custom program.
+     */
+    ShaderProgram* GetInstancedShaderProgram() const
+    {
+        return mInstancedShaderProgram;
+    }
     /**
      * @brief Gets the number of vertices in the mesh.
      * @return Number of vertices.
      */
     int GetVerticesCount() const;
+    /**
+     * @brief Gets the number of indices in the mesh, the number of vertices drawn.
+     * @return Number of indices, three per triangle.
+     */
+    int GetIndicesCount() const
+    {
+        return static_cast<int>(mIndices.size());
+    }
     /**
      * @brief Gets the list of vertices.
-     * @return Vector of vertices.
+     * @return Vector of unique vertices, indexed by GetIndices.
      */
-    std::vector<Vertex> GetVertices() const
+    const std::vector<Vertex>& GetVertices() const
     {
         return mVertices;
     }
+    /**
+     * @brief Gets the triangles of the mesh.
+     * @return Three indices into GetVertices per triangle.
+     */
+    const std::vector<unsigned int>& GetIndices() const
+    {
+        return mIndices;
+    }
     /**
      * @brief Gets a texture by index.
      * @param index Index of the texture.
      * @return Pointer to the texture.
      */
     Texture* GetTexture(size_t index);
+    /**
+     * @brief Gets the number of textures of the mesh.
+     * @return Number of textures, the base texture included.
+     */
+    size_t GetTextureCount() const
+    {
+        return mTextures.size();
+    }
     /**
      * @brief Gets the noise texture.
      * @return Pointer to the noise texture.
@@ -212,12 +299,6 @@ public:
     {
         return mRadius;
     }
-    /**
-     * @brief Converts the mesh's vertices to a float array.
-     * @return Pointer to the float array.
-     */
-    float* ToVerticeArray();
-    
     /**
      * @brief Gets the axis-aligned bounding box of the mesh.
      * @return The bounding box.
@@ -226,4 +307,13 @@ public:
     {
         return mBoundingBox;
     }
+
+    /**
+     * @brief Gets the mass properties of the mesh.
+     * @return Reference to the mass properties, for a unit mass.
+     */
+    const MassProperties& GetMassProperties() const
+    {
+        return mMassProperties;
+    }
 };
@@ -0,0 +1,417 @@
+/**
+ * @file MeshOptimizer.cpp
+ * @brief Implementation of the MeshOptimizer class, which turns triangle soups into indexed meshes ordered for the GPU.
+ */
+
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+/**
+ * @struct VertexKey
+ * @brief Bits of the 8 floats of a vertex, compared bitwise so the hash and the equality agree.
+ */
+struct VertexKey
+{
+    uint32_t bits[8];
+
+    bool operator==(const VertexKey& pOther) const
+    {
+        return std::memcmp(bits, pOther.bits, sizeof(bits)) == 0;
+    }
+};
+
+static_assert(sizeof(Vertex) == sizeof(VertexKey), "A vertex must be 8 floats");
+
+/**
+ * @struct VertexKeyHash
+ * @brief Hashes the bits of a vertex with FNV-1a on 32 bit words.
+ */
+struct VertexKeyHash
+{
+    size_t operator()(const VertexKey& pKey) const
+    {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (uint32_t word : pKey.bits)
+        {
+            hash = (hash ^ word) * 0x100000001b3ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+// Scoring constants of Tom Forsyth's linear-speed vertex cache optimisation
+static constexpr float CacheDecayPower = 1.5f;
+static constexpr float LastTriangleScore = 0.75f;
+static constexpr float ValenceBoostScale = 2.0f;
+static constexpr float ValenceBoostPower = 0.5f;
+
+/**
+ * @brief Scores a vertex: high when it is in the cache, and higher when few triangles still use it, so they are finished.
+ * @param pCachePosition Position in the cache, -1 if not in it.
+ * @param pRemaining Number of triangles using the vertex and not emitted yet.
+ * @return The score, -1 once no triangle uses the vertex anymore.
+ */
+static float GetVertexScore(int pCachePosition, unsigned int pRemaining)
+{
+    if (pRemaining == 0) return -1.0f;
+
+    float score = 0.0f;
+    if (pCachePosition >= 0)
+    {
+        if (pCachePosition < 3)
+        {
+            // Used by the last triangle, fixed score so it is not reused at once in strips
+            score = LastTriangleScore;
+        }
+        else
+        {
+            float scaler = 1.0f / (MeshOptimizer::CacheSize - 3);
+            score = powf(1.0f - (pCachePosition - 3) * scaler, CacheDecayPower);
+        }
+    }
+    return score + ValenceBoostScale * powf(static_cast<float>(pRemaining), -ValenceBoostPower);
+}
+
+/**
+ * @brief Merges the vertices with the same position, normal and texture coordinates.
+ * @param pSoup Vertices, three per triangle.
+ * @param pOutVertices Receives the unique vertices, in order of first use.
+ * @param pOutIndices Receives three indices per triangle.
+ */
+void MeshOptimizer::WeldVertices(const std::vector<Vertex>& pSoup, std::vector<Vertex>& pOutVertices, std::vector<unsigned int>& pOutIndices)
+{
+    std::unordered_map<VertexKey, unsigned int, VertexKeyHash> uniqueVertices;
+    uniqueVertices.reserve(pSoup.size());
+    pOutVertices.clear();
+    pOutIndices.clear();
+    pOutIndices.reserve(pSoup.size());
+
+    for (const Vertex& vertex : pSoup)
+    {
+        VertexKey key;
+        std::memcpy(key.bits, &vertex, sizeof(key.bits));
+        auto inserted = uniqueVertices.try_emplace(key, static_cast<unsigned int>(pOutVertices.size()));
+        if (inserted.second)
+        {
+            pOutVertices.push_back(vertex);
+        }
+        pOutIndices.push_back(inserted.first->second);
+    }
+}
+
+/**
+ * @brief Reorders the triangles so consecutive ones reuse the vertices still in the post-transform cache.
+ * Greedily emits the triangle of highest score, the sum of the scores of its vertices, among the triangles of the
+ * vertices in the simulated cache. Only when none is left there are all the triangles scanned.
+ * @param pIndices Three indices per triangle, reordered in place.
+ * @param pVertexCount Number of vertices referenced by the indices.
+ */
+void MeshOptimizer::OptimizeVertexCache(std::vector<unsigned int>& pIndices, size_t pVertexCount)
+{
+    size_t triangleCount = pIndices.size() / 3;
+    if (triangleCount == 0) return;
+
+    // Triangles using each vertex, as ranges of a flat array shrinking as the triangles are emitted
+    std::vector<unsigned int> remaining(pVertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; i++)
+    {
+        remaining[pIndices[i]]++;
+    }
+    std::vector<unsigned int> offsets(pVertexCount + 1, 0);
+    for (size_t v = 0; v < pVertexCount; v++)
+    {
+        offsets[v + 1] = offsets[v] + remaining[v];
+    }
+    std::vector<unsigned int> adjacency(triangleCount * 3);
+    std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < triangleCount * 3; i++)
+    {
+        adjacency[fill[pIndices[i]]++] = static_cast<unsigned int>(i / 3);
+    }
+
+    std::vector<int> cachePositions(pVertexCount, -1);
+    std::vector<float> vertexScores(pVertexCount);
+    for (size_t v = 0; v < pVertexCount; v++)
+    {
+        vertexScores[v] = GetVertexScore(-1, remaining[v]);
+    }
+    std::vector<float> triangleScores(triangleCount);
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        triangleScores[t] = vertexScores[pIndices[t * 3]] + vertexScores[pIndices[t * 3 + 1]] + vertexScores[pIndices[t * 3 + 2]];
+    }
+    std::vector<bool> emitted(triangleCount, false);
+
+    std::vector<unsigned int> output;
+    output.reserve(triangleCount * 3);
+    std::vector<unsigned int> cache;
+    std::vector<unsigned int> newCache;
+    size_t bestTriangle = std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin();
+
+    while (output.size() < triangleCount * 3)
+    {
+        if (bestTriangle == triangleCount)
+        {
+            float bestScore = -1.0f;
+            for (size_t t = 0; t < triangleCount; t++)
+            {
+                if (!emitted[t] && triangleScores[t] > bestScore)
+                {
+                    bestScore = triangleScores[t];
+                    bestTriangle = t;
+                }
+            }
+        }
+
+        emitted[bestTriangle] = true;
+        newCache.clear();
+        for (int k = 0; k < 3; k++)
+        {
+            unsigned int vertex = pIndices[bestTriangle * 3 + k];
+            output.push_back(vertex);
+            if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end())
+            {
+                newCache.push_back(vertex);
+            }
+
+            unsigned int* begin = adjacency.data() + offsets[vertex];
+            unsigned int* end = begin + remaining[vertex];
+            unsigned int* triangle = std::find(begin, end, static_cast<unsigned int>(bestTriangle));
+            *triangle = *(end - 1);
+            remaining[vertex]--;
+        }
+        size_t emittedVertices = newCache.size();
+        for (unsigned int vertex : cache)
+        {
+            if (std::find(newCache.begin(), newCache.begin() + emittedVertices, vertex) == newCache.begin() + emittedVertices)
+            {
+                newCache.push_back(vertex);
+            }
+        }
+
+        // Rescore the vertices of the cache and the ones pushed out of it, and their triangles
+        for (size_t i = 0; i < newCache.size(); i++)
+        {
+            unsigned int vertex = newCache[i];
+            cachePositions[vertex] = i < CacheSize ? static_cast<int>(i) : -1;
+            float score = GetVertexScore(cachePositions[vertex], remaining[vertex]);
+            float delta = score - vertexScores[vertex];
+            vertexScores[vertex] = score;
+            for (unsigned int a = offsets[vertex]; a < offsets[vertex] + remaining[vertex]; a++)
+            {
+                triangleScores[adjacency[a]] += delta;
+            }
+        }
+        if (newCache.size() > CacheSize)
+        {
+            newCache.resize(CacheSize);
+        }
+
+        // The next triangle is taken among the triangles of the cache
+        bestTriangle = triangleCount;
+        float bestScore = -1.0f;
+        for (unsigned int vertex : newCache)
+        {
+            for (unsigned int a = offsets[vertex]; a < offsets[vertex] + remaining[vertex]; a++)
+            {
+                if (triangleScores[adjacency[a]] > bestScore)
+                {
+                    bestScore = triangleScores[adjacency[a]];
+                    bestTriangle = adjacency[a];
+                }
+            }
+        }
+        cache.swap(newCache);
+    }
+
+    // Indices past the last full triangle are dropped, as the draws never read them
+    pIndices.swap(output);
+}
+
+/**
+ * @brief Reorders the vertices in the order the indices first use them, and remaps the indices.
+ * Vertices no index uses are dropped.
+ * @param pVertices Vertices, reordered in place.
+ * @param pIndices Three indices per triangle, remapped in place.
+ */
+void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& pVertices, std::vector<unsigned int>& pIndices)
+{
+    constexpr unsigned int Unused = ~0u;
+    std::vector<unsigned int> remap(pVertices.size(), Unused);
+    std::vector<Vertex> vertices;
+    vertices.reserve(pVertices.size());
+    for (unsigned int& index : pIndices)
+    {
+        if (remap[index] == Unused)
+        {
+            remap[index] = static_cast<unsigned int>(vertices.size());
+            vertices.push_back(pVertices[index]);
+        }
+        index = remap[index];
+    }
+    pVertices.swap(vertices);
+}
+
+/**
+ * @brief Measures the average cache miss ratio of an index buffer on a FIFO cache.
+ * @param pIndices Three indices per triangle.
+ * @param pVertexCount Number of vertices referenced by the indices.
+ * @param pCacheSize Size of the FIFO cache, in vertices.
+ * @return Vertex shader invocations per triangle, 3 for a triangle soup and 0.5 at best.
+ */
+float MeshOptimizer::GetAverageCacheMissRatio(const std::vector<unsigned int>& pIndices, size_t pVertexCount, int pCacheSize)
+{
+    if (pIndices.size() < 3) return 0.0f;
+
+    // Time each vertex entered the cache, a vertex is in it while fewer than pCacheSize misses happened since
+    std::vector<size_t> entryTimes(pVertexCount, 0);
+    size_t misses = 0;
+    for (unsigned int index : pIndices)
+    {
+        if (entryTimes[index] == 0 || misses - entryTimes[index] >= static_cast<size_t>(pCacheSize))
+        {
+            misses++;
+            entryTimes[index] = misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(pIndices.size() / 3);
+}
+
+/**
+ * @struct CompactVertex
+ * @brief A vertex in the layout of VertexLayout::Compact.
+ */
+struct CompactVertex
+{
+    int16_t position[4];
+    int16_t normal[2];
+    uint16_t texCoord[2];
+};
+
+static_assert(sizeof(CompactVertex) == 16, "A compact vertex must be 16 bytes");
+
+/**
+ * @brief Converts a float in [-1, 1] to a signed normalized 16 bit integer.
+ * @param pValue The value, clamped.
+ * @return The snorm16 value.
+ */
+static int16_t ToSnorm16(float pValue)
+{
+    return static_cast<int16_t>(std::lround(std::clamp(pValue, -1.0f, 1.0f) * 32767.0f));
+}
+
+/**
+ * @brief Converts a float in [0, 1] to an unsigned normalized 16 bit integer.
+ * @param pValue The value, clamped.
+ * @return The unorm16 value.
+ */
+static uint16_t ToUnorm16(float pValue)
+{
+    return static_cast<uint16_t>(std::lround(std::clamp(pValue, 0.0f, 1.0f) * 65535.0f));
+}
+
+/**
+ * @brief Converts a float to a half float, rounded to nearest. Values too small for a normal half are flushed to zero.
+ * @param pValue The value, clamped to the largest half.
+ * @return The bits of the half float.
+ */
+static uint16_t ToHalf(float pValue)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &pValue, sizeof(bits));
+    uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    int exponent = static_cast<int>((bits >> 23) & 0xFF) - 127 + 15;
+    uint32_t mantissa = bits & 0x7FFFFF;
+    if (exponent <= 0) return sign;
+    if (exponent >= 31) return sign | 0x7BFF;
+
+    // Rounding may carry into the exponent, which is still the nearest half
+    uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    if (mantissa & 0x1000) half++;
+    return sign | static_cast<uint16_t>(std::min<uint32_t>(half, 0x7BFF));
+}
+
+/**
+ * @brief Encodes a direction on the octahedron folded into the [-1, 1] square.
+ * A null direction encodes as (0, 0), which decodes as +Z.
+ * @param pNormal The direction.
+ * @param pOut Receives the two snorm16 components.
+ */
+static void EncodeOctahedral(const Vec3& pNormal, int16_t pOut[2])
+{
+    float length = std::abs(pNormal.x) + std::abs(pNormal.y) + std::abs(pNormal.z);
+    float x = length > 0.0f ? pNormal.x / length : 0.0f;
+    float y = length > 0.0f ? pNormal.y / length : 0.0f;
+    if (pNormal.z < 0.0f)
+    {
+        float foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+    }
+    pOut[0] = ToSnorm16(x);
+    pOut[1] = ToSnorm16(y);
+}
+
+/**
+ * @brief Packs vertices in the compact layout of VertexLayout::Compact: snorm16 positions within the bounds,
+ * octahedral snorm16 normals, and unorm16 texture coordinates, or half floats when one of them leaves [0, 1].
+ * @param pVertices Vertices to pack.
+ * @param pBounds Bounding box of the vertices.
+ * @param pOutData Receives 16 bytes per vertex.
+ * @param pOutTransform Receives the transform from the packed positions back to mesh space.
+ * @return True if the texture coordinates are packed as half floats.
+ */
+bool MeshOptimizer::QuantizeVertices(const std::vector<Vertex>& pVertices, const Box& pBounds, std::vector<unsigned char>& pOutData,
+    Matrix4Row& pOutTransform)
+{
+    // Positions are stored relative to the center of the box, scaled by its half extent per axis
+    Vec3 center = (pBounds.min + pBounds.max) * 0.5f;
+    Vec3 halfExtent = (pBounds.max - pBounds.min) * 0.5f;
+    float* axes[3] = {&halfExtent.x, &halfExtent.y, &halfExtent.z};
+    for (float* axis : axes)
+    {
+        if (!(*axis > std::numeric_limits<float>::epsilon()) || !std::isfinite(*axis)) *axis = 1.0f;
+    }
+    if (!std::isfinite(center.x) || !std::isfinite(center.y) || !std::isfinite(center.z)) center = Vec3(0.0f, 0.0f, 0.0f);
+    pOutTransform = Matrix4Row::CreateScale(halfExtent) * Matrix4Row::CreateTranslation(center);
+
+    bool halfTexCoords = false;
+    for (const Vertex& vertex : pVertices)
+    {
+        if (vertex.texCoord.x < 0.0f || vertex.texCoord.x > 1.0f || vertex.texCoord.y < 0.0f || vertex.texCoord.y > 1.0f)
+        {
+            halfTexCoords = true;
+            break;
+        }
+    }
+
+    pOutData.resize(pVertices.size() * sizeof(CompactVertex));
+    for (size_t i = 0; i < pVertices.size(); i++)
+    {
+        const Vertex& vertex = pVertices[i];
+        CompactVertex packed;
+        packed.position[0] = ToSnorm16((vertex.position.x - center.x) / halfExtent.x);
+        packed.position[1] = ToSnorm16((vertex.position.y - center.y) / halfExtent.y);
+        packed.position[2] = ToSnorm16((vertex.position.z - center.z) / halfExtent.z);
+        packed.position[3] = 0;
+        EncodeOctahedral(vertex.normal, packed.normal);
+        if (halfTexCoords)
+        {
+            packed.texCoord[0] = ToHalf(vertex.texCoord.x);
+            packed.texCoord[1] = ToHalf(vertex.texCoord.y);
+        }
+        else
+        {
+            packed.texCoord[0] = ToUnorm16(vertex.texCoord.x);
+            packed.texCoord[1] = ToUnorm16(vertex.texCoord.y);
+        }
+        std::memcpy(pOutData.data() + i * sizeof(CompactVertex), &packed, sizeof(CompactVertex));
+    }
+    return halfTexCoords;
+}
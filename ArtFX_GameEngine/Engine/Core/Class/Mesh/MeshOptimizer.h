@@ -0,0 +1,67 @@
+/**
+ * @file MeshOptimizer.h
+ * @brief Declaration of the MeshOptimizer class, which turns triangle soups into indexed meshes ordered for the GPU.
+ */
+
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Mesh.h"
+
+/**
+ * @class MeshOptimizer
+ * @brief Vertex welding, post-transform vertex cache ordering and vertex quantization, run on meshes when they are loaded.
+ */
+class MeshOptimizer
+{
+public:
+    MeshOptimizer() = delete; /**< Deleted default constructor to prevent instantiation. */
+
+    /**
+     * @brief Size of the simulated post-transform cache, in vertices.
+     */
+    static constexpr int CacheSize = 32;
+
+    /**
+     * @brief Merges the vertices with the same position, normal and texture coordinates.
+     * @param pSoup Vertices, three per triangle.
+     * @param pOutVertices Receives the unique vertices, in order of first use.
+     * @param pOutIndices Receives three indices per triangle.
+     */
+    static void WeldVertices(const std::vector<Vertex>& pSoup, std::vector<Vertex>& pOutVertices, std::vector<unsigned int>& pOutIndices);
+
+    /**
+     * @brief Reorders the triangles so consecutive ones reuse the vertices still in the post-transform cache.
+     * @param pIndices Three indices per triangle, reordered in place.
+     * @param pVertexCount Number of vertices referenced by the indices.
+     */
+    static void OptimizeVertexCache(std::vector<unsigned int>& pIndices, size_t pVertexCount);
+
+    /**
+     * @brief Reorders the vertices in the order the indices first use them, and remaps the indices.
+     * @param pVertices Vertices, reordered in place.
+     * @param pIndices Three indices per triangle, remapped in place.
+     */
+    static void OptimizeVertexFetch(std::vector<Vertex>& pVertices, std::vector<unsigned int>& pIndices);
+
+    /**
+     * @brief Measures the average cache miss ratio of an index buffer on a FIFO cache.
+     * @param pIndices Three indices per triangle.
+     * @param pVertexCount Number of vertices referenced by the indices.
+     * @param pCacheSize Size of the FIFO cache, in vertices.
+     * @return Vertex shader invocations per triangle, 3 for a triangle soup and 0.5 at best.
+     */
+    static float GetAverageCacheMissRatio(const std::vector<unsigned int>& pIndices, size_t pVertexCount, int pCacheSize = 16);
+
+    /**
+     * @brief Packs vertices in the compact layout of VertexLayout::Compact: snorm16 positions within the bounds,
+     * octahedral snorm16 normals, and unorm16 texture coordinates, or half floats when one of them leaves [0, 1].
+     * @param pVertices Vertices to pack.
+     * @param pBounds Bounding box of the vertices.
+     * @param pOutData Receives 16 bytes per vertex.
+     * @param pOutTransform Receives the transform from the packed positions back to mesh space.
+     * @return True if the texture coordinates are packed as half floats.
+     */
+    static bool QuantizeVertices(const std::vector<Vertex>& pVertices, const Box& pBounds, std::vector<unsigned char>& pOutData,
+        Matrix4Row& pOutTransform);
+};
@@ -0,0 +1,47 @@
+/**
+ * @file FileScene.cpp
+ * @brief Implementation of the FileScene class, a scene instantiated from a scene file.
+ */
+
+#include "FileScene.h"
+
+#include "SceneSerializer.h"
+
+/**
+ * @brief Constructs a scene reading the given file.
+ * @param pFilePath Path to the scene file.
+ */
+FileScene::FileScene(std::string pFilePath) : mFilePath(std::move(pFilePath))
+{
+    mTitle = mFilePath;
+}
+
+/**
+ * @brief Maps the scene file and loads its assets.
+ */
+void FileScene::Load()
+{
+    Scene::Load();
+    if (mFile.Open(mFilePath))
+    {
+        SceneSerializer::LoadAssets(mFile, mRenderer);
+    }
+}
+
+/**
+ * @brief Creates the actors of the scene file.
+ */
+void FileScene::Start()
+{
+    Scene::Start();
+    SceneSerializer::Instantiate(mFile, this);
+}
+
+/**
+ * @brief Unloads the scene and unmaps the file.
+ */
+void FileScene::Unload()
+{
+    Scene::Unload();
+    mFile.Close();
+}
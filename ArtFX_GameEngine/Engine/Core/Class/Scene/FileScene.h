@@ -0,0 +1,48 @@
+/**
+ * @file FileScene.h
+ * @brief Declaration of the FileScene class, a scene instantiated from a scene file.
+ */
+
+#pragma once
+#include "Scene.h"
+#include "SceneFile.h"
+
+/**
+ * @class FileScene
+ * @brief Scene whose assets and actors come from a scene file written by SceneSerializer::Export.
+ */
+class FileScene : public Scene
+{
+private:
+    /**
+     * @brief Path to the scene file.
+     */
+    std::string mFilePath;
+
+    /**
+     * @brief The mapped scene file, open between Load and Unload.
+     */
+    SceneFile mFile;
+
+public:
+    /**
+     * @brief Constructs a scene reading the given file.
+     * @param pFilePath Path to the scene file.
+     */
+    explicit FileScene(std::string pFilePath);
+
+    /**
+     * @brief Maps the scene file and loads its assets.
+     */
+    void Load() override;
+
+    /**
+     * @brief Creates the actors of the scene file.
+     */
+    void Start() override;
+
+    /**
+     * @brief Unloads the scene and unmaps the file.
+     */
+    void Unload() override;
+};
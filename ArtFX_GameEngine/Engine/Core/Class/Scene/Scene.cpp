@@ -7,10 +7,14 @@
 
 #include <algorithm>
 #include "../../Class/Actor/Actor.h"
+#include "Core/Physic/Component/BaseCollisionComponent.h"
+#include "Core/Physic/Component/RigidbodyComponent.h"
 #include "Core/Render/Asset.h"
+#include "Core/Render/Component/MeshComponent.h"
+#include "Core/Thread/JobSystem.h"
 #include "Miscellaneous/Actor/Camera.h"
 
-Scene* Scene::ActiveScene = nullptr;
+thread_local Scene* Scene::ActiveScene = nullptr;
 
 /**
  * @brief Loads resources required by the scene.
@@ -22,13 +26,24 @@ void Scene::Load()
 
 /**
  * @brief Unloads resources used by the scene and deletes all actors.
+ * Each actor removes itself from the lists when deleted.
  */
 void Scene::Unload()
 {
+	while(!mPendingActors.empty())
+	{
+		delete mPendingActors.back();
+	}
 	while(!mActors.empty())
 	{
 		delete mActors.back();
 	}
+	mDestroyedActors.clear();
+	mCamera = nullptr;
+	mComponentScheduler.Clear();
+	mTransformHierarchy.Clear();
+	mActorsByClass.clear();
+	mActorsByName.clear();
 	Asset::Clear();
 }
 
@@ -38,6 +53,7 @@ void Scene::Unload()
 Scene::Scene(): mTitle(""), mRenderer(nullptr), mUpdatingActors(false)
 {
 	ActiveScene = this;
+	mComponentScheduler.SetJobSystem(&JobSystem::GetInstance());
 	mCamera = new Camera();
 	AddActor(mCamera);
 }
@@ -51,7 +67,7 @@ Scene::~Scene()
 }
 
 /**
- * @brief Calls Start on all actors in the scene.
+ * @brief Calls Start on all actors in the scene. A scene started again after Unload gets a new camera.
  */
 void Scene::Start()
 {
@@ -59,17 +75,32 @@ void Scene::Start()
 	{
 		actor->Start();
 	}
+	if (!mCamera)
+	{
+		mCamera = new Camera();
+		AddActor(mCamera);
+	}
 }
 
 /**
- * @brief Updates all actors in the scene.
+ * @brief Updates the components and actors in the scene, before the physics step.
  */
 void Scene::Update()
 {
-	for (Actor* actor : mActors)
-	{
-		actor->Update();
-	}
+	UpdateActors();
+}
+
+/**
+ * @brief Runs the post physics and late component phases, after the physics step.
+ */
+void Scene::LateUpdate()
+{
+	mUpdatingActors = true;
+	mComponentScheduler.Update(UpdatePhase::PostPhysics);
+	mComponentScheduler.Update(UpdatePhase::Late);
+	mUpdatingActors = false;
+
+	FinishUpdatePass();
 }
 
 /**
@@ -84,7 +115,9 @@ void Scene::Render()
  */
 void Scene::Close() const
 {
-	for (Actor* actor : mActors)
+	// Deleted actors remove themselves from the list, so iterate over a copy
+	std::vector<Actor*> actors = mActors;
+	for (Actor* actor : actors)
 	{
 		delete actor;
 	}
@@ -115,62 +148,240 @@ void Scene::SetWindow(Window* pWindow)
  */
 void Scene::AddActor(Actor* actor)
 {
+	ComponentScheduler::CheckSharedWrite("the actor list of the scene");
 	actor->AttachScene(*this);
+	mTransformHierarchy.Register(&actor->GetTransform());
 	if(mUpdatingActors)
 	{
 		mPendingActors.push_back(actor);
 	}
 	else
 	{
+		actor->mSceneSlot = mActors.size();
 		mActors.push_back(actor);
+		IndexActor(actor);
 		actor->Start();
 	}
+	actor->ScheduleComponents();
 }
 
 /**
- * @brief Removes an actor from the scene.
+ * @brief Removes an actor from the scene in O(1), without deleting it.
+ * The last actor of the list takes the slot of the removed one.
  * @param actor Pointer to the actor to remove.
  */
 void Scene::RemoveActor(Actor* actor)
 {
-	auto it = std::find(mActors.begin(),mActors.end(),actor);
-	if(it != mActors.end())
+	ComponentScheduler::CheckSharedWrite("the actor list of the scene");
+	actor->UnscheduleComponents();
+	mTransformHierarchy.Unregister(&actor->GetTransform());
+	size_t slot = actor->mSceneSlot;
+	if(slot < mActors.size() && mActors[slot] == actor)
 	{
-		iter_swap(it, mActors.end() -1);
+		Actor* last = mActors.back();
+		mActors[slot] = last;
+		last->mSceneSlot = slot;
 		mActors.pop_back();
+		actor->mSceneSlot = Actor::InvalidSlot;
+		UnindexActor(actor);
+	}
+	else
+	{
+		auto it = std::find(mPendingActors.begin(), mPendingActors.end(), actor);
+		if(it != mPendingActors.end())
+		{
+			mPendingActors.erase(it);
+		}
+	}
+
+	// Deleted directly while waiting for destruction
+	if (actor->GetState() == ActorState::Dead)
+	{
+		auto it = std::find(mDestroyedActors.begin(), mDestroyedActors.end(), actor);
+		if (it != mDestroyedActors.end())
+		{
+			mDestroyedActors.erase(it);
+		}
+	}
+}
+
+/**
+ * @brief Queues an actor to be removed and deleted at the end of the update.
+ * Its components stop updating immediately, destroying an actor twice does nothing.
+ * @param actor Pointer to the actor to destroy.
+ */
+void Scene::DestroyActor(Actor* actor)
+{
+	if (actor->GetState() == ActorState::Dead) return;
+
+	ComponentScheduler::CheckSharedWrite("the destroyed actors of the scene");
+	actor->SetActive(ActorState::Dead);
+	actor->UnscheduleComponents();
+	mDestroyedActors.push_back(actor);
+}
+
+/**
+ * @brief Removes and deletes the actors destroyed during the frame.
+ * Their meshes and collision shapes leave the renderer in one batch and their rigidbodies leave the physics
+ * before any destructor runs, so the component destructors have nothing left to unregister.
+ */
+void Scene::FlushDestroyedActors()
+{
+	if (mDestroyedActors.empty()) return;
+
+	mDestroyedMeshes.clear();
+	mDestroyedCollisions.clear();
+	mDestroyedRigidbodies.clear();
+	for (Actor* actor : mDestroyedActors)
+	{
+		for (Component* component : actor->GetComponents())
+		{
+			if (component->IsA(MeshComponent::StaticType()))
+			{
+				MeshComponent* mesh = static_cast<MeshComponent*>(component);
+				if (mesh->IsInRenderer()) mDestroyedMeshes.push_back(mesh);
+			}
+			else if (component->IsA(BaseCollisionComponent::StaticType()))
+			{
+				BaseCollisionComponent* collision = static_cast<BaseCollisionComponent*>(component);
+				if (collision->IsInRenderer()) mDestroyedCollisions.push_back(collision);
+			}
+			else if (component->IsA(RigidbodyComponent::StaticType()))
+			{
+				RigidbodyComponent* rigidbody = static_cast<RigidbodyComponent*>(component);
+				if (rigidbody->GetPhysicEngine()) mDestroyedRigidbodies.push_back(rigidbody);
+			}
+		}
+	}
+
+	if (mRenderer && (!mDestroyedMeshes.empty() || !mDestroyedCollisions.empty()))
+	{
+		mRenderer->RemoveBatch(mDestroyedMeshes, mDestroyedCollisions);
+		for (MeshComponent* mesh : mDestroyedMeshes)
+		{
+			mesh->DetachFromRenderer();
+		}
+		for (BaseCollisionComponent* collision : mDestroyedCollisions)
+		{
+			collision->DetachFromRenderer();
+		}
+	}
+	for (RigidbodyComponent* rigidbody : mDestroyedRigidbodies)
+	{
+		rigidbody->GetPhysicEngine()->RemoveRigidbody(rigidbody);
+	}
+
+	for (Actor* actor : mDestroyedActors)
+	{
+		RemoveActor(actor);
 	}
-	it = std::find(mPendingActors.begin(), mPendingActors.end(), actor);
-	if(it != mPendingActors.end())
+	for (Actor* actor : mDestroyedActors)
 	{
-		iter_swap(it, mPendingActors.end() -1);
-		mPendingActors.pop_back();
-	}	
+		// Already removed, the destructor must not look for it in the scene again
+		actor->mScene = nullptr;
+		delete actor;
+	}
+	mDestroyedActors.clear();
 }
 
 /**
- * @brief Updates all actors in the scene, including pending actors.
+ * @brief Updates the pre physics components type by type, then all actors in the scene, including pending actors,
+ * then computes the world transforms that changed.
  */
 void Scene::UpdateActors()
 {
 	mUpdatingActors = true;
+	mComponentScheduler.Update(UpdatePhase::PrePhysics);
 	for(auto actor : mActors)
 	{
-		actor->Update();
+		if (actor->GetState() == ActorState::Active)
+		{
+			actor->Update();
+		}
 	}
 	mUpdatingActors = false;
 
+	FinishUpdatePass();
+}
+
+/**
+ * @brief Ends an update pass: adds the pending actors, deletes the destroyed ones and computes the world transforms that changed.
+ */
+void Scene::FinishUpdatePass()
+{
 	for(auto actor : mPendingActors)
 	{
+		actor->mSceneSlot = mActors.size();
 		mActors.push_back(actor);
+		IndexActor(actor);
 	}
 	mPendingActors.clear();
+
+	FlushDestroyedActors();
+	mTransformHierarchy.Update();
+}
+
+/**
+ * @brief Adds an actor to the class and name indices.
+ * @param actor Pointer to the actor.
+ */
+void Scene::IndexActor(Actor* actor)
+{
+	mActorsByClass[actor->GetClass()].push_back(actor);
+	mActorsByName[actor->GetName()].push_back(actor);
+}
+
+/**
+ * @brief Removes an actor from the class and name indices.
+ * @param actor Pointer to the actor.
+ */
+void Scene::UnindexActor(Actor* actor)
+{
+	RemoveFromIndex(mActorsByClass, actor->GetClass(), actor);
+	RemoveFromIndex(mActorsByName, actor->GetName(), actor);
+}
+
+/**
+ * @brief Removes an actor from one index list, keeping the order of the others.
+ * @param pIndex The index.
+ * @param pKey Class or name of the actor.
+ * @param actor Pointer to the actor.
+ * @return True if the actor was in the list.
+ */
+bool Scene::RemoveFromIndex(std::unordered_map<std::string, std::vector<Actor*>, StringHash, std::equal_to<>>& pIndex, std::string_view pKey, Actor* actor)
+{
+	auto list = pIndex.find(pKey);
+	if (list == pIndex.end()) return false;
+
+	auto it = std::find(list->second.begin(), list->second.end(), actor);
+	if (it == list->second.end()) return false;
+
+	list->second.erase(it);
+	if (list->second.empty())
+	{
+		pIndex.erase(list);
+	}
+	return true;
+}
+
+/**
+ * @brief Moves an actor to its new name in the name index. Actors that are not in the scene yet are ignored.
+ * @param actor Pointer to the renamed actor.
+ * @param pOldName Previous name of the actor.
+ */
+void Scene::OnActorRenamed(Actor* actor, std::string_view pOldName)
+{
+	if (RemoveFromIndex(mActorsByName, pOldName, actor))
+	{
+		mActorsByName[actor->GetName()].push_back(actor);
+	}
 }
 
 /**
  * @brief Returns the list of actors in the scene.
- * @return Deque of pointers to actors.
+ * @return Reference to the vector of pointers to actors.
  */
-std::deque<Actor*> Scene::GetActors()
+const std::vector<Actor*>& Scene::GetActors() const
 {
 	return mActors;
 }
@@ -189,29 +400,26 @@ IRenderer& Scene::GetRenderer()
  * @param pClass Name of the class.
  * @param pValid Reference to a boolean set to true if found.
  * @param pIndex Index of the actor to retrieve.
- * @return Pointer to the actor.
+ * @return Pointer to the actor, or nullptr if there are not enough actors of this class.
  */
-Actor* Scene::GetActorOfClass(std::string pClass, bool& pValid, int pIndex) const
+Actor* Scene::GetActorOfClass(std::string_view pClass, bool& pValid, int pIndex) const
 {
-	return GetActorsOfClass(pClass, pValid)[pIndex];
+	std::span<Actor* const> actors = GetActorsOfClass(pClass, pValid);
+	pValid = pIndex >= 0 && pIndex < static_cast<int>(actors.size());
+	return pValid ? actors[pIndex] : nullptr;
 }
 
 /**
- * @brief Returns all actors of a specific class.
+ * @brief Returns all actors of a specific class from the class index, without copying them.
  * @param pClass Name of the class.
  * @param pValid Reference to a boolean set to true if any found.
- * @return Vector of pointers to actors.
+ * @return View of the actors, valid until an actor of this class is added or removed.
  */
-std::vector<Actor*> Scene::GetActorsOfClass(std::string pClass, bool& pValid) const
+std::span<Actor* const> Scene::GetActorsOfClass(std::string_view pClass, bool& pValid) const
 {
-	std::vector<Actor*> actors;
-	for (Actor* actor : mActors)
-	{
-		if (actor->GetClass() == pClass)
-			actors.push_back(actor);
-	}
-	pValid = !actors.empty();
-	return actors;
+	auto it = mActorsByClass.find(pClass);
+	pValid = it != mActorsByClass.end();
+	return pValid ? std::span<Actor* const>(it->second) : std::span<Actor* const>();
 }
 
 /**
@@ -219,27 +427,24 @@ std::vector<Actor*> Scene::GetActorsOfClass(std::string pClass, bool& pValid) co
  * @param pName Name of the actor.
  * @param pValid Reference to a boolean set to true if found.
  * @param pIndex Index of the actor to retrieve.
- * @return Pointer to the actor.
+ * @return Pointer to the actor, or nullptr if there are not enough actors with this name.
  */
-Actor* Scene::GetActorByName(std::string pName, bool& pValid, int pIndex) const
+Actor* Scene::GetActorByName(std::string_view pName, bool& pValid, int pIndex) const
 {
-	return GetActorsByName(pName, pValid)[pIndex];
+	std::span<Actor* const> actors = GetActorsByName(pName, pValid);
+	pValid = pIndex >= 0 && pIndex < static_cast<int>(actors.size());
+	return pValid ? actors[pIndex] : nullptr;
 }
 
 /**
- * @brief Returns all actors by name.
+ * @brief Returns all actors by name from the name index, without copying them.
  * @param pName Name of the actor.
  * @param pValid Reference to a boolean set to true if any found.
- * @return Vector of pointers to actors.
+ * @return View of the actors, valid until an actor with this name is added, renamed or removed.
  */
-std::vector<Actor*> Scene::GetActorsByName(std::string pName, bool& pValid) const
+std::span<Actor* const> Scene::GetActorsByName(std::string_view pName, bool& pValid) const
 {
-	std::vector<Actor*> actors;
-	for (Actor* actor : mActors)
-	{
-		if (actor->GetName() == pName)
-			actors.push_back(actor);
-	}
-	pValid = !actors.empty();
-	return actors;
+	auto it = mActorsByName.find(pName);
+	pValid = it != mActorsByName.end();
+	return pValid ? std::span<Actor* const>(it->second) : std::span<Actor* const>();
 }
@@ -5,11 +5,21 @@
 
 #pragma once
 #include "../../Render/RendererSdl.h"
+#include "Core/Class/Component/ComponentScheduler.h"
+#include "Core/Class/Scene/TransformHierarchy.h"
+#include "Core/Physic/PhysicEngine.h"
+#include "Core/StringHash.h"
+#include <span>
 #include <string>
-#include <deque>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 class Camera;
 class Actor;
+class BaseCollisionComponent;
+class MeshComponent;
+class RigidbodyComponent;
 
 /**
  * @class Scene
@@ -20,8 +30,9 @@ class Scene
 public:
 	/**
 	 * @brief Pointer to the currently active scene.
+	 * Thread local, so worker threads see no scene and build their actors headless.
 	 */
-	static Scene* ActiveScene;
+	static thread_local Scene* ActiveScene;
 	
 	/**
 	 * @brief Renderer used for drawing the scene.
@@ -40,25 +51,101 @@ protected:
 	std::string mTitle;
 
 	/**
-	 * @brief List of actors currently in the scene.
+	 * @brief List of actors currently in the scene. Each actor stores its index, so removals swap with the last one.
 	 */
-	std::deque<Actor*> mActors;
+	std::vector<Actor*> mActors;
 
 	/**
 	 * @brief Actors pending to be added to the scene.
 	 */
-	std::deque<Actor*> mPendingActors;
+	std::vector<Actor*> mPendingActors;
+
+	/**
+	 * @brief Actors destroyed during the frame, deleted at the end of the update.
+	 */
+	std::vector<Actor*> mDestroyedActors;
 
 	/**
 	 * @brief Camera used in the scene.
 	 */
 	Camera* mCamera;
 
+	/**
+	 * @brief Physics world of the scene.
+	 */
+	PhysicEngine mPhysicEngine;
+
+	/**
+	 * @brief Update passes of the components of the actors in the scene.
+	 */
+	ComponentScheduler mComponentScheduler;
+
+	/**
+	 * @brief World transform pass of the actors in the scene, run once after the actors are updated.
+	 */
+	TransformHierarchy mTransformHierarchy;
+
 private:
 	/**
 	 * @brief Indicates if the actors are currently being updated.
 	 */
 	bool mUpdatingActors;
+
+	/**
+	 * @brief Actors of the scene grouped by class name.
+	 */
+	std::unordered_map<std::string, std::vector<Actor*>, StringHash, std::equal_to<>> mActorsByClass;
+
+	/**
+	 * @brief Actors of the scene grouped by name.
+	 */
+	std::unordered_map<std::string, std::vector<Actor*>, StringHash, std::equal_to<>> mActorsByName;
+
+	/**
+	 * @brief Adds an actor to the class and name indices.
+	 * @param actor Pointer to the actor.
+	 */
+	void IndexActor(Actor* actor);
+
+	/**
+	 * @brief Removes an actor from the class and name indices.
+	 * @param actor Pointer to the actor.
+	 */
+	void UnindexActor(Actor* actor);
+
+	/**
+	 * @brief Components of the destroyed actors, gathered to be unregistered in one batch. Kept between frames to avoid reallocations.
+	 */
+	std::vector<MeshComponent*> mDestroyedMeshes;
+
+	/**
+	 * @brief Collision components of the destroyed actors drawn by the renderer.
+	 */
+	std::vector<BaseCollisionComponent*> mDestroyedCollisions;
+
+	/**
+	 * @brief Rigidbodies of the destroyed actors registered in a physics world.
+	 */
+	std::vector<RigidbodyComponent*> mDestroyedRigidbodies;
+
+	/**
+	 * @brief Removes and deletes the actors destroyed during the frame.
+	 */
+	void FlushDestroyedActors();
+
+	/**
+	 * @brief Ends an update pass: adds the pending actors, deletes the destroyed ones and computes the world transforms that changed.
+	 */
+	void FinishUpdatePass();
+
+	/**
+	 * @brief Removes an actor from one index list.
+	 * @param pIndex The index.
+	 * @param pKey Class or name of the actor.
+	 * @param actor Pointer to the actor.
+	 * @return True if the actor was in the list.
+	 */
+	static bool RemoveFromIndex(std::unordered_map<std::string, std::vector<Actor*>, StringHash, std::equal_to<>>& pIndex, std::string_view pKey, Actor* actor);
 	
 public:
 	/**
@@ -77,10 +164,15 @@ public:
 	virtual void Start();
 
 	/**
-	 * @brief Updates the scene and its actors.
+	 * @brief Updates the scene and its actors, before the physics step.
 	 */
 	virtual void Update();
 
+	/**
+	 * @brief Runs the post physics and late component phases, after the physics step.
+	 */
+	virtual void LateUpdate();
+
 	/**
 	 * @brief Renders the scene.
 	 */
@@ -121,60 +213,91 @@ public:
 	void AddActor(Actor* actor);
 
 	/**
-	 * @brief Removes an actor from the scene.
+	 * @brief Removes an actor from the scene in O(1), without deleting it.
 	 * @param actor Pointer to the actor to remove.
 	 */
 	void RemoveActor(Actor* actor);
 
 	/**
-	 * @brief Updates all actors in the scene.
+	 * @brief Queues an actor to be removed and deleted at the end of the update.
+	 * @param actor Pointer to the actor to destroy.
+	 */
+	void DestroyActor(Actor* actor);
+
+	/**
+	 * @brief Updates the pre physics components type by type, then all actors in the scene.
 	 */
 	void UpdateActors();
 
+	/**
+	 * @brief Moves an actor to its new name in the name index. Called by Actor::SetName.
+	 * @param actor Pointer to the renamed actor.
+	 * @param pOldName Previous name of the actor.
+	 */
+	void OnActorRenamed(Actor* actor, std::string_view pOldName);
+
 public:
 	/**
 	 * @brief Gets the list of actors in the scene.
-	 * @return Deque of pointers to actors.
+	 * @return Reference to the vector of pointers to actors.
 	 */
-	std::deque<Actor*> GetActors();
+	const std::vector<Actor*>& GetActors() const;
 
 	/**
 	 * @brief Gets the renderer for the scene.
 	 * @return Reference to the renderer.
 	 */
 	IRenderer& GetRenderer();
+
+	/**
+	 * @brief Gets the physics world of the scene.
+	 * @return Reference to the PhysicEngine owned by the scene.
+	 */
+	PhysicEngine& GetPhysicEngine()
+	{
+		return mPhysicEngine;
+	}
+
+	/**
+	 * @brief Gets the scheduler updating the components of the scene.
+	 * @return Reference to the ComponentScheduler owned by the scene.
+	 */
+	ComponentScheduler& GetComponentScheduler()
+	{
+		return mComponentScheduler;
+	}
 	
 	/**
 	 * @brief Gets an actor of a specific class.
 	 * @param pClass Name of the class.
 	 * @param pValid Reference to a boolean set to true if found.
 	 * @param pIndex Index of the actor to retrieve.
-	 * @return Pointer to the actor.
+	 * @return Pointer to the actor, or nullptr if there are not enough actors of this class.
 	 */
-	Actor* GetActorOfClass(std::string pClass, bool& pValid, int pIndex = 0) const;
+	Actor* GetActorOfClass(std::string_view pClass, bool& pValid, int pIndex = 0) const;
 
 	/**
 	 * @brief Gets all actors of a specific class.
 	 * @param pClass Name of the class.
 	 * @param pValid Reference to a boolean set to true if any found.
-	 * @return Vector of pointers to actors.
+	 * @return View of the actors, valid until an actor of this class is added or removed.
 	 */
-	std::vector<Actor*> GetActorsOfClass(std::string pClass, bool& pValid) const;
+	std::span<Actor* const> GetActorsOfClass(std::string_view pClass, bool& pValid) const;
 
 	/**
 	 * @brief Gets an actor by name.
 	 * @param pName Name of the actor.
 	 * @param pValid Reference to a boolean set to true if found.
 	 * @param pIndex Index of the actor to retrieve.
-	 * @return Pointer to the actor.
+	 * @return Pointer to the actor, or nullptr if there are not enough actors with this name.
 	 */
-	Actor* GetActorByName(std::string pName, bool& pValid, int pIndex = 0) const;
+	Actor* GetActorByName(std::string_view pName, bool& pValid, int pIndex = 0) const;
 
 	/**
 	 * @brief Gets all actors by name.
 	 * @param pName Name of the actor.
 	 * @param pValid Reference to a boolean set to true if any found.
-	 * @return Vector of pointers to actors.
+	 * @return View of the actors, valid until an actor with this name is added, renamed or removed.
 	 */
-	std::vector<Actor*> GetActorsByName(std::string pName, bool& pValid) const;
+	std::span<Actor* const> GetActorsByName(std::string_view pName, bool& pValid) const;
 };
@@ -0,0 +1,91 @@
+/**
+ * @file SceneFile.cpp
+ * @brief Implementation of the SceneFile class, which maps a scene file.
+ */
+
+#include "SceneFile.h"
+
+#include "Debug/Log.h"
+
+/**
+ * @brief Maps a scene file and checks its header.
+ * @param pFilePath Path to the file.
+ * @return True if the file is a valid scene of the current version.
+ */
+bool SceneFile::Open(const std::string& pFilePath)
+{
+    Close();
+    if (!mFile.Open(pFilePath)) return false;
+
+    if (mFile.GetSize() < sizeof(SceneFileHeader))
+    {
+        Log::Error(LogType::Application, "Scene file " + pFilePath + " is truncated");
+        Close();
+        return false;
+    }
+
+    const SceneFileHeader* header = reinterpret_cast<const SceneFileHeader*>(mFile.GetData());
+    if (header->magic != SceneFileMagic)
+    {
+        Log::Error(LogType::Application, pFilePath + " is not a scene file");
+        Close();
+        return false;
+    }
+    if (header->version != SceneFileVersion)
+    {
+        Log::Error(LogType::Application, "Scene file " + pFilePath + " has version " + std::to_string(header->version) +
+            ", expected " + std::to_string(SceneFileVersion));
+        Close();
+        return false;
+    }
+
+    if (header->fileSize != mFile.GetSize() ||
+        !IsTableValid(header->actorOffset, header->actorCount, sizeof(SceneFileActor)) ||
+        !IsTableValid(header->componentOffset, header->componentCount, sizeof(SceneFileComponent)) ||
+        !IsTableValid(header->assetOffset, header->assetCount, sizeof(SceneFileAsset)) ||
+        !IsTableValid(header->textureLinkOffset, header->textureLinkCount, sizeof(uint32_t)) ||
+        !IsTableValid(header->stringTableOffset, header->stringTableSize, 1) ||
+        header->stringTableSize == 0 || mFile.GetData()[header->stringTableOffset + header->stringTableSize - 1] != '\0')
+    {
+        Log::Error(LogType::Application, "Scene file " + pFilePath + " is corrupted");
+        Close();
+        return false;
+    }
+
+    mHeader = header;
+    return true;
+}
+
+/**
+ * @brief Unmaps the file.
+ */
+void SceneFile::Close()
+{
+    mHeader = nullptr;
+    mFile.Close();
+}
+
+/**
+ * @brief Checks that a table lies inside the file.
+ * @param pOffset Offset of the table.
+ * @param pCount Number of records.
+ * @param pRecordSize Size of a record.
+ * @return True if the table is aligned and inside the file.
+ */
+bool SceneFile::IsTableValid(uint32_t pOffset, uint32_t pCount, size_t pRecordSize) const
+{
+    if (pRecordSize > 1 && pOffset % alignof(uint32_t) != 0) return false;
+    return pOffset <= mFile.GetSize() && pCount <= (mFile.GetSize() - pOffset) / pRecordSize;
+}
+
+/**
+ * @brief Gets a string of the string table.
+ * @param pOffset Offset of the string in the table.
+ * @return The string, or an empty string if the offset is outside the table.
+ */
+const char* SceneFile::GetString(uint32_t pOffset) const
+{
+    if (!mHeader || pOffset >= mHeader->stringTableSize) return "";
+    // The table ends with a null character, checked by Open
+    return reinterpret_cast<const char*>(mFile.GetData() + mHeader->stringTableOffset + pOffset);
+}
@@ -0,0 +1,293 @@
+/**
+ * @file SceneFile.h
+ * @brief Records of the binary scene format and declaration of the SceneFile class, which maps a scene file.
+ */
+
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+#include "Core/File/MappedFile.h"
+
+/**
+ * @brief Identifies a scene file, "AXSC" read as a little endian integer.
+ */
+constexpr uint32_t SceneFileMagic = 0x43535841;
+
+/**
+ * @brief Version written by the exporter. Files of another version are refused.
+ */
+constexpr uint32_t SceneFileVersion = 1;
+
+/**
+ * @brief Index or string offset meaning "none".
+ */
+constexpr uint32_t SceneFileNone = 0xFFFFFFFF;
+
+/**
+ * @struct SceneFileHeader
+ * @brief First bytes of a scene file. Each table is an array of fixed-size records at a 4-byte aligned offset.
+ */
+struct SceneFileHeader
+{
+    uint32_t magic;                 /**< SceneFileMagic. */
+    uint32_t version;               /**< SceneFileVersion. */
+    uint32_t fileSize;              /**< Size of the whole file, in bytes. */
+    uint32_t actorCount;            /**< Number of SceneFileActor records. */
+    uint32_t actorOffset;           /**< Offset of the actor table. */
+    uint32_t componentCount;        /**< Number of SceneFileComponent records. */
+    uint32_t componentOffset;       /**< Offset of the component table. */
+    uint32_t assetCount;            /**< Number of SceneFileAsset records. */
+    uint32_t assetOffset;           /**< Offset of the asset table. */
+    uint32_t textureLinkCount;      /**< Number of texture links, asset indices of the textures of the meshes. */
+    uint32_t textureLinkOffset;     /**< Offset of the texture links. */
+    uint32_t stringTableSize;       /**< Size of the string table, in bytes. */
+    uint32_t stringTableOffset;     /**< Offset of the string table, null-terminated strings referenced by offset. */
+};
+
+/**
+ * @enum SceneAssetKind
+ * @brief Type of an asset referenced by a scene.
+ */
+enum class SceneAssetKind : uint32_t
+{
+    Texture,    /**< Loaded with Asset::LoadTexture. */
+    Mesh        /**< Loaded with Asset::LoadMesh. */
+};
+
+/**
+ * @struct SceneFileAsset
+ * @brief An asset loaded before the actors are instantiated.
+ */
+struct SceneFileAsset
+{
+    SceneAssetKind kind;            /**< Type of the asset. */
+    uint32_t name;                  /**< Name in the asset manager, string offset. */
+    uint32_t path;                  /**< File path as given to the asset manager, string offset. */
+    uint32_t firstTextureLink;      /**< Mesh only, first texture link of the textures added to the mesh. */
+    uint32_t textureLinkCount;      /**< Mesh only, number of textures added to the mesh, the base texture excluded. */
+    uint32_t noiseTexture;          /**< Mesh only, asset index of the noise texture or SceneFileNone. */
+};
+
+/**
+ * @struct SceneFileActor
+ * @brief An actor and its local transform.
+ */
+struct SceneFileActor
+{
+    uint32_t name;                  /**< Name of the actor, string offset. */
+    uint32_t className;             /**< Class of the actor, string offset. */
+    uint32_t parent;                /**< Index of the parent actor or SceneFileNone. */
+    uint32_t firstComponent;        /**< Index of the first component record of the actor. */
+    uint32_t componentCount;        /**< Number of component records of the actor. */
+    float position[3];              /**< Local position. */
+    float rotation[4];              /**< Local rotation quaternion, x y z w. */
+    float scale[3];                 /**< Local scale. */
+};
+
+/**
+ * @enum SceneComponentKind
+ * @brief Type of a serialized component.
+ */
+enum class SceneComponentKind : uint32_t
+{
+    Mesh,               /**< MeshComponent. */
+    Rigidbody,          /**< RigidbodyComponent. */
+    BoxCollision,       /**< BoxCollisionComponent. */
+    SphereCollision,    /**< SphereCollisionComponent. */
+    PolyCollision       /**< PolyCollisionComponent. */
+};
+
+/**
+ * @enum SceneComponentFlags
+ * @brief Boolean properties of a serialized component.
+ */
+enum SceneComponentFlags : uint32_t
+{
+    SceneComponentVisible = 1 << 0,         /**< MeshComponent::SetVisible. */
+    SceneComponentTessellation = 1 << 1,    /**< MeshComponent::SetUseTessellation. */
+    SceneComponentLockRotation = 1 << 2     /**< RigidbodyComponent::SetLockRotation. */
+};
+
+/**
+ * @struct SceneFileMesh
+ * @brief Data of a MeshComponent.
+ */
+struct SceneFileMesh
+{
+    uint32_t mesh;                  /**< Asset index of the mesh. */
+    uint32_t textureIndex;          /**< Index of the texture drawn, in the textures of the mesh. */
+    int32_t tessellationLevel;      /**< Tessellation level. */
+    float tiling[2];                /**< Texture tiling. */
+    float displacementScale;        /**< Displacement scale. */
+};
+
+/**
+ * @struct SceneFileRigidbody
+ * @brief Data of a RigidbodyComponent.
+ */
+struct SceneFileRigidbody
+{
+    float mass;                     /**< Mass, 0 for a static body. */
+    float friction;                 /**< Friction coefficient. */
+    float restitution;              /**< Restitution coefficient. */
+    float angularDamping;           /**< Angular damping. */
+    float gravityScale;             /**< Gravity scale. */
+};
+
+/**
+ * @struct SceneFileBox
+ * @brief Data of a BoxCollisionComponent.
+ */
+struct SceneFileBox
+{
+    float min[3];                   /**< Minimum corner of the box. */
+    float max[3];                   /**< Maximum corner of the box. */
+};
+
+/**
+ * @struct SceneFileSphere
+ * @brief Data of a SphereCollisionComponent.
+ */
+struct SceneFileSphere
+{
+    float radius;                   /**< Radius of the sphere. */
+};
+
+/**
+ * @struct SceneFilePoly
+ * @brief Data of a PolyCollisionComponent.
+ */
+struct SceneFilePoly
+{
+    uint32_t mesh;                  /**< Asset index of the collision mesh. */
+};
+
+/**
+ * @struct SceneFileComponent
+ * @brief A component, its data is read according to its kind. Records of an actor follow its creation order,
+ * so a collision component comes after the mesh it is computed from.
+ */
+struct SceneFileComponent
+{
+    SceneComponentKind kind;        /**< Type of the component. */
+    uint32_t flags;                 /**< SceneComponentFlags. */
+    union
+    {
+        SceneFileMesh mesh;
+        SceneFileRigidbody rigidbody;
+        SceneFileBox box;
+        SceneFileSphere sphere;
+        SceneFilePoly poly;
+    };
+};
+
+static_assert(std::is_trivially_copyable_v<SceneFileHeader> && sizeof(SceneFileHeader) == 52, "Scene file header layout changed");
+static_assert(std::is_trivially_copyable_v<SceneFileAsset> && sizeof(SceneFileAsset) == 24, "Scene file asset layout changed");
+static_assert(std::is_trivially_copyable_v<SceneFileActor> && sizeof(SceneFileActor) == 60, "Scene file actor layout changed");
+static_assert(std::is_trivially_copyable_v<SceneFileComponent> && sizeof(SceneFileComponent) == 32, "Scene file component layout changed");
+
+/**
+ * @class SceneFile
+ * @brief A scene file mapped in memory. The tables are read in place, Open only checks that they fit in the file.
+ */
+class SceneFile
+{
+private:
+    /**
+     * @brief The mapped file.
+     */
+    MappedFile mFile;
+
+    /**
+     * @brief Header of the file, nullptr if no valid file is open.
+     */
+    const SceneFileHeader* mHeader = nullptr;
+
+    /**
+     * @brief Checks that a table lies inside the file.
+     * @param pOffset Offset of the table.
+     * @param pCount Number of records.
+     * @param pRecordSize Size of a record.
+     * @return True if the table is aligned and inside the file.
+     */
+    bool IsTableValid(uint32_t pOffset, uint32_t pCount, size_t pRecordSize) const;
+
+    /**
+     * @brief Gets a table of the file.
+     * @param pOffset Offset of the table.
+     * @param pCount Number of records.
+     * @return The records, read in place.
+     */
+    template<typename T> std::span<const T> GetTable(uint32_t pOffset, uint32_t pCount) const
+    {
+        if (!mHeader) return {};
+        return std::span<const T>(reinterpret_cast<const T*>(mFile.GetData() + pOffset), pCount);
+    }
+
+public:
+    /**
+     * @brief Maps a scene file and checks its header.
+     * @param pFilePath Path to the file.
+     * @return True if the file is a valid scene of the current version.
+     */
+    bool Open(const std::string& pFilePath);
+
+    /**
+     * @brief Unmaps the file.
+     */
+    void Close();
+
+    /**
+     * @brief Checks if a valid file is open.
+     * @return True if the tables can be read.
+     */
+    bool IsOpen() const
+    {
+        return mHeader != nullptr;
+    }
+
+    /**
+     * @brief Gets the actors of the scene.
+     * @return The actor records.
+     */
+    std::span<const SceneFileActor> GetActors() const
+    {
+        return mHeader ? GetTable<SceneFileActor>(mHeader->actorOffset, mHeader->actorCount) : std::span<const SceneFileActor>();
+    }
+
+    /**
+     * @brief Gets the components of the actors.
+     * @return The component records.
+     */
+    std::span<const SceneFileComponent> GetComponents() const
+    {
+        return mHeader ? GetTable<SceneFileComponent>(mHeader->componentOffset, mHeader->componentCount) : std::span<const SceneFileComponent>();
+    }
+
+    /**
+     * @brief Gets the assets referenced by the scene.
+     * @return The asset records.
+     */
+    std::span<const SceneFileAsset> GetAssets() const
+    {
+        return mHeader ? GetTable<SceneFileAsset>(mHeader->assetOffset, mHeader->assetCount) : std::span<const SceneFileAsset>();
+    }
+
+    /**
+     * @brief Gets the texture links of the meshes.
+     * @return Asset indices of textures.
+     */
+    std::span<const uint32_t> GetTextureLinks() const
+    {
+        return mHeader ? GetTable<uint32_t>(mHeader->textureLinkOffset, mHeader->textureLinkCount) : std::span<const uint32_t>();
+    }
+
+    /**
+     * @brief Gets a string of the string table.
+     * @param pOffset Offset of the string in the table.
+     * @return The string, or an empty string if the offset is outside the table.
+     */
+    const char* GetString(uint32_t pOffset) const;
+};
@@ -0,0 +1,466 @@
+/**
+ * @file SceneSerializer.cpp
+ * @brief Implementation of the SceneSerializer class, which writes scenes to scene files and instantiates them back.
+ */
+
+#include "SceneSerializer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <typeinfo>
+
+#include "Scene.h"
+#include "SceneFile.h"
+#include "Core/Class/Actor/Actor.h"
+#include "Core/Physic/Component/BoxCollisionComponent.h"
+#include "Core/Physic/Component/PolyCollisionComponent.h"
+#include "Core/Physic/Component/RigidbodyComponent.h"
+#include "Core/Physic/Component/SphereCollisionComponent.h"
+#include "Core/Render/Asset.h"
+#include "Core/Render/Component/MeshComponent.h"
+#include "Debug/Log.h"
+
+std::unordered_map<std::string, SceneSerializer::ActorFactory, StringHash, std::equal_to<>> SceneSerializer::mFactories = {};
+
+/**
+ * @brief Name of the texture every uploaded mesh starts with, loaded by Scene::Load.
+ */
+static const std::string BASE_TEXTURE_NAME = "BaseTexture";
+
+/**
+ * @brief Strings of a scene file being written, each distinct string stored once.
+ */
+struct SceneStringTable
+{
+    std::string data = std::string(1, '\0');
+    std::unordered_map<std::string, uint32_t> offsets = {{"", 0}};
+
+    uint32_t Add(const std::string& pString)
+    {
+        auto found = offsets.find(pString);
+        if (found != offsets.end()) return found->second;
+
+        uint32_t offset = static_cast<uint32_t>(data.size());
+        data.append(pString);
+        data.push_back('\0');
+        offsets.emplace(pString, offset);
+        return offset;
+    }
+};
+
+/**
+ * @brief Assets of a scene file being written, each asset of the asset manager stored once.
+ */
+struct SceneAssetTable
+{
+    SceneStringTable& strings;
+    std::vector<SceneFileAsset> assets;
+    std::vector<uint32_t> textureLinks;
+    std::unordered_map<const void*, uint32_t> indices;
+
+    uint32_t AddTexture(const Texture* pTexture)
+    {
+        if (!pTexture) return SceneFileNone;
+        auto found = indices.find(pTexture);
+        if (found != indices.end()) return found->second;
+
+        uint32_t index = SceneFileNone;
+        for (const auto& texture : Asset::mTextures)
+        {
+            if (&texture.second != pTexture || texture.first == BASE_TEXTURE_NAME) continue;
+            index = static_cast<uint32_t>(assets.size());
+            assets.push_back({SceneAssetKind::Texture, strings.Add(texture.first), strings.Add(texture.second.GetFilePath()),
+                0, 0, SceneFileNone});
+            break;
+        }
+        indices[pTexture] = index;
+        return index;
+    }
+
+    uint32_t AddMesh(Mesh* pMesh)
+    {
+        if (!pMesh) return SceneFileNone;
+        auto found = indices.find(pMesh);
+        if (found != indices.end()) return found->second;
+
+        uint32_t index = SceneFileNone;
+        for (const auto& mesh : Asset::mMeshes)
+        {
+            if (&mesh.second != pMesh) continue;
+            std::string fileName = Asset::GetMeshFileName(mesh.first);
+            if (fileName.empty()) break;
+
+            index = static_cast<uint32_t>(assets.size());
+            assets.push_back({SceneAssetKind::Mesh, strings.Add(mesh.first), strings.Add(fileName), 0, 0, SceneFileNone});
+            break;
+        }
+        indices[pMesh] = index;
+        if (index == SceneFileNone)
+        {
+            Log::Warning(LogType::Application, "A mesh not loaded from a file is not exported");
+            return index;
+        }
+
+        // The textures are linked after the mesh record, adding them may grow the asset table
+        std::vector<uint32_t> links;
+        for (size_t i = 0; i < pMesh->GetTextureCount(); i++)
+        {
+            uint32_t texture = AddTexture(pMesh->GetTexture(i));
+            if (texture != SceneFileNone) links.push_back(texture);
+        }
+        uint32_t noiseTexture = AddTexture(pMesh->GetNoiseTexture());
+
+        SceneFileAsset& asset = assets[index];
+        asset.firstTextureLink = static_cast<uint32_t>(textureLinks.size());
+        asset.textureLinkCount = static_cast<uint32_t>(links.size());
+        asset.noiseTexture = noiseTexture;
+        textureLinks.insert(textureLinks.end(), links.begin(), links.end());
+        return index;
+    }
+};
+
+/**
+ * @brief Appends a table to a file being written, at a 4-byte aligned offset.
+ * @param pBuffer Content of the file.
+ * @param pData First byte of the table.
+ * @param pSize Size of the table.
+ * @return Offset of the table.
+ */
+static uint32_t AppendTable(std::vector<unsigned char>& pBuffer, const void* pData, size_t pSize)
+{
+    pBuffer.resize((pBuffer.size() + 3) & ~size_t(3), 0);
+    uint32_t offset = static_cast<uint32_t>(pBuffer.size());
+    const unsigned char* bytes = static_cast<const unsigned char*>(pData);
+    pBuffer.insert(pBuffer.end(), bytes, bytes + pSize);
+    return offset;
+}
+
+/**
+ * @brief Writes the actors of a scene and the assets they use to a scene file.
+ * Paused and dead actors are not written, the base texture is left to Scene::Load.
+ * @param pScene The scene.
+ * @param pFilePath Path to the file, its directory is created if needed.
+ * @return True if the file was written.
+ */
+bool SceneSerializer::Export(Scene& pScene, const std::string& pFilePath)
+{
+    SceneStringTable strings;
+    SceneAssetTable assets{strings, {}, {}, {}};
+    std::vector<SceneFileActor> actors;
+    std::vector<SceneFileComponent> components;
+    std::set<std::string> skippedComponents;
+
+    // Paused actors are the free instances of pools, recreated by their owner
+    std::vector<Actor*> exported;
+    std::unordered_map<const Actor*, uint32_t> actorIndices;
+    for (Actor* actor : pScene.GetActors())
+    {
+        if (actor->GetState() != ActorState::Active) continue;
+        actorIndices[actor] = static_cast<uint32_t>(exported.size());
+        exported.push_back(actor);
+    }
+
+    for (Actor* actor : exported)
+    {
+        SceneFileActor record = {};
+        record.name = strings.Add(actor->GetName());
+        record.className = strings.Add(actor->GetClass());
+        auto parent = actorIndices.find(actor->GetParent());
+        record.parent = parent != actorIndices.end() ? parent->second : SceneFileNone;
+
+        Vec3 position = actor->GetLocation();
+        Quaternion rotation = actor->GetRotation();
+        Vec3 scale = actor->GetScale();
+        record.position[0] = position.x; record.position[1] = position.y; record.position[2] = position.z;
+        record.rotation[0] = rotation.x; record.rotation[1] = rotation.y; record.rotation[2] = rotation.z; record.rotation[3] = rotation.w;
+        record.scale[0] = scale.x; record.scale[1] = scale.y; record.scale[2] = scale.z;
+
+        record.firstComponent = static_cast<uint32_t>(components.size());
+        for (Component* component : actor->GetComponents())
+        {
+            SceneFileComponent data = {};
+            if (MeshComponent* mesh = dynamic_cast<MeshComponent*>(component))
+            {
+                data.kind = SceneComponentKind::Mesh;
+                data.flags = (mesh->GetVisible() ? static_cast<uint32_t>(SceneComponentVisible) : 0u) |
+                    (mesh->GetUseTessellation() ? static_cast<uint32_t>(SceneComponentTessellation) : 0u);
+                data.mesh.mesh = assets.AddMesh(mesh->GetMesh());
+                data.mesh.textureIndex = static_cast<uint32_t>(mesh->GetTextureIndex());
+                data.mesh.tessellationLevel = mesh->GetTessellationLevel();
+                data.mesh.tiling[0] = mesh->GetTiling().x;
+                data.mesh.tiling[1] = mesh->GetTiling().y;
+                data.mesh.displacementScale = mesh->GetDisplacementScale();
+            }
+            else if (RigidbodyComponent* rigidbody = dynamic_cast<RigidbodyComponent*>(component))
+            {
+                data.kind = SceneComponentKind::Rigidbody;
+                data.flags = rigidbody->IsRotationLocked() ? static_cast<uint32_t>(SceneComponentLockRotation) : 0u;
+                data.rigidbody.mass = rigidbody->GetMass();
+                data.rigidbody.friction = rigidbody->GetFriction();
+                data.rigidbody.restitution = rigidbody->GetRestitution();
+                data.rigidbody.angularDamping = rigidbody->GetAngularDamping();
+                data.rigidbody.gravityScale = rigidbody->GetGravityScale();
+            }
+            else if (PolyCollisionComponent* poly = dynamic_cast<PolyCollisionComponent*>(component))
+            {
+                data.kind = SceneComponentKind::PolyCollision;
+                data.poly.mesh = assets.AddMesh(poly->GetMesh());
+            }
+            else if (BoxCollisionComponent* box = dynamic_cast<BoxCollisionComponent*>(component))
+            {
+                Box boundingBox = box->GetBoundingBox();
+                data.kind = SceneComponentKind::BoxCollision;
+                data.box.min[0] = boundingBox.min.x; data.box.min[1] = boundingBox.min.y; data.box.min[2] = boundingBox.min.z;
+                data.box.max[0] = boundingBox.max.x; data.box.max[1] = boundingBox.max.y; data.box.max[2] = boundingBox.max.z;
+            }
+            else if (SphereCollisionComponent* sphere = dynamic_cast<SphereCollisionComponent*>(component))
+            {
+                data.kind = SceneComponentKind::SphereCollision;
+                data.sphere.radius = sphere->GetRadius();
+            }
+            else
+            {
+                skippedComponents.insert(typeid(*component).name());
+                continue;
+            }
+            components.push_back(data);
+        }
+        record.componentCount = static_cast<uint32_t>(components.size()) - record.firstComponent;
+        actors.push_back(record);
+    }
+
+    for (const std::string& skipped : skippedComponents)
+    {
+        Log::Warning(LogType::Application, "Components " + skipped + " are not exported");
+    }
+
+    std::vector<unsigned char> buffer(sizeof(SceneFileHeader), 0);
+    SceneFileHeader header = {};
+    header.magic = SceneFileMagic;
+    header.version = SceneFileVersion;
+    header.actorCount = static_cast<uint32_t>(actors.size());
+    header.actorOffset = AppendTable(buffer, actors.data(), actors.size() * sizeof(SceneFileActor));
+    header.componentCount = static_cast<uint32_t>(components.size());
+    header.componentOffset = AppendTable(buffer, components.data(), components.size() * sizeof(SceneFileComponent));
+    header.assetCount = static_cast<uint32_t>(assets.assets.size());
+    header.assetOffset = AppendTable(buffer, assets.assets.data(), assets.assets.size() * sizeof(SceneFileAsset));
+    header.textureLinkCount = static_cast<uint32_t>(assets.textureLinks.size());
+    header.textureLinkOffset = AppendTable(buffer, assets.textureLinks.data(), assets.textureLinks.size() * sizeof(uint32_t));
+    header.stringTableSize = static_cast<uint32_t>(strings.data.size());
+    header.stringTableOffset = AppendTable(buffer, strings.data.data(), strings.data.size());
+    header.fileSize = static_cast<uint32_t>(buffer.size());
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    std::filesystem::path path(pFilePath);
+    std::error_code error;
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), error);
+
+    std::ofstream file(pFilePath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    if (!file)
+    {
+        Log::Error(LogType::Application, "Could not write scene file " + pFilePath);
+        return false;
+    }
+
+    Log::Info("Exported " + std::to_string(actors.size()) + " actors, " + std::to_string(components.size()) + " components and " +
+        std::to_string(assets.assets.size()) + " assets to " + pFilePath + " (" + std::to_string(buffer.size()) + " bytes)");
+    return true;
+}
+
+/**
+ * @brief Loads the assets of a scene file into the asset manager, or queues them to the streaming loader.
+ * @param pFile The scene file.
+ * @param pRenderer Renderer creating the textures, nullptr to skip the textures in headless runs.
+ * @param pUploadToGpu Whether to upload the meshes to the GPU.
+ */
+void SceneSerializer::LoadAssets(const SceneFile& pFile, IRenderer* pRenderer, bool pUploadToGpu)
+{
+    for (const SceneFileAsset& asset : pFile.GetAssets())
+    {
+        if (asset.kind == SceneAssetKind::Mesh)
+        {
+            Asset::LoadMesh(pFile.GetString(asset.path), pFile.GetString(asset.name), pUploadToGpu);
+        }
+        else if (asset.kind == SceneAssetKind::Texture && pRenderer)
+        {
+            Asset::LoadTexture(*pRenderer, pFile.GetString(asset.path), pFile.GetString(asset.name));
+        }
+    }
+}
+
+/**
+ * @brief Creates the actors of a scene file. The assets must be in the asset manager.
+ * Textures are linked to the meshes that do not have them yet, so instantiating a file twice does not add them again.
+ * The camera record only moves the camera of the scene.
+ * @param pFile The scene file.
+ * @param pScene Scene receiving the actors, nullptr for headless actors owned by the caller.
+ * @return The created actors.
+ */
+std::vector<Actor*> SceneSerializer::Instantiate(const SceneFile& pFile, Scene* pScene)
+{
+    std::span<const SceneFileActor> actors = pFile.GetActors();
+    std::span<const SceneFileComponent> components = pFile.GetComponents();
+    std::span<const SceneFileAsset> assets = pFile.GetAssets();
+    std::span<const uint32_t> textureLinks = pFile.GetTextureLinks();
+
+    // Resolve the asset table once, the components then index it directly
+    std::vector<Mesh*> meshes(assets.size(), nullptr);
+    std::vector<Texture*> textures(assets.size(), nullptr);
+    for (size_t i = 0; i < assets.size(); i++)
+    {
+        const char* name = pFile.GetString(assets[i].name);
+        if (assets[i].kind == SceneAssetKind::Texture)
+        {
+            auto texture = Asset::mTextures.find(name);
+            if (texture != Asset::mTextures.end()) textures[i] = &texture->second;
+        }
+        else if (assets[i].kind == SceneAssetKind::Mesh)
+        {
+            auto mesh = Asset::mMeshes.find(name);
+            if (mesh != Asset::mMeshes.end()) meshes[i] = &mesh->second;
+            else Log::Error(LogType::Application, std::string("Scene mesh ") + name + " is not loaded");
+        }
+    }
+    for (size_t i = 0; i < assets.size(); i++)
+    {
+        Mesh* mesh = meshes[i];
+        if (!mesh || mesh->GetTextureCount() > (mesh->IsUploaded() ? 1u : 0u)) continue;
+
+        const SceneFileAsset& asset = assets[i];
+        for (uint32_t link = asset.firstTextureLink; link < asset.firstTextureLink + asset.textureLinkCount && link < textureLinks.size(); link++)
+        {
+            if (textureLinks[link] < textures.size() && textures[textureLinks[link]]) mesh->AddTexture(textures[textureLinks[link]]);
+        }
+        if (asset.noiseTexture < textures.size() && textures[asset.noiseTexture]) mesh->SetNoiseTexture(*textures[asset.noiseTexture]);
+    }
+    auto getMesh = [&meshes](uint32_t pIndex) { return pIndex < meshes.size() ? meshes[pIndex] : nullptr; };
+
+    auto setTransform = [](Actor* pActor, const SceneFileActor& pRecord)
+    {
+        pActor->SetLocation(Vec3(pRecord.position[0], pRecord.position[1], pRecord.position[2]));
+        pActor->SetRotation(Quaternion(pRecord.rotation[0], pRecord.rotation[1], pRecord.rotation[2], pRecord.rotation[3]));
+        pActor->SetScale(Vec3(pRecord.scale[0], pRecord.scale[1], pRecord.scale[2]));
+    };
+
+    std::vector<Actor*> created(actors.size(), nullptr);
+    for (size_t i = 0; i < actors.size(); i++)
+    {
+        const SceneFileActor& record = actors[i];
+        std::string_view className = pFile.GetString(record.className);
+
+        if (className == "Camera")
+        {
+            bool valid = false;
+            Actor* camera = pScene ? pScene->GetActorOfClass("Camera", valid) : nullptr;
+            if (valid) setTransform(camera, record);
+            continue;
+        }
+
+        Actor* actor = nullptr;
+        bool fromFactory = false;
+        if (auto factory = mFactories.find(className); factory != mFactories.end())
+        {
+            actor = factory->second();
+            fromFactory = actor != nullptr;
+        }
+        if (!actor)
+        {
+            //Classes without factory are rebuilt as plain actors from their serialized components
+            if (className != "Actor")
+            {
+                Log::Warning(LogType::Application, "No factory for actor class " + std::string(className) + ", " +
+                    pFile.GetString(record.name) + " is loaded as an Actor");
+            }
+            actor = new Actor();
+        }
+
+        actor->SetName(pFile.GetString(record.name));
+        if (pScene) pScene->AddActor(actor);
+        setTransform(actor, record);
+        created[i] = actor;
+        if (fromFactory) continue;
+
+        MeshComponent* meshComponent = nullptr;
+        uint32_t end = std::min<uint32_t>(record.firstComponent + record.componentCount, static_cast<uint32_t>(components.size()));
+        for (uint32_t c = record.firstComponent; c < end; c++)
+        {
+            const SceneFileComponent& data = components[c];
+            switch (data.kind)
+            {
+            case SceneComponentKind::Mesh:
+                meshComponent = new MeshComponent(actor);
+                if (Mesh* mesh = getMesh(data.mesh.mesh)) meshComponent->SetMesh(*mesh);
+                meshComponent->SetTextureIndex(data.mesh.textureIndex);
+                meshComponent->SetVisible((data.flags & SceneComponentVisible) != 0);
+                meshComponent->SetUseTessellation((data.flags & SceneComponentTessellation) != 0);
+                meshComponent->SetTessellationLevel(data.mesh.tessellationLevel);
+                meshComponent->SetTiling(Vec2(data.mesh.tiling[0], data.mesh.tiling[1]));
+                meshComponent->SetDisplacementScale(data.mesh.displacementScale);
+                break;
+            case SceneComponentKind::Rigidbody:
+            {
+                RigidbodyComponent* rigidbody = new RigidbodyComponent(actor);
+                rigidbody->SetMass(data.rigidbody.mass);
+                rigidbody->SetFriction(data.rigidbody.friction);
+                rigidbody->SetRestitution(data.rigidbody.restitution);
+                rigidbody->SetAngularDamping(data.rigidbody.angularDamping);
+                rigidbody->SetGravityScale(data.rigidbody.gravityScale);
+                rigidbody->SetLockRotation((data.flags & SceneComponentLockRotation) != 0);
+                break;
+            }
+            case SceneComponentKind::BoxCollision:
+            {
+                Box box;
+                box.min = Vec3(data.box.min[0], data.box.min[1], data.box.min[2]);
+                box.max = Vec3(data.box.max[0], data.box.max[1], data.box.max[2]);
+                new BoxCollisionComponent(actor, box);
+                break;
+            }
+            case SceneComponentKind::SphereCollision:
+                new SphereCollisionComponent(actor, data.sphere.radius);
+                break;
+            case SceneComponentKind::PolyCollision:
+                // The box around the polygon is computed from the mesh of the actor
+                if (meshComponent && meshComponent->GetMesh() && getMesh(data.poly.mesh))
+                {
+                    new PolyCollisionComponent(actor, getMesh(data.poly.mesh));
+                }
+                else
+                {
+                    Log::Warning(LogType::Application, std::string("Poly collision of ") + pFile.GetString(record.name) + " has no mesh, skipped");
+                }
+                break;
+            default:
+                Log::Warning(LogType::Application, std::string("Unknown component kind in ") + pFile.GetString(record.name));
+                break;
+            }
+        }
+    }
+
+    // Parents may be stored after their children
+    for (size_t i = 0; i < actors.size(); i++)
+    {
+        uint32_t parent = actors[i].parent;
+        if (created[i] && parent < created.size() && created[parent])
+        {
+            created[i]->AttachTo(created[parent]);
+        }
+    }
+
+    std::erase(created, nullptr);
+    return created;
+}
+
+/**
+ * @brief Registers the factory creating the actors of a class.
+ * @param pClassName Class name of the actors, as returned by Actor::GetClass.
+ * @param pFactory The factory.
+ */
+void SceneSerializer::RegisterActorClass(const std::string& pClassName, ActorFactory pFactory)
+{
+    mFactories[pClassName] = std::move(pFactory);
+}
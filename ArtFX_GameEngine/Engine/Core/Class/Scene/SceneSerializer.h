@@ -0,0 +1,75 @@
+/**
+ * @file SceneSerializer.h
+ * @brief Declaration of the SceneSerializer class, which writes scenes to scene files and instantiates them back.
+ */
+
+#pragma once
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Core/StringHash.h"
+
+class Actor;
+class IRenderer;
+class Scene;
+class SceneFile;
+
+/**
+ * @class SceneSerializer
+ * @brief Exports the actors of a scene to the binary scene format and creates them back from a mapped SceneFile.
+ *
+ * Plain actors are rebuilt from their mesh, rigidbody and collision components. Actors of another class are created
+ * by the factory registered for their class and only get their transform from the file, their components being
+ * created by the class itself. Classes without a registered factory are loaded as plain actors from their components.
+ * Components the format does not describe are skipped by the exporter with a warning.
+ */
+class SceneSerializer
+{
+public:
+    /**
+     * @brief Creates an actor of a registered class, before it is added to the scene.
+     */
+    using ActorFactory = std::function<Actor*()>;
+
+    SceneSerializer() = delete; /**< Deleted default constructor to prevent instantiation. */
+
+    /**
+     * @brief Writes the actors of a scene and the assets they use to a scene file.
+     * Paused and dead actors are not written, the base texture is left to Scene::Load.
+     * @param pScene The scene.
+     * @param pFilePath Path to the file, its directory is created if needed.
+     * @return True if the file was written.
+     */
+    static bool Export(Scene& pScene, const std::string& pFilePath);
+
+    /**
+     * @brief Loads the assets of a scene file into the asset manager, or queues them to the streaming loader.
+     * @param pFile The scene file.
+     * @param pRenderer Renderer creating the textures, nullptr to skip the textures in headless runs.
+     * @param pUploadToGpu Whether to upload the meshes to the GPU.
+     */
+    static void LoadAssets(const SceneFile& pFile, IRenderer* pRenderer, bool pUploadToGpu = true);
+
+    /**
+     * @brief Creates the actors of a scene file. The assets must be in the asset manager.
+     * @param pFile The scene file.
+     * @param pScene Scene receiving the actors, nullptr for headless actors owned by the caller.
+     * @return The created actors.
+     */
+    static std::vector<Actor*> Instantiate(const SceneFile& pFile, Scene* pScene);
+
+    /**
+     * @brief Registers the factory creating the actors of a class.
+     * @param pClassName Class name of the actors, as returned by Actor::GetClass.
+     * @param pFactory The factory.
+     */
+    static void RegisterActorClass(const std::string& pClassName, ActorFactory pFactory);
+
+private:
+    /**
+     * @brief Factories of the registered actor classes.
+     */
+    static std::unordered_map<std::string, ActorFactory, StringHash, std::equal_to<>> mFactories;
+};
@@ -0,0 +1,154 @@
+/**
+ * @file TransformHierarchy.cpp
+ * @brief Implementation of the TransformHierarchy class, which computes the world transforms of a scene in one pass.
+ */
+
+#include "TransformHierarchy.h"
+
+#include "Debug/Profiler.h"
+#include "Math/Transform.h"
+
+/**
+ * @brief Registers a transform. Registering a transform of another hierarchy moves it.
+ * @param pTransform The transform to register.
+ */
+void TransformHierarchy::Register(Transform* pTransform)
+{
+    if (pTransform->mHierarchy == this) return;
+    if (pTransform->mHierarchy)
+    {
+        pTransform->mHierarchy->Unregister(pTransform);
+    }
+
+    pTransform->mHierarchy = this;
+    pTransform->mHierarchySlot = mTransforms.size();
+    mTransforms.push_back(pTransform);
+    mOrderDirty = true;
+}
+
+/**
+ * @brief Unregisters a transform. Its owner computes it again in Actor::Update.
+ * @param pTransform The transform to unregister.
+ */
+void TransformHierarchy::Unregister(Transform* pTransform)
+{
+    if (pTransform->mHierarchy != this) return;
+
+    Transform* last = mTransforms.back();
+    mTransforms[pTransform->mHierarchySlot] = last;
+    last->mHierarchySlot = pTransform->mHierarchySlot;
+    mTransforms.pop_back();
+
+    pTransform->mHierarchy = nullptr;
+    mOrderDirty = true;
+
+    std::lock_guard lock(mDirtyRootsMutex);
+    std::erase(mDirtyRoots, pTransform);
+}
+
+/**
+ * @brief Recomputes the world transform of every dirty registered transform, walking only the dirty subtrees.
+ * A root whose parent is still dirty is skipped, the root queued for that parent covers its range. After a rebuild,
+ * a reparented transform may be dirty outside of any queued subtree, so the whole order is walked once.
+ */
+void TransformHierarchy::Update()
+{
+    bool fullWalk = mOrderDirty;
+    if (mOrderDirty)
+    {
+        RebuildOrder();
+    }
+
+    // Components reacting to the new world transforms may move transforms again, they are queued for the next update
+    {
+        std::lock_guard lock(mDirtyRootsMutex);
+        mUpdatingRoots.swap(mDirtyRoots);
+    }
+    if (!fullWalk && mUpdatingRoots.empty()) return;
+
+    PROFILE_SCOPE("TransformHierarchy");
+    if (fullWalk)
+    {
+        UpdateRange(0, mOrder.size());
+    }
+    else
+    {
+        for (Transform* root : mUpdatingRoots)
+        {
+            Transform* parent = root->mParent;
+            if (parent && parent->mHierarchy == this && parent->mNeedsUpdate) continue;
+            UpdateRange(root->mOrderBegin, root->mOrderEnd);
+        }
+    }
+    mUpdatingRoots.clear();
+}
+
+/**
+ * @brief Recomputes the dirty transforms of a range of the update order.
+ * A dirty parent has dirty children, so when a transform is computed its parent already was.
+ * @param pBegin First index of the range.
+ * @param pEnd Index past the last one of the range.
+ */
+void TransformHierarchy::UpdateRange(size_t pBegin, size_t pEnd)
+{
+    for (size_t i = pBegin; i < pEnd; i++)
+    {
+        if (mOrder[i]->mNeedsUpdate)
+        {
+            mOrder[i]->UpdateWorldTransform();
+        }
+    }
+}
+
+/**
+ * @brief Unregisters every transform.
+ */
+void TransformHierarchy::Clear()
+{
+    for (Transform* transform : mTransforms)
+    {
+        transform->mHierarchy = nullptr;
+    }
+    mTransforms.clear();
+    mOrder.clear();
+    mOrderDirty = false;
+
+    std::lock_guard lock(mDirtyRootsMutex);
+    mDirtyRoots.clear();
+}
+
+/**
+ * @brief Rebuilds the update order from the roots of the registered transforms.
+ * A transform whose parent is not registered here is a root, its parent is computed by its own owner.
+ */
+void TransformHierarchy::RebuildOrder()
+{
+    mOrder.clear();
+    for (Transform* transform : mTransforms)
+    {
+        Transform* parent = transform->mParent;
+        if (!parent || parent->mHierarchy != this)
+        {
+            AppendSubtree(transform);
+        }
+    }
+    mOrderDirty = false;
+}
+
+/**
+ * @brief Appends a transform and its registered descendants to the update order, and stores the range of its subtree.
+ * @param pTransform The transform.
+ */
+void TransformHierarchy::AppendSubtree(Transform* pTransform)
+{
+    pTransform->mOrderBegin = mOrder.size();
+    mOrder.push_back(pTransform);
+    for (Transform* child : pTransform->mChildren)
+    {
+        if (child->mHierarchy == this)
+        {
+            AppendSubtree(child);
+        }
+    }
+    pTransform->mOrderEnd = mOrder.size();
+}
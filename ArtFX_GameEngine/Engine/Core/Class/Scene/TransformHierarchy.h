@@ -0,0 +1,123 @@
+/**
+ * @file TransformHierarchy.h
+ * @brief Declaration of the TransformHierarchy class, which computes the world transforms of a scene in one pass.
+ */
+
+#pragma once
+#include <mutex>
+#include <vector>
+
+class Transform;
+
+/**
+ * @class TransformHierarchy
+ * @brief Computes the world transforms of the actors of a scene, parents before children.
+ *
+ * The registered transforms are ordered depth first, rebuilt only when a transform is registered, removed or
+ * reparented, so every subtree is a range of that order. Marking a transform dirty also marks its children and
+ * queues the topmost dirty transform as a dirty root. The update walks only the ranges of the dirty roots,
+ * parents before children, so its cost follows the number of moved transforms rather than the size of the scene.
+ * The whole order is walked only on the update following a rebuild.
+ */
+class TransformHierarchy
+{
+private:
+    /**
+     * @brief Registered transforms, in registration order. Each transform stores its slot, so removals are O(1).
+     */
+    std::vector<Transform*> mTransforms;
+
+    /**
+     * @brief Registered transforms in update order, parents always before their children. Each transform stores the
+     * range of its subtree.
+     */
+    std::vector<Transform*> mOrder;
+
+    /**
+     * @brief Topmost dirty transforms since the last update, whose subtrees must be recomputed.
+     */
+    std::vector<Transform*> mDirtyRoots;
+
+    /**
+     * @brief Dirty roots being walked by Update(), swapped with mDirtyRoots to keep both allocations.
+     */
+    std::vector<Transform*> mUpdatingRoots;
+
+    /**
+     * @brief Protects mDirtyRoots, components updated in parallel move their owner.
+     */
+    std::mutex mDirtyRootsMutex;
+
+    /**
+     * @brief Whether mOrder must be rebuilt before the next update.
+     */
+    bool mOrderDirty = false;
+
+    /**
+     * @brief Rebuilds the update order from the roots of the registered transforms.
+     */
+    void RebuildOrder();
+
+    /**
+     * @brief Appends a transform and its registered descendants to the update order, and stores the range of its subtree.
+     * @param pTransform The transform.
+     */
+    void AppendSubtree(Transform* pTransform);
+
+    /**
+     * @brief Recomputes the dirty transforms of a range of the update order.
+     * @param pBegin First index of the range.
+     * @param pEnd Index past the last one of the range.
+     */
+    void UpdateRange(size_t pBegin, size_t pEnd);
+
+public:
+    /**
+     * @brief Registers a transform. Registering a transform of another hierarchy moves it.
+     * @param pTransform The transform to register.
+     */
+    void Register(Transform* pTransform);
+
+    /**
+     * @brief Unregisters a transform. Its owner computes it again in Actor::Update.
+     * @param pTransform The transform to unregister.
+     */
+    void Unregister(Transform* pTransform);
+
+    /**
+     * @brief Recomputes the world transform of every dirty registered transform, walking only the dirty subtrees.
+     */
+    void Update();
+
+    /**
+     * @brief Unregisters every transform.
+     */
+    void Clear();
+
+    /**
+     * @brief Requests a rebuild of the update order. Called when a registered transform changes parent.
+     */
+    void MarkOrderDirty()
+    {
+        mOrderDirty = true;
+    }
+
+    /**
+     * @brief Queues a dirty root. Called when a registered transform is marked dirty while its parent is not.
+     * @param pTransform The transform.
+     */
+    void MarkDirty(Transform* pTransform)
+    {
+        std::lock_guard lock(mDirtyRootsMutex);
+        mDirtyRoots.push_back(pTransform);
+    }
+
+    /**
+     * @brief Gets the number of registered transforms.
+     * @return The number of transforms.
+     */
+    size_t GetCount() const
+    {
+        return mTransforms.size();
+    }
+};
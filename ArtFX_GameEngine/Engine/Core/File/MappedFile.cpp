@@ -0,0 +1,119 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Implementation of the MappedFile class, a read-only file mapped in memory.
+ */
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Debug/Log.h"
+
+/**
+ * @brief Unmaps the file.
+ */
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+/**
+ * @brief Maps a file, closing the one already open.
+ * @param pFilePath Path to the file.
+ * @return True if the file was mapped. Empty files cannot be mapped.
+ */
+bool MappedFile::Open(const std::string& pFilePath)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(pFilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        Log::Error(LogType::Application, "Could not open file " + pFilePath);
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        Log::Error(LogType::Application, "File " + pFilePath + " is empty");
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!data)
+    {
+        Log::Error(LogType::Application, "Could not map file " + pFilePath);
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    mFileHandle = file;
+    mMappingHandle = mapping;
+    mSize = static_cast<size_t>(size.QuadPart);
+#else
+    int file = open(pFilePath.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        Log::Error(LogType::Application, "Could not open file " + pFilePath);
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size == 0)
+    {
+        Log::Error(LogType::Application, "File " + pFilePath + " is empty");
+        close(file);
+        return false;
+    }
+
+    // The mapping stays valid once the descriptor is closed
+    void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED)
+    {
+        Log::Error(LogType::Application, "Could not map file " + pFilePath);
+        return false;
+    }
+
+    mSize = static_cast<size_t>(status.st_size);
+#endif
+
+    mData = static_cast<const unsigned char*>(data);
+    return true;
+}
+
+/**
+ * @brief Unmaps the file.
+ */
+void MappedFile::Close()
+{
+    if (!mData) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(mData);
+    CloseHandle(mMappingHandle);
+    CloseHandle(mFileHandle);
+    mMappingHandle = nullptr;
+    mFileHandle = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(mData), mSize);
+#endif
+
+    mData = nullptr;
+    mSize = 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file MappedFile.h
+ * @brief Declaration of the MappedFile class, a read-only file mapped in memory.
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Maps a whole file in memory for reading, the pages are loaded by the system on first access.
+ */
+class MappedFile
+{
+private:
+    /**
+     * @brief Start of the mapped file, nullptr if no file is open.
+     */
+    const unsigned char* mData = nullptr;
+
+    /**
+     * @brief Size of the mapped file, in bytes.
+     */
+    size_t mSize = 0;
+
+#ifdef _WIN32
+    /**
+     * @brief Handle of the open file.
+     */
+    void* mFileHandle = nullptr;
+
+    /**
+     * @brief Handle of the file mapping.
+     */
+    void* mMappingHandle = nullptr;
+#endif
+
+public:
+    MappedFile() = default;
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Maps a file, closing the one already open.
+     * @param pFilePath Path to the file.
+     * @return True if the file was mapped. Empty files cannot be mapped.
+     */
+    bool Open(const std::string& pFilePath);
+
+    /**
+     * @brief Unmaps the file.
+     */
+    void Close();
+
+    /**
+     * @brief Gets the content of the file.
+     * @return Pointer to the first byte, nullptr if no file is open.
+     */
+    const unsigned char* GetData() const
+    {
+        return mData;
+    }
+
+    /**
+     * @brief Gets the size of the file.
+     * @return Size in bytes.
+     */
+    size_t GetSize() const
+    {
+        return mSize;
+    }
+
+    /**
+     * @brief Checks if a file is mapped.
+     * @return True if a file is open.
+     */
+    bool IsOpen() const
+    {
+        return mData != nullptr;
+    }
+};
@@ -1,4 +1,4 @@
-/**
+﻿/**
  * @file CollisionDetection.cpp
  * @brief Implementation of the CollisionDetection struct, providing static methods for 3D collision detection.
  */
@@ -10,6 +10,7 @@
 
 #include "PhysicConstants.h"
 #include "Component/BaseCollisionComponent.h"
+#include "Component/HeightfieldCollisionComponent.h"
 #include "Component/PolyCollisionComponent.h"
 #include "Component/SphereCollisionComponent.h"
 #include "Core/Class/Mesh/Mesh.h"
@@ -69,6 +70,22 @@ bool CollisionDetection::IsColliding(RigidbodyComponent* a, RigidbodyComponent*
         return IsCollidingPolygonSphere(b, a, contacts);
     }
 
+    if (aType == CollisionType::Heightfield && bType == CollisionType::Sphere) {
+        return IsCollidingHeightfieldSphere(a, b, contacts);
+    }
+
+    if (aType == CollisionType::Sphere && bType == CollisionType::Heightfield) {
+        return IsCollidingHeightfieldSphere(b, a, contacts);
+    }
+
+    if (aType == CollisionType::Heightfield && (bType == CollisionType::Box || bType == CollisionType::Mesh)) {
+        return IsCollidingHeightfieldPolygon(a, b, contacts);
+    }
+
+    if ((aType == CollisionType::Box || aType == CollisionType::Mesh) && bType == CollisionType::Heightfield) {
+        return IsCollidingHeightfieldPolygon(b, a, contacts);
+    }
+
     return false;
 }
 
@@ -678,3 +695,68 @@ void CollisionDetection::ComputeContactManifold(const std::vector<Vec3>& aVerts,
         }
     }
 }
+
+/**
+ * @brief Checks for collision between a heightfield and a sphere.
+ * @param heightfield Rigidbody representing the heightfield.
+ * @param sphere Rigidbody representing the sphere.
+ * @param contacts Output vector of contacts.
+ * @return True if colliding, false otherwise.
+ */
+bool CollisionDetection::IsCollidingHeightfieldSphere(RigidbodyComponent* heightfield, RigidbodyComponent* sphere, std::vector<Contact>& contacts)
+{
+    HeightfieldCollisionComponent* heightfieldComponent = dynamic_cast<HeightfieldCollisionComponent*>(heightfield->GetCollisionComponent());
+    SphereCollisionComponent* sphereComponent = dynamic_cast<SphereCollisionComponent*>(sphere->GetCollisionComponent());
+
+    Vec3 sphereCenter = sphere->GetLocation();
+    float sphereRadius = sphereComponent->GetRadius();
+
+    Vec3 point, normal;
+    float depth;
+    if (!heightfieldComponent->IntersectSphere(sphereCenter, sphereRadius, point, normal, depth)) {
+        return false;
+    }
+
+    Contact contact;
+    contact.a = heightfield;
+    contact.b = sphere;
+    contact.normal = normal;
+    contact.depth = depth;
+    contact.start = point;
+    contact.end = point - normal * depth;
+
+    contacts.push_back(contact);
+    return true;
+}
+
+/**
+ * @brief Checks for collision between a heightfield and the vertices of a box or polygonal mesh.
+ * @param heightfield Rigidbody representing the heightfield.
+ * @param polygon Rigidbody representing the box or polygonal mesh.
+ * @param contacts Output vector of contacts.
+ * @return True if colliding, false otherwise.
+ */
+bool CollisionDetection::IsCollidingHeightfieldPolygon(RigidbodyComponent* heightfield, RigidbodyComponent* polygon, std::vector<Contact>& contacts)
+{
+    HeightfieldCollisionComponent* heightfieldComponent = dynamic_cast<HeightfieldCollisionComponent*>(heightfield->GetCollisionComponent());
+    const std::vector<Vec3>& vertices = polygon->GetCollisionComponent()->GetVerticesInWorldSpace();
+
+    bool colliding = false;
+    for (const Vec3& vertex : vertices) {
+        Vec3 surfacePoint, normal;
+        float depth;
+        if (!heightfieldComponent->IntersectPoint(vertex, surfacePoint, normal, depth)) continue;
+
+        Contact contact;
+        contact.a = heightfield;
+        contact.b = polygon;
+        contact.normal = normal;
+        contact.depth = depth;
+        contact.start = surfacePoint;
+        contact.end = vertex;
+
+        contacts.push_back(contact);
+        colliding = true;
+    }
+    return colliding;
+}
@@ -1,4 +1,4 @@
-/**
+﻿/**
  * @file CollisionDetection.h
  * @brief Declaration of the CollisionDetection struct, providing static methods for 3D collision detection.
  */
@@ -55,6 +55,16 @@ public:
      */
     static bool IsCollidingPolygonSphere(RigidbodyComponent* polygon, RigidbodyComponent* sphere, std::vector<Contact>& contacts);
 
+    /**
+     * @brief Checks for collision between a heightfield and a sphere.
+     */
+    static bool IsCollidingHeightfieldSphere(RigidbodyComponent* heightfield, RigidbodyComponent* sphere, std::vector<Contact>& contacts);
+
+    /**
+     * @brief Checks for collision between a heightfield and the vertices of a box or polygonal mesh.
+     */
+    static bool IsCollidingHeightfieldPolygon(RigidbodyComponent* heightfield, RigidbodyComponent* polygon, std::vector<Contact>& contacts);
+
 private:
     /**
      * @brief Checks for overlap between two sets of vertices along a given axis.
@@ -8,6 +8,7 @@
 #include "Core/Class/Actor/Actor.h"
 #include "Core/Physic/PhysicEngine.h"
 #include "Core/Render/Component/MeshComponent.h"
+#include "Core/Render/Shader/ShaderCache.h"
 
 struct Vertex;
 
@@ -21,22 +22,40 @@ BaseCollisionComponent::BaseCollisionComponent(Actor* pOwner) : Component(pOwner
     RigidbodyComponent* rb = mOwner->GetComponent<RigidbodyComponent>();
     rb->SetCollisionComponent(this);
     PhysicInstance.AddRigidbody(rb);
-    Scene::ActiveScene->GetRenderer().AddCollision(this);
+
+    mDebugDraw = Scene::ActiveScene != nullptr;
+    if (mDebugDraw) Scene::ActiveScene->GetRenderer().AddCollision(this);
 }
 
 /**
- * @brief Destructor for BaseCollisionComponent. Unregisters from the renderer.
+ * @brief Destructor for BaseCollisionComponent. Unregisters from the renderer and the physics simulation.
  */
 BaseCollisionComponent::~BaseCollisionComponent()
 {
-    Scene::ActiveScene->GetRenderer().RemoveCollision(this);
+    RigidbodyComponent* rb = mOwner->GetComponent<RigidbodyComponent>();
+    if (rb && rb->GetCollisionComponent() == this)
+    {
+        if (rb->GetPhysicEngine()) rb->GetPhysicEngine()->RemoveRigidbody(rb);
+        rb->SetCollisionComponent(nullptr);
+    }
+    if (mDebugDraw && Scene::ActiveScene) Scene::ActiveScene->GetRenderer().RemoveCollision(this);
 };
 
+/**
+ * @brief Gets the shared collision program and picks the color of the shape.
+ */
+void BaseCollisionComponent::LoadDebugShader()
+{
+    mShaderProgram = ShaderCache::GetProgram({{"Collision.vert", ShaderType::VERTEX}, {"Collision.frag", ShaderType::FRAGMENT}});
+    mDebugColor = Vec3(0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX),
+                       0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX),
+                       0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX));
+}
+
 /**
  * @brief Draws the collision shape. To be overridden by derived classes.
- * @param viewProj The view-projection matrix.
  */
-void BaseCollisionComponent::Draw(Matrix4Row viewProj)
+void BaseCollisionComponent::Draw()
 {
     struct Box
     {
@@ -6,6 +6,7 @@
 #pragma once
 #include <vector>
 #include "Core/Class/Component/Component.h"
+#include "Core/Render/Shader/ShaderProgram.h"
 
 /**
  * @enum CollisionType
@@ -15,7 +16,8 @@ enum class CollisionType
 {
     Box,    /**< Axis-aligned bounding box collision. */
     Sphere, /**< Spherical collision. */
-    Mesh    /**< Mesh-based collision. */
+    Mesh,   /**< Mesh-based collision. */
+    Heightfield /**< Terrain displaced by a height texture. */
 };
 
 /**
@@ -24,11 +26,32 @@ enum class CollisionType
  */
 class BaseCollisionComponent : public Component
 {
+    COMPONENT_TYPE(BaseCollisionComponent, Component)
 protected:
     /**
      * @brief The type of collision shape.
      */
     CollisionType mCollisionType;
+
+    /**
+     * @brief Whether the shape is drawn by the renderer. False for components built without an active scene.
+     */
+    bool mDebugDraw = false;
+
+    /**
+     * @brief Program drawing the shape, owned by the ShaderCache and shared by every collision shape.
+     */
+    ShaderProgram* mShaderProgram = nullptr;
+
+    /**
+     * @brief Color of the shape, picked at random so overlapping shapes can be told apart.
+     */
+    Vec3 mDebugColor;
+
+    /**
+     * @brief Gets the shared collision program and picks the color of the shape.
+     */
+    void LoadDebugShader();
 public:
     /**
      * @brief Constructs a BaseCollisionComponent.
@@ -43,9 +66,25 @@ public:
 
     /**
      * @brief Draws the collision shape.
-     * @param viewProj The view-projection matrix.
      */
-    virtual void Draw(Matrix4Row viewProj);
+    virtual void Draw();
+
+    /**
+     * @brief Checks if the shape is registered in the renderer.
+     * @return True if the shape is drawn by the renderer.
+     */
+    bool IsInRenderer() const
+    {
+        return mDebugDraw;
+    }
+
+    /**
+     * @brief Marks the shape as removed from the renderer by a batch, so the destructor skips it.
+     */
+    void DetachFromRenderer()
+    {
+        mDebugDraw = false;
+    }
 
     /**
      * @brief Gets the type of collision shape.
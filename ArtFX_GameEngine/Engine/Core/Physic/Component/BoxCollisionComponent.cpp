@@ -19,15 +19,10 @@ BoxCollisionComponent::BoxCollisionComponent(Actor* owner) : BaseCollisionCompon
     MeshComponent* mesh = owner->GetComponent<MeshComponent>();
     mBoundingBox = mesh->GetMesh()->GetBoundingBox();
     mRadius = mesh->GetMesh()->GetRadius();
+    if (!mDebugDraw) return;
+
     GenerateBox();
-    mVertexShader.Load("Collision.vert", ShaderType::VERTEX);
-    mFragmentShader.Load("Collision.frag", ShaderType::FRAGMENT);
-    mShaderProgram.Compose({&mVertexShader, &mFragmentShader });
-    mShaderProgram.setVector3f("randomColor",
-        Vec3(0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX),
-             0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX),
-             0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX))
-    );
+    LoadDebugShader();
 }
 
 /**
@@ -39,15 +34,10 @@ BoxCollisionComponent::BoxCollisionComponent(Actor* owner, const Box box) : Base
 {
     mCollisionType = CollisionType::Box;
     mBoundingBox = box;                                                              
+    if (!mDebugDraw) return;
+
     GenerateBox();
-    mVertexShader.Load("Collision.vert", ShaderType::VERTEX);
-    mFragmentShader.Load("Collision.frag", ShaderType::FRAGMENT);
-    mShaderProgram.Compose({&mVertexShader, &mFragmentShader });
-    mShaderProgram.setVector3f("randomColor",
-        Vec3(0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX),
-             0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX),
-             0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX))
-    );
+    LoadDebugShader();
 }
 
 /**
@@ -57,17 +47,16 @@ BoxCollisionComponent::~BoxCollisionComponent() = default;
 
 /**
  * @brief Draws the box collision shape.
- * @param viewProj The view-projection matrix.
  */
-void BoxCollisionComponent::Draw(Matrix4Row viewProj)
+void BoxCollisionComponent::Draw()
 {
-    BaseCollisionComponent::Draw(viewProj);
+    BaseCollisionComponent::Draw();
 
     Matrix4Row wt = mOwner->GetWorldTransform();
     
-    mShaderProgram.Use();
-    mShaderProgram.setMatrix4Row("uViewProj", viewProj);
-    mShaderProgram.setMatrix4Row("uWorldTransform", wt);
+    mShaderProgram->Use();
+    mShaderProgram->setVector3f("randomColor", mDebugColor);
+    mShaderProgram->setMatrix4Row("uWorldTransform", wt);
 
     mVertexArray->SetActive();
     glDrawArrays(GL_TRIANGLES, 0, mVertexArray->GetVerticeCount());
@@ -80,7 +69,7 @@ void BoxCollisionComponent::Draw(Matrix4Row viewProj)
 void BoxCollisionComponent::SetBoundingBox(const Box& box)
 {
     mBoundingBox = box;
-    GenerateBox();
+    if (mDebugDraw) GenerateBox();
 }
 
 /**
@@ -119,16 +108,9 @@ void BoxCollisionComponent::GenerateBox()
         vertices.push_back(pos.x);
         vertices.push_back(pos.y);
         vertices.push_back(pos.z);
-        
-        vertices.push_back(0.0f);
-        vertices.push_back(0.0f);
-        vertices.push_back(0.0f);
-        
-        vertices.push_back(0.0f);
-        vertices.push_back(0.0f);
     }
 
-    mVertexArray = new VertexArray(vertices.data(), static_cast<unsigned int>(vertices.size() / 8));
+    mVertexArray = new VertexArray(vertices.data(), static_cast<unsigned int>(vertices.size() / 3), VertexLayout::PositionOnly());
 }
 
 /**
@@ -13,6 +13,8 @@
  */
 class BoxCollisionComponent : public BaseCollisionComponent
 {
+    COMPONENT_TYPE(BoxCollisionComponent, BaseCollisionComponent)
+    POOLED_COMPONENT(BoxCollisionComponent)
 protected:
     /**
      * @brief The bounding box for collision.
@@ -27,17 +29,7 @@ protected:
     /**
      * @brief Vertex array for rendering the box.
      */
-    VertexArray* mVertexArray;
-
-    /**
-     * @brief Shader program for rendering.
-     */
-    ShaderProgram mShaderProgram;
-
-    /**
-     * @brief Vertex and fragment shaders.
-     */
-    Shader mVertexShader, mFragmentShader;
+    VertexArray* mVertexArray = nullptr;
 public:
     /**
      * @brief Constructs a BoxCollisionComponent using the owner's mesh bounding box.
@@ -59,9 +51,8 @@ public:
 
     /**
      * @brief Draws the box collision shape.
-     * @param viewProj The view-projection matrix.
      */
-    void Draw(Matrix4Row viewProj) override;
+    void Draw() override;
 
     /**
      * @brief Sets the bounding box for the collision component.
@@ -0,0 +1,74 @@
+/**
+ * @file BuoyancyComponent.cpp
+ * @brief Implementation of the BuoyancyComponent class, making a rigidbody float in a WaterVolumeComponent.
+ */
+
+#include "BuoyancyComponent.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "RigidbodyComponent.h"
+#include "WaterVolumeComponent.h"
+#include "Core/Class/Actor/Actor.h"
+#include "Core/Render/Component/MeshComponent.h"
+#include "Debug/Log.h"
+
+/**
+ * @brief Constructs a BuoyancyComponent and registers it in the water volume.
+ * @param pOwner Pointer to the owning Actor, which must have a MeshComponent and a RigidbodyComponent.
+ * @param pWater The water volume the body floats in.
+ */
+BuoyancyComponent::BuoyancyComponent(Actor* pOwner, WaterVolumeComponent* pWater) : Component(pOwner), mWater(pWater)
+{
+    mRigidbody = mOwner->GetComponent<RigidbodyComponent>();
+    MeshComponent* meshComponent = mOwner->GetComponent<MeshComponent>();
+    if (!mRigidbody || !meshComponent || !meshComponent->GetMesh())
+    {
+        Log::Error(LogType::Error, "BuoyancyComponent requires a RigidbodyComponent and a MeshComponent with a mesh");
+    }
+    else
+    {
+        Box bounds = meshComponent->GetMesh()->GetBoundingBox();
+        Vec3 center = (bounds.min + bounds.max) * 0.5f;
+        Vec3 quarterSize = (bounds.max - bounds.min) * 0.25f;
+        for (int i = 0; i < BUOYANCY_MAX_SAMPLES; i++)
+        {
+            mSamples[i] = Vec3(center.x + (i & 1 ? quarterSize.x : -quarterSize.x),
+                               center.y + (i & 2 ? quarterSize.y : -quarterSize.y),
+                               center.z + (i & 4 ? quarterSize.z : -quarterSize.z));
+        }
+        mSampleCount = BUOYANCY_MAX_SAMPLES;
+        mSampleRadius = std::max({ quarterSize.x, quarterSize.y, quarterSize.z });
+    }
+
+    if (mWater) mWater->AddBody(this);
+}
+
+/**
+ * @brief Destructor. Unregisters the body from its water volume.
+ */
+BuoyancyComponent::~BuoyancyComponent()
+{
+    if (mWater) mWater->RemoveBody(this);
+}
+
+/**
+ * @brief Gets a sample point in world space.
+ * @param pIndex Index of the sample.
+ * @return The sample point in world space.
+ */
+Vec3 BuoyancyComponent::GetSampleInWorldSpace(int pIndex) const
+{
+    return mOwner->GetRotation() * (mSamples[pIndex] * mOwner->GetScale()) + mOwner->GetLocation();
+}
+
+/**
+ * @brief Gets the half height of the slice of body covered by a sample.
+ * @return The radius in world space.
+ */
+float BuoyancyComponent::GetSampleRadius() const
+{
+    Vec3 scale = mOwner->GetScale();
+    return mSampleRadius * std::max({ fabs(scale.x), fabs(scale.y), fabs(scale.z) });
+}
@@ -0,0 +1,152 @@
+/**
+ * @file BuoyancyComponent.h
+ * @brief Declaration of the BuoyancyComponent class, making a rigidbody float in a WaterVolumeComponent.
+ */
+
+#pragma once
+#include "Core/Class/Component/Component.h"
+#include "Math/Vec3.h"
+
+class RigidbodyComponent;
+class WaterVolumeComponent;
+
+/**
+ * @brief Maximum number of points sampled against the water for a single body.
+ */
+const int BUOYANCY_MAX_SAMPLES = 8;
+
+/**
+ * @class BuoyancyComponent
+ * @brief Makes the owner's rigidbody float in a water volume.
+ *
+ * The body is approximated by the eight corners of its mesh bounds pulled halfway toward the center,
+ * each one standing for an eighth of the body. The water evaluates them with every other body of the
+ * frame and pushes each submerged point along the water up axis.
+ */
+class BuoyancyComponent : public Component
+{
+    COMPONENT_TYPE(BuoyancyComponent, Component)
+private:
+    /**
+     * @brief The water volume the body floats in.
+     */
+    WaterVolumeComponent* mWater = nullptr;
+
+    /**
+     * @brief The rigidbody receiving the forces.
+     */
+    RigidbodyComponent* mRigidbody = nullptr;
+
+    /**
+     * @brief Sample points in mesh space.
+     */
+    Vec3 mSamples[BUOYANCY_MAX_SAMPLES];
+
+    /**
+     * @brief Number of sample points.
+     */
+    int mSampleCount = 0;
+
+    /**
+     * @brief Half height of the slice of body covered by a sample, before scaling.
+     */
+    float mSampleRadius = 1.0f;
+
+    /**
+     * @brief Buoyancy of the fully submerged body, as a ratio of its weight. Above 1 the body floats.
+     */
+    float mBuoyancy = 1.5f;
+
+    /**
+     * @brief Linear drag applied to the submerged points, per second.
+     */
+    float mDrag = 1.0f;
+
+public:
+    /**
+     * @brief Constructs a BuoyancyComponent and registers it in the water volume.
+     * @param pOwner Pointer to the owning Actor, which must have a MeshComponent and a RigidbodyComponent.
+     * @param pWater The water volume the body floats in.
+     */
+    BuoyancyComponent(Actor* pOwner, WaterVolumeComponent* pWater);
+
+    /**
+     * @brief Destructor. Unregisters the body from its water volume.
+     */
+    ~BuoyancyComponent() override;
+
+    /**
+     * @brief Detaches the body from its water volume without unregistering it.
+     */
+    void DetachWater()
+    {
+        mWater = nullptr;
+    }
+
+    /**
+     * @brief Gets the rigidbody receiving the forces.
+     * @return Pointer to the rigidbody, or nullptr if the owner has none.
+     */
+    RigidbodyComponent* GetRigidbody() const
+    {
+        return mRigidbody;
+    }
+
+    /**
+     * @brief Gets the number of sample points.
+     * @return The number of samples.
+     */
+    int GetSampleCount() const
+    {
+        return mSampleCount;
+    }
+
+    /**
+     * @brief Gets a sample point in world space.
+     * @param pIndex Index of the sample.
+     * @return The sample point in world space.
+     */
+    Vec3 GetSampleInWorldSpace(int pIndex) const;
+
+    /**
+     * @brief Gets the half height of the slice of body covered by a sample.
+     * @return The radius in world space.
+     */
+    float GetSampleRadius() const;
+
+    /**
+     * @brief Sets the buoyancy of the fully submerged body.
+     * @param pBuoyancy Ratio of the body weight. Above 1 the body floats.
+     */
+    void SetBuoyancy(float pBuoyancy)
+    {
+        mBuoyancy = pBuoyancy;
+    }
+
+    /**
+     * @brief Gets the buoyancy of the fully submerged body.
+     * @return Ratio of the body weight.
+     */
+    float GetBuoyancy() const
+    {
+        return mBuoyancy;
+    }
+
+    /**
+     * @brief Sets the linear drag applied to the submerged points.
+     * @param pDrag Drag per second.
+     */
+    void SetDrag(float pDrag)
+    {
+        mDrag = pDrag;
+    }
+
+    /**
+     * @brief Gets the linear drag applied to the submerged points.
+     * @return Drag per second.
+     */
+    float GetDrag() const
+    {
+        return mDrag;
+    }
+};
@@ -0,0 +1,546 @@
+/**
+ * @file HeightfieldCollisionComponent.cpp
+ * @brief Implementation of the HeightfieldCollisionComponent class, representing terrain displaced by a noise texture.
+ */
+
+#include "HeightfieldCollisionComponent.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Core/Class/Actor/Actor.h"
+#include "Core/Physic/PhysicConstants.h"
+#include "Core/Render/HeightMap.h"
+#include "Core/Render/Texture.h"
+#include "Core/Render/Component/MeshComponent.h"
+#include "Debug/Log.h"
+
+/**
+ * @brief Gets the closest point of a triangle to a point (Ericson, Real-Time Collision Detection 5.1.5).
+ * @param p The point.
+ * @param a First vertex of the triangle.
+ * @param b Second vertex of the triangle.
+ * @param c Third vertex of the triangle.
+ * @return The closest point on the triangle.
+ */
+static Vec3 ClosestPointOnTriangle(const Vec3& p, const Vec3& a, const Vec3& b, const Vec3& c)
+{
+    Vec3 ab = b - a;
+    Vec3 ac = c - a;
+    Vec3 ap = p - a;
+    float d1 = Vec3::Dot(ab, ap);
+    float d2 = Vec3::Dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+    Vec3 bp = p - b;
+    float d3 = Vec3::Dot(ab, bp);
+    float d4 = Vec3::Dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+
+    Vec3 cp = p - c;
+    float d5 = Vec3::Dot(ab, cp);
+    float d6 = Vec3::Dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+    {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    float denominator = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denominator) + ac * (vc * denominator);
+}
+
+/**
+ * @brief Intersects a segment with a triangle (Moller-Trumbore, both faces).
+ * @param origin Start of the segment.
+ * @param direction Vector from the start to the end of the segment.
+ * @param a First vertex of the triangle.
+ * @param b Second vertex of the triangle.
+ * @param c Third vertex of the triangle.
+ * @param outT Output parameter of the hit along the segment, in [0, 1].
+ * @return True if the segment crosses the triangle.
+ */
+static bool SegmentIntersectsTriangle(const Vec3& origin, const Vec3& direction, const Vec3& a, const Vec3& b, const Vec3& c, float& outT)
+{
+    Vec3 ab = b - a;
+    Vec3 ac = c - a;
+    Vec3 p = Vec3::Cross(direction, ac);
+    float determinant = Vec3::Dot(ab, p);
+    if (fabs(determinant) < EPSILON) return false;
+
+    float inverseDeterminant = 1.0f / determinant;
+    Vec3 s = origin - a;
+    float u = Vec3::Dot(s, p) * inverseDeterminant;
+    if (u < 0.0f || u > 1.0f) return false;
+
+    Vec3 q = Vec3::Cross(s, ab);
+    float v = Vec3::Dot(direction, q) * inverseDeterminant;
+    if (v < 0.0f || u + v > 1.0f) return false;
+
+    float t = Vec3::Dot(ac, q) * inverseDeterminant;
+    if (t < 0.0f || t > 1.0f) return false;
+
+    outT = t;
+    return true;
+}
+
+/**
+ * @brief Gets the upward facing normal of a triangle.
+ * @param a First vertex of the triangle.
+ * @param b Second vertex of the triangle.
+ * @param c Third vertex of the triangle.
+ * @return The normalized normal, with a positive Y component.
+ */
+static Vec3 GetUpwardNormal(const Vec3& a, const Vec3& b, const Vec3& c)
+{
+    Vec3 normal = Vec3::Normalize(Vec3::Cross(c - a, b - a));
+    if (normal.y < 0.0f) normal *= -1.0f;
+    return normal;
+}
+
+/**
+ * @brief Constructs a HeightfieldCollisionComponent from the owner's mesh.
+ * @param pOwner Pointer to the owning Actor, which must have a MeshComponent.
+ * @param pNoiseTexture Noise texture used by the tessellation shader.
+ * @param pDisplacementScale Displacement scale used by the tessellation shader.
+ * @param pResolution Number of cells along the longest side of the terrain.
+ */
+HeightfieldCollisionComponent::HeightfieldCollisionComponent(Actor* pOwner, const Texture& pNoiseTexture, float pDisplacementScale, int pResolution) : BaseCollisionComponent(pOwner)
+{
+    mCollisionType = CollisionType::Heightfield;
+    Build(pNoiseTexture, pDisplacementScale, std::max(1, pResolution));
+}
+
+/**
+ * @brief Builds the height grid from the owner's mesh and the noise texture.
+ * The topmost triangle of the mesh under each sample gives its base height and texture coordinates,
+ * then the noise is sampled exactly like SimpleTess.tese does.
+ * @param pNoiseTexture Noise texture used to displace the mesh.
+ * @param pDisplacementScale Height of the displacement for a full intensity texel.
+ * @param pResolution Number of cells along the longest side of the terrain.
+ */
+void HeightfieldCollisionComponent::Build(const Texture& pNoiseTexture, float pDisplacementScale, int pResolution)
+{
+    MeshComponent* meshComponent = mOwner->GetComponent<MeshComponent>();
+    if (!meshComponent || !meshComponent->GetMesh())
+    {
+        Log::Error(LogType::Error, "HeightfieldCollisionComponent requires a MeshComponent with a mesh");
+        return;
+    }
+
+    const Mesh* mesh = meshComponent->GetMesh();
+    Box bounds = mesh->GetBoundingBox();
+    float sizeX = bounds.max.x - bounds.min.x;
+    float sizeZ = bounds.max.z - bounds.min.z;
+    float longestSide = std::max(sizeX, sizeZ);
+    if (longestSide <= 0.0f) return;
+
+    float cellSize = longestSide / static_cast<float>(pResolution);
+    mColumns = std::max(1, static_cast<int>(ceilf(sizeX / cellSize)));
+    mRows = std::max(1, static_cast<int>(ceilf(sizeZ / cellSize)));
+    mCellSizeX = sizeX > 0.0f ? sizeX / static_cast<float>(mColumns) : cellSize;
+    mCellSizeZ = sizeZ > 0.0f ? sizeZ / static_cast<float>(mRows) : cellSize;
+    mOriginX = bounds.min.x;
+    mOriginZ = bounds.min.z;
+
+    size_t sampleCount = static_cast<size_t>(mColumns + 1) * (mRows + 1);
+    std::vector<float> baseHeights(sampleCount, std::numeric_limits<float>::lowest());
+    std::vector<Vec2> texCoords(sampleCount);
+
+    const std::vector<Vertex>& vertices = mesh->GetVertices();
+    const std::vector<unsigned int>& indices = mesh->GetIndices();
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        const Vertex& v0 = vertices[indices[i]];
+        const Vertex& v1 = vertices[indices[i + 1]];
+        const Vertex& v2 = vertices[indices[i + 2]];
+        Vec3 e1 = v1.position - v0.position;
+        Vec3 e2 = v2.position - v0.position;
+        float determinant = e1.x * e2.z - e2.x * e1.z;
+        if (fabs(determinant) < EPSILON) continue;
+
+        float minX = std::min({ v0.position.x, v1.position.x, v2.position.x });
+        float maxX = std::max({ v0.position.x, v1.position.x, v2.position.x });
+        float minZ = std::min({ v0.position.z, v1.position.z, v2.position.z });
+        float maxZ = std::max({ v0.position.z, v1.position.z, v2.position.z });
+        int firstColumn = std::max(0, static_cast<int>(ceilf((minX - mOriginX) / mCellSizeX)));
+        int lastColumn = std::min(mColumns, static_cast<int>(floorf((maxX - mOriginX) / mCellSizeX)));
+        int firstRow = std::max(0, static_cast<int>(ceilf((minZ - mOriginZ) / mCellSizeZ)));
+        int lastRow = std::min(mRows, static_cast<int>(floorf((maxZ - mOriginZ) / mCellSizeZ)));
+
+        for (int row = firstRow; row <= lastRow; row++)
+        {
+            for (int column = firstColumn; column <= lastColumn; column++)
+            {
+                float dx = mOriginX + column * mCellSizeX - v0.position.x;
+                float dz = mOriginZ + row * mCellSizeZ - v0.position.z;
+                float w1 = (dx * e2.z - e2.x * dz) / determinant;
+                float w2 = (e1.x * dz - dx * e1.z) / determinant;
+                float w0 = 1.0f - w1 - w2;
+                if (w0 < -1e-4f || w1 < -1e-4f || w2 < -1e-4f) continue;
+
+                float height = v0.position.y * w0 + v1.position.y * w1 + v2.position.y * w2;
+                size_t index = static_cast<size_t>(row) * (mColumns + 1) + column;
+                if (height <= baseHeights[index]) continue;
+
+                baseHeights[index] = height;
+                texCoords[index] = Vec2(v0.texCoord.x * w0 + v1.texCoord.x * w1 + v2.texCoord.x * w2,
+                                        v0.texCoord.y * w0 + v1.texCoord.y * w1 + v2.texCoord.y * w2);
+            }
+        }
+    }
+
+    HeightMap noise;
+    noise.Load(pNoiseTexture.GetFilePath());
+    Vec2 tiling = meshComponent->GetTiling();
+    float tilingX = tiling.x * HEIGHTFIELD_NOISE_TILING;
+    float tilingY = tiling.y * HEIGHTFIELD_NOISE_TILING;
+
+    mHeights.resize(sampleCount);
+    mMinHeight = std::numeric_limits<float>::max();
+    mMaxHeight = std::numeric_limits<float>::lowest();
+    for (size_t i = 0; i < sampleCount; i++)
+    {
+        if (baseHeights[i] == std::numeric_limits<float>::lowest())
+        {
+            mHeights[i] = bounds.min.y;
+        }
+        else
+        {
+            mHeights[i] = baseHeights[i] + noise.Sample(texCoords[i].x * tilingX, texCoords[i].y * tilingY) * pDisplacementScale;
+        }
+        mMinHeight = std::min(mMinHeight, mHeights[i]);
+        mMaxHeight = std::max(mMaxHeight, mHeights[i]);
+    }
+
+    Log::Info("Heightfield built with " + std::to_string(mColumns) + "x" + std::to_string(mRows) + " cells");
+}
+
+/**
+ * @brief Gets the two triangles of a cell in mesh space.
+ * @param pColumn Column of the cell.
+ * @param pRow Row of the cell.
+ * @param pTriangles Output array of six vertices.
+ */
+void HeightfieldCollisionComponent::GetCellTriangles(int pColumn, int pRow, Vec3 pTriangles[6]) const
+{
+    float x0 = mOriginX + pColumn * mCellSizeX;
+    float z0 = mOriginZ + pRow * mCellSizeZ;
+    Vec3 p00(x0, GetSample(pColumn, pRow), z0);
+    Vec3 p10(x0 + mCellSizeX, GetSample(pColumn + 1, pRow), z0);
+    Vec3 p01(x0, GetSample(pColumn, pRow + 1), z0 + mCellSizeZ);
+    Vec3 p11(x0 + mCellSizeX, GetSample(pColumn + 1, pRow + 1), z0 + mCellSizeZ);
+
+    pTriangles[0] = p00;
+    pTriangles[1] = p10;
+    pTriangles[2] = p11;
+    pTriangles[3] = p00;
+    pTriangles[4] = p11;
+    pTriangles[5] = p01;
+}
+
+/**
+ * @brief Converts a point from world space to mesh space.
+ * @param pPoint The point in world space.
+ * @return The point in mesh space.
+ */
+Vec3 HeightfieldCollisionComponent::WorldToLocal(const Vec3& pPoint) const
+{
+    Vec3 scale = mOwner->GetScale();
+    Vec3 local = mOwner->GetRotation().Inverse() * (pPoint - mOwner->GetLocation());
+    return Vec3(local.x / scale.x, local.y / scale.y, local.z / scale.z);
+}
+
+/**
+ * @brief Converts a point from mesh space to world space.
+ * @param pPoint The point in mesh space.
+ * @return The point in world space.
+ */
+Vec3 HeightfieldCollisionComponent::LocalToWorld(const Vec3& pPoint) const
+{
+    return mOwner->GetRotation() * (pPoint * mOwner->GetScale()) + mOwner->GetLocation();
+}
+
+/**
+ * @brief Converts a normal from mesh space to world space.
+ * @param pNormal The normal in mesh space.
+ * @return The normalized normal in world space.
+ */
+Vec3 HeightfieldCollisionComponent::LocalNormalToWorld(const Vec3& pNormal) const
+{
+    Vec3 scale = mOwner->GetScale();
+    return Vec3::Normalize(mOwner->GetRotation() * Vec3(pNormal.x / scale.x, pNormal.y / scale.y, pNormal.z / scale.z));
+}
+
+/**
+ * @brief Gets the height of the terrain in mesh space.
+ * @param pX X coordinate in mesh space.
+ * @param pZ Z coordinate in mesh space.
+ * @param pOutNormal Output surface normal in mesh space.
+ * @return The height, or the lowest sample outside of the grid.
+ */
+float HeightfieldCollisionComponent::GetHeight(float pX, float pZ, Vec3& pOutNormal) const
+{
+    pOutNormal = Vec3::unitY;
+    if (mHeights.empty()) return 0.0f;
+
+    float gridX = (pX - mOriginX) / mCellSizeX;
+    float gridZ = (pZ - mOriginZ) / mCellSizeZ;
+    if (gridX < 0.0f || gridZ < 0.0f || gridX > mColumns || gridZ > mRows) return mMinHeight;
+
+    int column = std::min(static_cast<int>(gridX), mColumns - 1);
+    int row = std::min(static_cast<int>(gridZ), mRows - 1);
+    float tx = gridX - column;
+    float tz = gridZ - row;
+
+    float h00 = GetSample(column, row);
+    float h10 = GetSample(column + 1, row);
+    float h01 = GetSample(column, row + 1);
+    float h11 = GetSample(column + 1, row + 1);
+
+    float slopeX, slopeZ;
+    if (tx >= tz)
+    {
+        slopeX = h10 - h00;
+        slopeZ = h11 - h10;
+    }
+    else
+    {
+        slopeX = h11 - h01;
+        slopeZ = h01 - h00;
+    }
+
+    pOutNormal = Vec3::Normalize(Vec3(-slopeX / mCellSizeX, 1.0f, -slopeZ / mCellSizeZ));
+    return h00 + slopeX * tx + slopeZ * tz;
+}
+
+/**
+ * @brief Finds the deepest contact between the terrain and a sphere.
+ * @param pCenter Center of the sphere in world space.
+ * @param pRadius Radius of the sphere.
+ * @param pOutPoint Output contact point on the terrain, in world space.
+ * @param pOutNormal Output contact normal pointing out of the terrain, in world space.
+ * @param pOutDepth Output penetration depth.
+ * @return True if the sphere touches the terrain.
+ */
+bool HeightfieldCollisionComponent::IntersectSphere(const Vec3& pCenter, float pRadius, Vec3& pOutPoint, Vec3& pOutNormal, float& pOutDepth) const
+{
+    if (mHeights.empty()) return false;
+
+    Vec3 scale = mOwner->GetScale();
+    float scaleFactor = std::min({ fabs(scale.x), fabs(scale.y), fabs(scale.z) });
+    if (scaleFactor < EPSILON) return false;
+
+    Vec3 center = WorldToLocal(pCenter);
+    float radius = pRadius / scaleFactor;
+    if (center.y - radius > mMaxHeight) return false;
+
+    int firstColumn = static_cast<int>(floorf((center.x - radius - mOriginX) / mCellSizeX));
+    int lastColumn = static_cast<int>(floorf((center.x + radius - mOriginX) / mCellSizeX));
+    int firstRow = static_cast<int>(floorf((center.z - radius - mOriginZ) / mCellSizeZ));
+    int lastRow = static_cast<int>(floorf((center.z + radius - mOriginZ) / mCellSizeZ));
+    if (lastColumn < 0 || lastRow < 0 || firstColumn >= mColumns || firstRow >= mRows) return false;
+
+    firstColumn = std::max(firstColumn, 0);
+    firstRow = std::max(firstRow, 0);
+    lastColumn = std::min(lastColumn, mColumns - 1);
+    lastRow = std::min(lastRow, mRows - 1);
+
+    Vec3 point;
+    Vec3 normal;
+    float depth;
+
+    Vec3 surfaceNormal;
+    float surfaceHeight = GetHeight(center.x, center.z, surfaceNormal);
+    bool centerAboveGrid = center.x >= mOriginX && center.z >= mOriginZ &&
+                           center.x <= mOriginX + mColumns * mCellSizeX && center.z <= mOriginZ + mRows * mCellSizeZ;
+
+    if (centerAboveGrid && center.y < surfaceHeight)
+    {
+        // The center went through the surface, push it back along the surface normal
+        float distanceToSurface = (surfaceHeight - center.y) * surfaceNormal.y;
+        point = center + surfaceNormal * distanceToSurface;
+        normal = surfaceNormal;
+        depth = radius + distanceToSurface;
+    }
+    else
+    {
+        float closestDistanceSquared = radius * radius;
+        bool found = false;
+        Vec3 triangles[6];
+        for (int row = firstRow; row <= lastRow; row++)
+        {
+            for (int column = firstColumn; column <= lastColumn; column++)
+            {
+                GetCellTriangles(column, row, triangles);
+                for (int i = 0; i < 6; i += 3)
+                {
+                    Vec3 closest = ClosestPointOnTriangle(center, triangles[i], triangles[i + 1], triangles[i + 2]);
+                    float distanceSquared = (center - closest).LengthSq();
+                    if (distanceSquared >= closestDistanceSquared) continue;
+
+                    closestDistanceSquared = distanceSquared;
+                    point = closest;
+                    normal = distanceSquared > EPSILON
+                        ? (center - closest) / sqrtf(distanceSquared)
+                        : GetUpwardNormal(triangles[i], triangles[i + 1], triangles[i + 2]);
+                    found = true;
+                }
+            }
+        }
+        if (!found) return false;
+        depth = radius - sqrtf(closestDistanceSquared);
+    }
+
+    pOutPoint = LocalToWorld(point);
+    pOutNormal = LocalNormalToWorld(normal);
+    pOutDepth = depth * scaleFactor;
+    return true;
+}
+
+/**
+ * @brief Tests a point against the terrain.
+ * @param pPoint The point in world space.
+ * @param pOutSurfacePoint Output point of the terrain surface above the point, in world space.
+ * @param pOutNormal Output surface normal, in world space.
+ * @param pOutDepth Output penetration depth.
+ * @return True if the point is below the terrain surface.
+ */
+bool HeightfieldCollisionComponent::IntersectPoint(const Vec3& pPoint, Vec3& pOutSurfacePoint, Vec3& pOutNormal, float& pOutDepth) const
+{
+    if (mHeights.empty()) return false;
+
+    Vec3 local = WorldToLocal(pPoint);
+    if (local.y >= mMaxHeight) return false;
+    if (local.x < mOriginX || local.z < mOriginZ ||
+        local.x > mOriginX + mColumns * mCellSizeX || local.z > mOriginZ + mRows * mCellSizeZ) return false;
+
+    Vec3 normal;
+    float height = GetHeight(local.x, local.z, normal);
+    if (local.y >= height) return false;
+
+    Vec3 surfacePoint = local + normal * ((height - local.y) * normal.y);
+    pOutSurfacePoint = LocalToWorld(surfacePoint);
+    pOutNormal = LocalNormalToWorld(normal);
+    pOutDepth = (pOutSurfacePoint - pPoint).Length();
+    return true;
+}
+
+/**
+ * @brief Casts a ray against the terrain, walking only the cells crossed by the ray.
+ * @param pOrigin Origin of the ray in world space.
+ * @param pDirection Normalized direction of the ray in world space.
+ * @param pMaxDistance Maximum distance of the ray.
+ * @param pOutDistance Output distance of the hit along the ray.
+ * @param pOutNormal Output surface normal at the hit, in world space.
+ * @return True if the ray hits the terrain.
+ */
+bool HeightfieldCollisionComponent::Raycast(const Vec3& pOrigin, const Vec3& pDirection, float pMaxDistance, float& pOutDistance, Vec3& pOutNormal) const
+{
+    if (mHeights.empty() || pMaxDistance <= 0.0f) return false;
+
+    Vec3 start = WorldToLocal(pOrigin);
+    Vec3 segment = WorldToLocal(pOrigin + pDirection * pMaxDistance) - start;
+    if (std::min(start.y, start.y + segment.y) > mMaxHeight) return false;
+
+    // Clip the segment to the grid footprint
+    float tEnter = 0.0f;
+    float tExit = 1.0f;
+    auto clipAxis = [&](float origin, float delta, float minBound, float maxBound) -> bool
+    {
+        if (fabs(delta) < EPSILON) return origin >= minBound && origin <= maxBound;
+        float t1 = (minBound - origin) / delta;
+        float t2 = (maxBound - origin) / delta;
+        if (t1 > t2) std::swap(t1, t2);
+        tEnter = std::max(tEnter, t1);
+        tExit = std::min(tExit, t2);
+        return tEnter <= tExit;
+    };
+    if (!clipAxis(start.x, segment.x, mOriginX, mOriginX + mColumns * mCellSizeX)) return false;
+    if (!clipAxis(start.z, segment.z, mOriginZ, mOriginZ + mRows * mCellSizeZ)) return false;
+
+    // Walk the cells crossed by the segment in order (Amanatides & Woo)
+    float entryX = start.x + segment.x * tEnter;
+    float entryZ = start.z + segment.z * tEnter;
+    int column = std::clamp(static_cast<int>(floorf((entryX - mOriginX) / mCellSizeX)), 0, mColumns - 1);
+    int row = std::clamp(static_cast<int>(floorf((entryZ - mOriginZ) / mCellSizeZ)), 0, mRows - 1);
+
+    const float infinity = std::numeric_limits<float>::max();
+    int stepX = segment.x > 0.0f ? 1 : -1;
+    int stepZ = segment.z > 0.0f ? 1 : -1;
+    float deltaX = fabs(segment.x) > EPSILON ? mCellSizeX / fabs(segment.x) : infinity;
+    float deltaZ = fabs(segment.z) > EPSILON ? mCellSizeZ / fabs(segment.z) : infinity;
+    float nextX = fabs(segment.x) > EPSILON
+        ? (mOriginX + (column + (stepX > 0 ? 1 : 0)) * mCellSizeX - start.x) / segment.x
+        : infinity;
+    float nextZ = fabs(segment.z) > EPSILON
+        ? (mOriginZ + (row + (stepZ > 0 ? 1 : 0)) * mCellSizeZ - start.z) / segment.z
+        : infinity;
+
+    Vec3 triangles[6];
+    while (true)
+    {
+        float bestT = infinity;
+        Vec3 bestNormal;
+        GetCellTriangles(column, row, triangles);
+        for (int i = 0; i < 6; i += 3)
+        {
+            float t;
+            if (SegmentIntersectsTriangle(start, segment, triangles[i], triangles[i + 1], triangles[i + 2], t) && t < bestT)
+            {
+                bestT = t;
+                bestNormal = GetUpwardNormal(triangles[i], triangles[i + 1], triangles[i + 2]);
+            }
+        }
+        if (bestT != infinity)
+        {
+            pOutDistance = bestT * pMaxDistance;
+            pOutNormal = LocalNormalToWorld(bestNormal);
+            return true;
+        }
+
+        if (nextX < nextZ)
+        {
+            if (nextX > tExit) break;
+            column += stepX;
+            nextX += deltaX;
+        }
+        else
+        {
+            if (nextZ > tExit) break;
+            row += stepZ;
+            nextZ += deltaZ;
+        }
+        if (column < 0 || row < 0 || column >= mColumns || row >= mRows) break;
+    }
+    return false;
+}
+
+/**
+ * @brief Gets the corners of the terrain bounds in world space.
+ * @return Vector of the 8 corners.
+ */
+std::vector<Vec3> HeightfieldCollisionComponent::GetVerticesInWorldSpace() const
+{
+    float maxX = mOriginX + mColumns * mCellSizeX;
+    float maxZ = mOriginZ + mRows * mCellSizeZ;
+    return {
+        LocalToWorld(Vec3(mOriginX, mMinHeight, mOriginZ)),
+        LocalToWorld(Vec3(maxX, mMinHeight, mOriginZ)),
+        LocalToWorld(Vec3(maxX, mMaxHeight, mOriginZ)),
+        LocalToWorld(Vec3(mOriginX, mMaxHeight, mOriginZ)),
+        LocalToWorld(Vec3(mOriginX, mMinHeight, maxZ)),
+        LocalToWorld(Vec3(maxX, mMinHeight, maxZ)),
+        LocalToWorld(Vec3(maxX, mMaxHeight, maxZ)),
+        LocalToWorld(Vec3(mOriginX, mMaxHeight, maxZ))
+    };
+}
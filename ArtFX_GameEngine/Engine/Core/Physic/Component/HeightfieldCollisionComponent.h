@@ -0,0 +1,184 @@
+/**
+ * @file HeightfieldCollisionComponent.h
+ * @brief Declaration of the HeightfieldCollisionComponent class, representing terrain displaced by a noise texture.
+ */
+
+#pragma once
+#include <vector>
+#include "BaseCollisionComponent.h"
+#include "Math/Quaternion.h"
+
+class Texture;
+
+/**
+ * @brief Tiling applied by SimpleTess.tese on top of the mesh tiling when sampling the noise texture.
+ */
+const float HEIGHTFIELD_NOISE_TILING = 10.0f;
+
+/**
+ * @class HeightfieldCollisionComponent
+ * @brief Collision component for terrain displaced on the GPU by a noise texture.
+ *
+ * The top surface of the owner's mesh is resampled on a regular grid in mesh space (X/Z plane, Y up)
+ * and displaced by the same noise texture and displacement scale as the tessellation shader.
+ * Queries only visit the cells under their bounding box, so their cost does not depend on the terrain size.
+ */
+class HeightfieldCollisionComponent : public BaseCollisionComponent
+{
+    COMPONENT_TYPE(HeightfieldCollisionComponent, BaseCollisionComponent)
+private:
+    /**
+     * @brief Heights of the grid samples in mesh space, row by row along Z.
+     */
+    std::vector<float> mHeights;
+
+    /**
+     * @brief Number of cells along the X axis.
+     */
+    int mColumns = 0;
+
+    /**
+     * @brief Number of cells along the Z axis.
+     */
+    int mRows = 0;
+
+    /**
+     * @brief Mesh space position of the first sample on the X axis.
+     */
+    float mOriginX = 0.0f;
+
+    /**
+     * @brief Mesh space position of the first sample on the Z axis.
+     */
+    float mOriginZ = 0.0f;
+
+    /**
+     * @brief Size of a cell along the X axis.
+     */
+    float mCellSizeX = 1.0f;
+
+    /**
+     * @brief Size of a cell along the Z axis.
+     */
+    float mCellSizeZ = 1.0f;
+
+    /**
+     * @brief Lowest sample of the grid.
+     */
+    float mMinHeight = 0.0f;
+
+    /**
+     * @brief Highest sample of the grid.
+     */
+    float mMaxHeight = 0.0f;
+
+    /**
+     * @brief Builds the height grid from the owner's mesh and the noise texture.
+     * @param pNoiseTexture Noise texture used to displace the mesh.
+     * @param pDisplacementScale Height of the displacement for a full intensity texel.
+     * @param pResolution Number of cells along the longest side of the terrain.
+     */
+    void Build(const Texture& pNoiseTexture, float pDisplacementScale, int pResolution);
+
+    /**
+     * @brief Gets the height of a grid sample.
+     * @param pColumn Column of the sample.
+     * @param pRow Row of the sample.
+     * @return The height in mesh space.
+     */
+    float GetSample(int pColumn, int pRow) const
+    {
+        return mHeights[static_cast<size_t>(pRow) * (mColumns + 1) + pColumn];
+    }
+
+    /**
+     * @brief Gets the two triangles of a cell in mesh space.
+     * @param pColumn Column of the cell.
+     * @param pRow Row of the cell.
+     * @param pTriangles Output array of six vertices.
+     */
+    void GetCellTriangles(int pColumn, int pRow, Vec3 pTriangles[6]) const;
+
+    /**
+     * @brief Converts a point from world space to mesh space.
+     * @param pPoint The point in world space.
+     * @return The point in mesh space.
+     */
+    Vec3 WorldToLocal(const Vec3& pPoint) const;
+
+    /**
+     * @brief Converts a point from mesh space to world space.
+     * @param pPoint The point in mesh space.
+     * @return The point in world space.
+     */
+    Vec3 LocalToWorld(const Vec3& pPoint) const;
+
+    /**
+     * @brief Converts a normal from mesh space to world space.
+     * @param pNormal The normal in mesh space.
+     * @return The normalized normal in world space.
+     */
+    Vec3 LocalNormalToWorld(const Vec3& pNormal) const;
+
+public:
+    /**
+     * @brief Constructs a HeightfieldCollisionComponent from the owner's mesh.
+     * @param pOwner Pointer to the owning Actor, which must have a MeshComponent.
+     * @param pNoiseTexture Noise texture used by the tessellation shader.
+     * @param pDisplacementScale Displacement scale used by the tessellation shader.
+     * @param pResolution Number of cells along the longest side of the terrain.
+     */
+    HeightfieldCollisionComponent(Actor* pOwner, const Texture& pNoiseTexture, float pDisplacementScale, int pResolution = 128);
+
+    /**
+     * @brief Destructor.
+     */
+    ~HeightfieldCollisionComponent() override = default;
+
+    /**
+     * @brief Gets the height of the terrain in mesh space.
+     * @param pX X coordinate in mesh space.
+     * @param pZ Z coordinate in mesh space.
+     * @param pOutNormal Output surface normal in mesh space.
+     * @return The height, or the lowest sample outside of the grid.
+     */
+    float GetHeight(float pX, float pZ, Vec3& pOutNormal) const;
+
+    /**
+     * @brief Finds the deepest contact between the terrain and a sphere.
+     * @param pCenter Center of the sphere in world space.
+     * @param pRadius Radius of the sphere.
+     * @param pOutPoint Output contact point on the terrain, in world space.
+     * @param pOutNormal Output contact normal pointing out of the terrain, in world space.
+     * @param pOutDepth Output penetration depth.
+     * @return True if the sphere touches the terrain.
+     */
+    bool IntersectSphere(const Vec3& pCenter, float pRadius, Vec3& pOutPoint, Vec3& pOutNormal, float& pOutDepth) const;
+
+    /**
+     * @brief Tests a point against the terrain.
+     * @param pPoint The point in world space.
+     * @param pOutSurfacePoint Output point of the terrain surface above the point, in world space.
+     * @param pOutNormal Output surface normal, in world space.
+     * @param pOutDepth Output penetration depth.
+     * @return True if the point is below the terrain surface.
+     */
+    bool IntersectPoint(const Vec3& pPoint, Vec3& pOutSurfacePoint, Vec3& pOutNormal, float& pOutDepth) const;
+
+    /**
+     * @brief Casts a ray against the terrain, walking only the cells crossed by the ray.
+     * @param pOrigin Origin of the ray in world space.
+     * @param pDirection Normalized direction of the ray in world space.
+     * @param pMaxDistance Maximum distance of the ray.
+     * @param pOutDistance Output distance of the hit along the ray.
+     * @param pOutNormal Output surface normal at the hit, in world space.
+     * @return True if the ray hits the terrain.
+     */
+    bool Raycast(const Vec3& pOrigin, const Vec3& pDirection, float pMaxDistance, float& pOutDistance, Vec3& pOutNormal) const;
+
+    /**
+     * @brief Gets the corners of the terrain bounds in world space.
+     * @return Vector of the 8 corners.
+     */
+    std::vector<Vec3> GetVerticesInWorldSpace() const override;
+};
@@ -17,14 +17,6 @@ PolyCollisionComponent::PolyCollisionComponent(Actor* owner) : BoxCollisionCompo
 {
     mCollisionType = CollisionType::Mesh;
     mMesh = mOwner->GetComponent<MeshComponent>()->GetMesh();
-    mVertexShader.Load("Collision.vert", ShaderType::VERTEX);
-    mFragmentShader.Load("Collision.frag", ShaderType::FRAGMENT);
-    mShaderProgram.Compose({&mVertexShader, &mFragmentShader });
-    mShaderProgram.setVector3f("randomColor",
-        Vec3(0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX),
-             0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX),
-             0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX))
-    );
 }
 
 /**
@@ -35,14 +27,6 @@ PolyCollisionComponent::PolyCollisionComponent(Actor* owner) : BoxCollisionCompo
 PolyCollisionComponent::PolyCollisionComponent(Actor* owner, Mesh* mesh) : BoxCollisionComponent(owner), mMesh(mesh)
 {
     mCollisionType = CollisionType::Mesh;
-    mVertexShader.Load("Collision.vert", ShaderType::VERTEX);
-    mFragmentShader.Load("Collision.frag", ShaderType::FRAGMENT);
-    mShaderProgram.Compose({&mVertexShader, &mFragmentShader });
-    mShaderProgram.setVector3f("randomColor",
-    Vec3(0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX),
-         0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX),
-         0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX))
-);
 }
 
 /**
@@ -52,16 +36,15 @@ PolyCollisionComponent::~PolyCollisionComponent() = default;
 
 /**
  * @brief Draws the mesh collision shape.
- * @param viewProj The view-projection matrix.
  */
-void PolyCollisionComponent::Draw(Matrix4Row viewProj)
+void PolyCollisionComponent::Draw()
 {
     if (!mMesh) return;
     LocalMesh = *mMesh;
-    Matrix4Row wt = mOwner->GetWorldTransform();
-    mShaderProgram.Use();
-    mShaderProgram.setMatrix4Row("uViewProj", viewProj);
-    mShaderProgram.setMatrix4Row("uWorldTransform", wt);
+    Matrix4Row wt = LocalMesh.GetVertexTransform() * mOwner->GetWorldTransform();
+    mShaderProgram->Use();
+    mShaderProgram->setVector3f("randomColor", mDebugColor);
+    mShaderProgram->setMatrix4Row("uWorldTransform", wt);
     LocalMesh.GetVertexArray()->SetActive();
-    glDrawArrays(GL_TRIANGLES, 0, LocalMesh.GetVerticesCount());    
+    glDrawElements(GL_TRIANGLES, LocalMesh.GetIndicesCount(), GL_UNSIGNED_INT, nullptr);    
 }
@@ -13,6 +13,7 @@
  */
 class PolyCollisionComponent : public BoxCollisionComponent
 {
+    COMPONENT_TYPE(PolyCollisionComponent, BoxCollisionComponent)
 private:
     /**
      * @brief Pointer to the mesh used for collision.
@@ -44,9 +45,8 @@ public:
 
     /**
      * @brief Draws the mesh collision shape.
-     * @param viewProj The view-projection matrix.
      */
-    virtual void Draw(Matrix4Row viewProj);
+    virtual void Draw();
 
     /**
      * @brief Gets the mesh used for collision.
@@ -7,6 +7,7 @@
 
 #include "Core/Class/Actor/Actor.h"
 #include "Core/Physic/PhysicConstants.h"
+#include "Core/Physic/PhysicEngine.h"
 #include "Core/Render/Component/MeshComponent.h"
 
 /**
@@ -21,46 +22,38 @@ RigidbodyComponent::RigidbodyComponent(Actor* pOwner) : Component(pOwner), mVelo
     mFriction = 1.0f;
     mAngularDamping = 0.4f;
     mLinearDamping = 0.4f;
+
+    MeshComponent* meshComponent = mOwner->GetComponent<MeshComponent>();
+    if (meshComponent && meshComponent->GetMesh())
+    {
+        mUnitMomentOfInertia = meshComponent->GetMesh()->GetMassProperties().originInertia;
+
+        // Normalize before inverting so small meshes do not fall under the determinant tolerance
+        float trace = mUnitMomentOfInertia.m[0][0] + mUnitMomentOfInertia.m[1][1] + mUnitMomentOfInertia.m[2][2];
+        float normalization = trace > 0.0f ? 3.0f / trace : 1.0f;
+        mUnitInverseMomentOfInertia = (mUnitMomentOfInertia * normalization).Inverse() * normalization;
+    }
     SetMass(100.0f);
-    CalcMomentOfInertia();
 }
 
 /**
- * @brief Calculates the moment of inertia tensor based on the mesh vertices.
+ * @brief Destructor, unregisters the rigidbody from the PhysicEngine.
  */
-void RigidbodyComponent::CalcMomentOfInertia()
+RigidbodyComponent::~RigidbodyComponent()
 {
-    const Mesh* mesh = mOwner->GetComponent<MeshComponent>()->GetMesh();
-    const std::vector<Vertex>& vertices = mesh->GetVertices();
-    size_t vertexCount = vertices.size();
-
-    if (vertexCount == 0) return;
-
-    float totalMass = mMass;
-    float massPerVertex = totalMass / static_cast<float>(vertexCount);
-
-    Mat3 I;
-    for (auto& vertex : vertices)
+    if (mPhysicEngine)
     {
-        Vec3 vertexPos = vertex.position;
-
-        Vec3 vertexPos2 = vertex.position * vertex.position;
-        
-        I.m[0][0] += massPerVertex * (vertexPos2.y + vertexPos2.z);
-        I.m[1][1] += massPerVertex * (vertexPos2.x + vertexPos2.z);
-        I.m[2][2] += massPerVertex * (vertexPos2.x + vertexPos2.y);
-        
-        I.m[0][1] -= massPerVertex * vertexPos.x * vertexPos.y;
-        I.m[0][2] -= massPerVertex * vertexPos.x * vertexPos.z;
-        I.m[1][2] -= massPerVertex * vertexPos.y * vertexPos.z;
+        mPhysicEngine->RemoveRigidbody(this);
     }
-    
-    I.m[1][0] = I.m[0][1];
-    I.m[2][0] = I.m[0][2];
-    I.m[2][1] = I.m[1][2];
+}
 
-    mMomentOfInertia = I;
-    mInverseMomentOfInertia = I.Inverse();
+/**
+ * @brief Rescales the unit inertia tensor cached from the mesh to the current mass.
+ */
+void RigidbodyComponent::CalcMomentOfInertia()
+{
+    mMomentOfInertia = mUnitMomentOfInertia * mMass;
+    mInverseMomentOfInertia = mUnitInverseMomentOfInertia * mInverseMass;
 }
 
 /**
@@ -6,10 +6,12 @@
 #pragma once
 #include <vector>
 #include "Core/Class/Component/Component.h"
+#include "Core/Physic/RigidbodyHandle.h"
 #include "Math/Mat3.h"
 #include "Math/MatMN.h"
 
 class BaseCollisionComponent;
+class PhysicEngine;
 
 /**
  * @class RigidbodyComponent
@@ -17,6 +19,8 @@ class BaseCollisionComponent;
  */
 class RigidbodyComponent : public Component
 {
+    COMPONENT_TYPE(RigidbodyComponent, Component)
+    POOLED_COMPONENT(RigidbodyComponent)
 private:
     /**
      * @brief Whether the rigidbody is static (immovable).
@@ -104,14 +108,34 @@ private:
     bool mLockRotation = false;
 
     /**
-     * @brief Calculates the moment of inertia tensor.
+     * @brief Moment of inertia tensor for a unit mass, cached from the mesh mass properties.
+     */
+    Mat3 mUnitMomentOfInertia;
+
+    /**
+     * @brief Inverse of the unit mass moment of inertia tensor.
+     */
+    Mat3 mUnitInverseMomentOfInertia;
+
+    /**
+     * @brief Rescales the cached unit inertia tensor to the current mass.
      */
     void CalcMomentOfInertia();
 
     /**
      * @brief Pointer to the associated collision component.
      */
-    BaseCollisionComponent* mCollisionComponent;
+    BaseCollisionComponent* mCollisionComponent = nullptr;
+
+    /**
+     * @brief Handle of the rigidbody in the PhysicEngine registry.
+     */
+    RigidbodyHandle mPhysicHandle;
+
+    /**
+     * @brief PhysicEngine the rigidbody is registered in.
+     */
+    PhysicEngine* mPhysicEngine = nullptr;
     
 public:
     /**
@@ -120,6 +144,11 @@ public:
      */
     RigidbodyComponent(Actor* pOwner);
 
+    /**
+     * @brief Destructor, unregisters the rigidbody from the PhysicEngine.
+     */
+    ~RigidbodyComponent() override;
+
     /**
      * @brief Called when the component is started.
      */
@@ -272,6 +301,24 @@ public:
         mAngularDamping = pAngularDamping;
     }
 
+    /**
+     * @brief Gets the angular damping factor.
+     * @return The angular damping value.
+     */
+    float GetAngularDamping() const
+    {
+        return mAngularDamping;
+    }
+
+    /**
+     * @brief Gets the linear damping factor.
+     * @return The linear damping value.
+     */
+    float GetLinearDamping() const
+    {
+        return mLinearDamping;
+    }
+
     /**
      * @brief Gets the friction coefficient.
      * @return The friction value.
@@ -290,6 +337,15 @@ public:
         mLockRotation = pLockRotation;
     }
 
+    /**
+     * @brief Checks if rotation is locked.
+     * @return True if locked, false otherwise.
+     */
+    bool IsRotationLocked() const
+    {
+        return mLockRotation;
+    }
+
     /**
      * @brief Gets the location of the rigidbody in world space.
      * @return The position vector.
@@ -329,6 +385,42 @@ public:
         return mCollisionComponent;
     }
 
+    /**
+     * @brief Gets the handle of the rigidbody in the PhysicEngine registry.
+     * @return The handle, invalid if the rigidbody is not registered.
+     */
+    RigidbodyHandle GetPhysicHandle() const
+    {
+        return mPhysicHandle;
+    }
+
+    /**
+     * @brief Sets the handle of the rigidbody in the PhysicEngine registry.
+     * @param pHandle The handle issued by the PhysicEngine.
+     */
+    void SetPhysicHandle(RigidbodyHandle pHandle)
+    {
+        mPhysicHandle = pHandle;
+    }
+
+    /**
+     * @brief Gets the PhysicEngine the rigidbody is registered in.
+     * @return Pointer to the PhysicEngine, or nullptr if the rigidbody is not registered.
+     */
+    PhysicEngine* GetPhysicEngine() const
+    {
+        return mPhysicEngine;
+    }
+
+    /**
+     * @brief Sets the PhysicEngine the rigidbody is registered in.
+     * @param pPhysicEngine The PhysicEngine that issued the handle.
+     */
+    void SetPhysicEngine(PhysicEngine* pPhysicEngine)
+    {
+        mPhysicEngine = pPhysicEngine;
+    }
+
     /**
      * @brief Gets the local axes of the rigidbody in world space.
      * @return Vector of 3 axes as Vec3.
@@ -18,15 +18,10 @@ SphereCollisionComponent::SphereCollisionComponent(Actor* actor) : BaseCollision
 {
     mCollisionType = CollisionType::Sphere;   
     mRadius = actor->GetComponent<MeshComponent>()->GetMesh()->GetRadius();
+    if (!mDebugDraw) return;
+
     GenerateSphere(mRadius);
-    mVertexShader.Load("Collision.vert", ShaderType::VERTEX);
-    mFragmentShader.Load("Collision.frag", ShaderType::FRAGMENT);
-    mShaderProgram.Compose({&mVertexShader, &mFragmentShader });
-    mShaderProgram.setVector3f("randomColor",
-        Vec3(0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX),
-             0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX),
-             0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX))
-    );
+    LoadDebugShader();
 }
 
 /**
@@ -37,15 +32,10 @@ SphereCollisionComponent::SphereCollisionComponent(Actor* actor) : BaseCollision
 SphereCollisionComponent::SphereCollisionComponent(Actor* actor, float radius) : BaseCollisionComponent(actor), mRadius(radius)
 {
     mCollisionType = CollisionType::Sphere;
+    if (!mDebugDraw) return;
+
     GenerateSphere(mRadius);
-    mVertexShader.Load("Collision.vert", ShaderType::VERTEX);
-    mFragmentShader.Load("Collision.frag", ShaderType::FRAGMENT);
-    mShaderProgram.Compose({&mVertexShader, &mFragmentShader });
-    mShaderProgram.setVector3f("randomColor",
-    Vec3(0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX),
-         0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX),
-         0.5f + static_cast<float>(rand()) / (2.0f * RAND_MAX))
-);
+    LoadDebugShader();
 }
 
 /**
@@ -55,17 +45,16 @@ SphereCollisionComponent::~SphereCollisionComponent() = default;
 
 /**
  * @brief Draws the sphere collision shape.
- * @param viewProj The view-projection matrix.
  */
-void SphereCollisionComponent::Draw(Matrix4Row viewProj)
+void SphereCollisionComponent::Draw()
 {
-    BaseCollisionComponent::Draw(viewProj);
+    BaseCollisionComponent::Draw();
 
     Matrix4Row wt = mOwner->GetWorldTransform();    
     
-    mShaderProgram.Use();
-    mShaderProgram.setMatrix4Row("uViewProj", viewProj);
-    mShaderProgram.setMatrix4Row("uWorldTransform", wt);
+    mShaderProgram->Use();
+    mShaderProgram->setVector3f("randomColor", mDebugColor);
+    mShaderProgram->setMatrix4Row("uWorldTransform", wt);
 
     mVertexArray->SetActive();
     glDrawArrays(GL_TRIANGLES, 0, mVertexArray->GetVerticeCount());
@@ -120,7 +109,7 @@ void SphereCollisionComponent::GenerateSphere(float radius)
         }
     }
 
-    // Création des triangles
+    // Création des triangles, seules les positions sont dessinées
     std::vector<float> sphereVertices;
     for (int lat = 0; lat < latitudeSegments; ++lat)
     {
@@ -134,7 +123,7 @@ void SphereCollisionComponent::GenerateSphere(float radius)
             {
                 sphereVertices.insert(sphereVertices.end(), 
                     vertices.begin() + i * 8, 
-                    vertices.begin() + (i + 1) * 8);
+                    vertices.begin() + i * 8 + 3);
             }
 
             // Triangle 2
@@ -142,13 +131,13 @@ void SphereCollisionComponent::GenerateSphere(float radius)
             {
                 sphereVertices.insert(sphereVertices.end(), 
                     vertices.begin() + i * 8, 
-                    vertices.begin() + (i + 1) * 8);
+                    vertices.begin() + i * 8 + 3);
             }
         }
     }
 
     // Création du VertexArray
-    mVertexArray = new VertexArray(sphereVertices.data(), static_cast<unsigned int>(sphereVertices.size() / 8));
+    mVertexArray = new VertexArray(sphereVertices.data(), static_cast<unsigned int>(sphereVertices.size() / 3), VertexLayout::PositionOnly());
 }
 
 /**
@@ -158,7 +147,7 @@ void SphereCollisionComponent::GenerateSphere(float radius)
 void SphereCollisionComponent::SetRadius(float radius)
 {
     mRadius = radius;
-    GenerateSphere(mRadius);
+    if (mDebugDraw) GenerateSphere(mRadius);
 }
 
 /**
@@ -5,7 +5,6 @@
 
 #pragma once
 #include "BaseCollisionComponent.h"
-#include "Core/Render/Shader/ShaderProgram.h"
 
 class VertexArray;
 
@@ -15,6 +14,8 @@ class VertexArray;
  */
 class SphereCollisionComponent : public BaseCollisionComponent
 {
+    COMPONENT_TYPE(SphereCollisionComponent, BaseCollisionComponent)
+    POOLED_COMPONENT(SphereCollisionComponent)
 private:
     /**
      * @brief The radius of the sphere.
@@ -29,17 +30,7 @@ private:
     /**
      * @brief Vertex array for rendering the sphere.
      */
-    VertexArray* mVertexArray;
-
-    /**
-     * @brief Shader program for rendering.
-     */
-    ShaderProgram mShaderProgram;
-
-    /**
-     * @brief Vertex and fragment shaders.
-     */
-    Shader mVertexShader, mFragmentShader;
+    VertexArray* mVertexArray = nullptr;
 public:
     /**
      * @brief Constructs a SphereCollisionComponent using the owner's mesh radius.
@@ -61,9 +52,8 @@ public:
 
     /**
      * @brief Draws the sphere collision shape.
-     * @param viewProj The view-projection matrix.
      */
-    void Draw(Matrix4Row viewProj) override;
+    void Draw() override;
 
     /**
      * @brief Generates the sphere geometry for rendering.
@@ -0,0 +1,280 @@
+/**
+ * @file WaterVolumeComponent.cpp
+ * @brief Implementation of the WaterVolumeComponent class, a CPU copy of the animated water surface.
+ */
+
+#include "WaterVolumeComponent.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "BuoyancyComponent.h"
+#include "RigidbodyComponent.h"
+#include "Core/Class/Actor/Actor.h"
+#include "Core/Physic/PhysicConstants.h"
+#include "Core/Render/Texture.h"
+#include "Core/Render/Component/MeshComponent.h"
+#include "Debug/Log.h"
+#include "Math/Time.h"
+
+/**
+ * @brief Constructs a WaterVolumeComponent from the owner's mesh.
+ * @param pOwner Pointer to the owning Actor, which must have a MeshComponent.
+ * @param pNoiseTexture Noise texture used by the water shader.
+ */
+WaterVolumeComponent::WaterVolumeComponent(Actor* pOwner, const Texture& pNoiseTexture) : Component(pOwner)
+{
+    mNoise.Load(pNoiseTexture.GetFilePath());
+    BuildSurface();
+}
+
+/**
+ * @brief Destructor. Detaches the remaining bodies.
+ */
+WaterVolumeComponent::~WaterVolumeComponent()
+{
+    for (BuoyancyComponent* body : mBodies)
+    {
+        body->DetachWater();
+    }
+}
+
+/**
+ * @brief Derives the flat surface and the texture coordinate mapping from the owner's mesh.
+ * The texture coordinates are assumed to be an affine function of the X/Z position, which holds for a flat
+ * water plane, so they are solved once from the first triangle that is not degenerate when seen from above.
+ */
+void WaterVolumeComponent::BuildSurface()
+{
+    MeshComponent* meshComponent = mOwner->GetComponent<MeshComponent>();
+    if (!meshComponent || !meshComponent->GetMesh())
+    {
+        Log::Error(LogType::Error, "WaterVolumeComponent requires a MeshComponent with a mesh");
+        return;
+    }
+
+    const Mesh* mesh = meshComponent->GetMesh();
+    Box bounds = mesh->GetBoundingBox();
+    mSurfaceHeight = bounds.max.y;
+    mMinX = bounds.min.x;
+    mMaxX = bounds.max.x;
+    mMinZ = bounds.min.z;
+    mMaxZ = bounds.max.z;
+
+    Vec2 tiling = meshComponent->GetTiling();
+    const std::vector<Vertex>& vertices = mesh->GetVertices();
+    const std::vector<unsigned int>& indices = mesh->GetIndices();
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        const Vertex& v0 = vertices[indices[i]];
+        const Vertex& v1 = vertices[indices[i + 1]];
+        const Vertex& v2 = vertices[indices[i + 2]];
+        Vec3 e1 = v1.position - v0.position;
+        Vec3 e2 = v2.position - v0.position;
+        float determinant = e1.x * e2.z - e2.x * e1.z;
+        if (fabs(determinant) < EPSILON) continue;
+
+        float du1 = v1.texCoord.x - v0.texCoord.x;
+        float du2 = v2.texCoord.x - v0.texCoord.x;
+        float dv1 = v1.texCoord.y - v0.texCoord.y;
+        float dv2 = v2.texCoord.y - v0.texCoord.y;
+
+        mUPerX = (du1 * e2.z - du2 * e1.z) / determinant * tiling.x;
+        mUPerZ = (e1.x * du2 - e2.x * du1) / determinant * tiling.x;
+        mVPerX = (dv1 * e2.z - dv2 * e1.z) / determinant * tiling.y;
+        mVPerZ = (e1.x * dv2 - e2.x * dv1) / determinant * tiling.y;
+        mUOrigin = v0.texCoord.x * tiling.x - mUPerX * v0.position.x - mUPerZ * v0.position.z;
+        mVOrigin = v0.texCoord.y * tiling.y - mVPerX * v0.position.x - mVPerZ * v0.position.z;
+        return;
+    }
+
+    Log::Warning(LogType::Error, "WaterVolumeComponent found no horizontal triangle, the waves will not move");
+}
+
+/**
+ * @brief Registers a floating body.
+ * @param pBody The body to register.
+ */
+void WaterVolumeComponent::AddBody(BuoyancyComponent* pBody)
+{
+    if (std::find(mBodies.begin(), mBodies.end(), pBody) == mBodies.end())
+    {
+        mBodies.push_back(pBody);
+    }
+}
+
+/**
+ * @brief Unregisters a floating body.
+ * @param pBody The body to unregister.
+ */
+void WaterVolumeComponent::RemoveBody(BuoyancyComponent* pBody)
+{
+    auto it = std::find(mBodies.begin(), mBodies.end(), pBody);
+    if (it != mBodies.end())
+    {
+        *it = mBodies.back();
+        mBodies.pop_back();
+    }
+}
+
+/**
+ * @brief Gets the time used by the wave, the one sent to the water shader with the frame data so both stay in sync.
+ * @return The time in seconds.
+ */
+float WaterVolumeComponent::GetTime() const
+{
+    return Time::elapsedTime;
+}
+
+/**
+ * @brief Evaluates the surface height for a batch of points.
+ * Mirrors animWave() of WaterTess.tese. Each step is a separate loop over flat arrays so the
+ * compiler can vectorize the arithmetic, only the texture lookup stays scalar.
+ * The scratch arrays belong to the caller, so concurrent evaluations do not share any memory.
+ * @param pX X coordinates in mesh space.
+ * @param pZ Z coordinates in mesh space.
+ * @param pOutHeights Output surface heights in mesh space.
+ * @param pScratchU Scratch array of pCount floats receiving the texture U coordinates.
+ * @param pScratchV Scratch array of pCount floats receiving the texture V coordinates.
+ * @param pScratchNoise Scratch array of pCount floats receiving the noise samples.
+ * @param pCount Number of points.
+ */
+void WaterVolumeComponent::EvaluateHeights(const float* pX, const float* pZ, float* pOutHeights, float* pScratchU, float* pScratchV,
+    float* pScratchNoise, size_t pCount) const
+{
+    float* u = pScratchU;
+    float* v = pScratchV;
+    float* noise = pScratchNoise;
+
+    for (size_t i = 0; i < pCount; i++)
+    {
+        u[i] = mUOrigin + mUPerX * pX[i] + mUPerZ * pZ[i];
+        v[i] = mVOrigin + mVPerX * pX[i] + mVPerZ * pZ[i];
+    }
+
+    for (size_t i = 0; i < pCount; i++)
+    {
+        noise[i] = mNoise.Sample(u[i] * WATER_NOISE_TILING, v[i] * WATER_NOISE_TILING);
+    }
+
+    float phase = GetTime() * mSpeed;
+    float scaleRange = WATER_WAVE_MAX_SCALE - WATER_WAVE_MIN_SCALE;
+    for (size_t i = 0; i < pCount; i++)
+    {
+        float waveScale = mAmplitude * noise[i] * (WATER_WAVE_MIN_SCALE + scaleRange * noise[i]);
+        pOutHeights[i] = mSurfaceHeight + sinf((u[i] - phase) * mFrequency) * waveScale;
+    }
+}
+
+/**
+ * @brief Gets the height of the surface above or below a point.
+ * @param pPoint The point in world space.
+ * @return The point of the surface on the water up axis, in world space.
+ */
+Vec3 WaterVolumeComponent::GetSurfacePoint(const Vec3& pPoint) const
+{
+    Vec3 scale = mOwner->GetScale();
+    Vec3 local = mOwner->GetRotation().Inverse() * (pPoint - mOwner->GetLocation());
+    float x = local.x / scale.x;
+    float z = local.z / scale.z;
+    float height = 0.0f;
+    float u = 0.0f, v = 0.0f, noise = 0.0f;
+    EvaluateHeights(&x, &z, &height, &u, &v, &noise, 1);
+    return mOwner->GetRotation() * (Vec3(x, height, z) * scale) + mOwner->GetLocation();
+}
+
+/**
+ * @brief Evaluates all the registered bodies and applies their forces.
+ * The samples of every body are first gathered in mesh space, evaluated in a single batch,
+ * then turned into forces body by body.
+ */
+void WaterVolumeComponent::Update()
+{
+    Component::Update();
+    if (mBodies.empty()) return;
+
+    size_t sampleCount = 0;
+    for (const BuoyancyComponent* body : mBodies)
+    {
+        sampleCount += body->GetSampleCount();
+    }
+
+    mSampleX.resize(sampleCount);
+    mSampleY.resize(sampleCount);
+    mSampleZ.resize(sampleCount);
+    mSampleHeight.resize(sampleCount);
+    mSampleU.resize(sampleCount);
+    mSampleV.resize(sampleCount);
+    mSampleNoise.resize(sampleCount);
+    mSampleWorld.resize(sampleCount);
+
+    Vec3 location = mOwner->GetLocation();
+    Vec3 scale = mOwner->GetScale();
+    Quaternion rotation = mOwner->GetRotation();
+    Quaternion inverseRotation = rotation.Inverse();
+
+    size_t index = 0;
+    for (const BuoyancyComponent* body : mBodies)
+    {
+        for (int i = 0; i < body->GetSampleCount(); i++, index++)
+        {
+            Vec3 world = body->GetSampleInWorldSpace(i);
+            Vec3 local = inverseRotation * (world - location);
+            mSampleWorld[index] = world;
+            mSampleX[index] = local.x / scale.x;
+            mSampleY[index] = local.y / scale.y;
+            mSampleZ[index] = local.z / scale.z;
+        }
+    }
+
+    EvaluateHeights(mSampleX.data(), mSampleZ.data(), mSampleHeight.data(), mSampleU.data(), mSampleV.data(), mSampleNoise.data(),
+        sampleCount);
+
+    Vec3 up = Vec3::Normalize(rotation * Vec3::unitY);
+    index = 0;
+    for (const BuoyancyComponent* body : mBodies)
+    {
+        ApplyForces(body, index, up, scale.y);
+        index += body->GetSampleCount();
+    }
+}
+
+/**
+ * @brief Applies buoyancy and drag to a body from its evaluated samples.
+ * Each sample pushes with its share of the body buoyancy, scaled by how much of its slice is under the surface,
+ * and slows down the body at its own position so the drag also damps rotations.
+ * @param pBody The floating body.
+ * @param pFirstSample Index of the first sample of the body in the sample arrays.
+ * @param pUp Up axis of the water in world space.
+ * @param pHeightScale Scale of the water along its up axis.
+ */
+void WaterVolumeComponent::ApplyForces(const BuoyancyComponent* pBody, size_t pFirstSample, const Vec3& pUp, float pHeightScale) const
+{
+    RigidbodyComponent* rigidbody = pBody->GetRigidbody();
+    int sampleCount = pBody->GetSampleCount();
+    if (!rigidbody || rigidbody->IsStatic() || sampleCount == 0) return;
+
+    float weight = rigidbody->GetMass() * fabs(GRAVITY) * rigidbody->GetGravityScale() * PIXELS_PER_METER;
+    float sampleBuoyancy = weight * pBody->GetBuoyancy() / static_cast<float>(sampleCount);
+    float sampleDrag = rigidbody->GetMass() * pBody->GetDrag() / static_cast<float>(sampleCount);
+    float sampleHeight = 2.0f * pBody->GetSampleRadius();
+    Vec3 center = rigidbody->GetLocation();
+    Vec3 velocity = rigidbody->GetVelocity();
+    Vec3 angularVelocity = rigidbody->GetAngularVelocity();
+
+    for (int i = 0; i < sampleCount; i++)
+    {
+        size_t index = pFirstSample + i;
+        if (mSampleX[index] < mMinX || mSampleX[index] > mMaxX || mSampleZ[index] < mMinZ || mSampleZ[index] > mMaxZ) continue;
+
+        float depth = (mSampleHeight[index] - mSampleY[index]) * pHeightScale;
+        float submerged = std::clamp(depth / sampleHeight + 0.5f, 0.0f, 1.0f);
+        if (submerged <= 0.0f) continue;
+
+        Vec3 arm = mSampleWorld[index] - center;
+        Vec3 pointVelocity = velocity + Vec3::Cross(angularVelocity, arm);
+        Vec3 force = pUp * (sampleBuoyancy * submerged) - pointVelocity * (sampleDrag * submerged);
+        rigidbody->AddForce(force);
+        rigidbody->AddTorque(Vec3::Cross(arm, force));
+    }
+}
@@ -0,0 +1,223 @@
+/**
+ * @file WaterVolumeComponent.h
+ * @brief Declaration of the WaterVolumeComponent class, a CPU copy of the animated water surface.
+ */
+
+#pragma once
+#include <vector>
+#include "Core/Class/Component/Component.h"
+#include "Core/Render/HeightMap.h"
+#include "Math/Vec3.h"
+
+class BuoyancyComponent;
+class Texture;
+
+/**
+ * @brief Tiling applied by WaterTess.tese on top of the mesh tiling when sampling the noise texture.
+ */
+const float WATER_NOISE_TILING = 10.0f;
+
+/**
+ * @brief Wave height multiplier for a black noise texel, as in the mix() of WaterTess.tese.
+ */
+const float WATER_WAVE_MIN_SCALE = 50.0f;
+
+/**
+ * @brief Wave height multiplier for a white noise texel, as in the mix() of WaterTess.tese.
+ */
+const float WATER_WAVE_MAX_SCALE = 150.0f;
+
+/**
+ * @class WaterVolumeComponent
+ * @brief Evaluates the wave function of WaterTess.tese on the CPU and applies buoyancy to registered bodies.
+ *
+ * The owner's mesh is treated as a flat surface in mesh space (X/Z plane, Y up) displaced by the
+ * same wave as the shader. Every frame the sample points of all the registered BuoyancyComponent
+ * are gathered into flat arrays and evaluated in one batch, so the cost is a fixed number of samples
+ * per body whatever the size of the water mesh.
+ */
+class WaterVolumeComponent : public Component
+{
+    COMPONENT_TYPE(WaterVolumeComponent, Component)
+private:
+    /**
+     * @brief CPU copy of the noise texture sampled by the shader.
+     */
+    HeightMap mNoise;
+
+    /**
+     * @brief Wave amplitude, matching the uAmplitude uniform.
+     */
+    float mAmplitude = 0.12f;
+
+    /**
+     * @brief Wave frequency, matching the uFrequency uniform.
+     */
+    float mFrequency = 1.5f;
+
+    /**
+     * @brief Wave speed, matching the uSpeed uniform.
+     */
+    float mSpeed = 0.8f;
+
+    /**
+     * @brief Height of the flat surface in mesh space.
+     */
+    float mSurfaceHeight = 0.0f;
+
+    /**
+     * @brief Extent of the surface in mesh space.
+     */
+    float mMinX = 0.0f, mMaxX = 0.0f, mMinZ = 0.0f, mMaxZ = 0.0f;
+
+    /**
+     * @brief Texture coordinates at the mesh space origin, tiling included.
+     */
+    float mUOrigin = 0.0f, mVOrigin = 0.0f;
+
+    /**
+     * @brief Variation of the texture coordinates along the mesh space X axis, tiling included.
+     */
+    float mUPerX = 0.0f, mVPerX = 0.0f;
+
+    /**
+     * @brief Variation of the texture coordinates along the mesh space Z axis, tiling included.
+     */
+    float mUPerZ = 0.0f, mVPerZ = 0.0f;
+
+    /**
+     * @brief Bodies floating in this volume.
+     */
+    std::vector<BuoyancyComponent*> mBodies;
+
+    /**
+     * @brief Sample positions in mesh space, one array per axis. Kept between frames to avoid reallocations.
+     */
+    std::vector<float> mSampleX, mSampleY, mSampleZ;
+
+    /**
+     * @brief Surface heights above the samples, in mesh space.
+     */
+    std::vector<float> mSampleHeight;
+
+    /**
+     * @brief Texture coordinates and noise of the samples, scratch memory of the batch evaluated by Update().
+     */
+    std::vector<float> mSampleU, mSampleV, mSampleNoise;
+
+    /**
+     * @brief Sample positions in world space.
+     */
+    std::vector<Vec3> mSampleWorld;
+
+    /**
+     * @brief Derives the flat surface and the texture coordinate mapping from the owner's mesh.
+     */
+    void BuildSurface();
+
+    /**
+     * @brief Applies buoyancy and drag to a body from its evaluated samples.
+     * @param pBody The floating body.
+     * @param pFirstSample Index of the first sample of the body in the sample arrays.
+     * @param pUp Up axis of the water in world space.
+     * @param pHeightScale Scale of the water along its up axis.
+     */
+    void ApplyForces(const BuoyancyComponent* pBody, size_t pFirstSample, const Vec3& pUp, float pHeightScale) const;
+
+public:
+    /**
+     * @brief Constructs a WaterVolumeComponent from the owner's mesh.
+     * @param pOwner Pointer to the owning Actor, which must have a MeshComponent.
+     * @param pNoiseTexture Noise texture used by the water shader.
+     */
+    WaterVolumeComponent(Actor* pOwner, const Texture& pNoiseTexture);
+
+    /**
+     * @brief Destructor. Detaches the remaining bodies.
+     */
+    ~WaterVolumeComponent() override;
+
+    /**
+     * @brief Evaluates all the registered bodies and applies their forces.
+     */
+    void Update() override;
+
+    /**
+     * @brief Registers a floating body.
+     * @param pBody The body to register.
+     */
+    void AddBody(BuoyancyComponent* pBody);
+
+    /**
+     * @brief Unregisters a floating body.
+     * @param pBody The body to unregister.
+     */
+    void RemoveBody(BuoyancyComponent* pBody);
+
+    /**
+     * @brief Evaluates the surface height for a batch of points.
+     * The scratch arrays belong to the caller, so concurrent evaluations do not share any memory.
+     * @param pX X coordinates in mesh space.
+     * @param pZ Z coordinates in mesh space.
+     * @param pOutHeights Output surface heights in mesh space.
+     * @param pScratchU Scratch array of pCount floats receiving the texture U coordinates.
+     * @param pScratchV Scratch array of pCount floats receiving the texture V coordinates.
+     * @param pScratchNoise Scratch array of pCount floats receiving the noise samples.
+     * @param pCount Number of points.
+     */
+    void EvaluateHeights(const float* pX, const float* pZ, float* pOutHeights, float* pScratchU, float* pScratchV, float* pScratchNoise,
+        size_t pCount) const;
+
+    /**
+     * @brief Gets the height of the surface above or below a point.
+     * @param pPoint The point in world space.
+     * @return The point of the surface on the water up axis, in world space.
+     */
+    Vec3 GetSurfacePoint(const Vec3& pPoint) const;
+
+    /**
+     * @brief Gets the time used by the wave, the one sent to the water shader with the frame data so both stay in sync.
+     * @return The time in seconds.
+     */
+    float GetTime() const;
+
+    /**
+     * @brief Sets the wave parameters. They must match the uniforms of the water shader.
+     * @param pAmplitude Wave amplitude.
+     * @param pFrequency Wave frequency.
+     * @param pSpeed Wave speed.
+     */
+    void SetWave(float pAmplitude, float pFrequency, float pSpeed)
+    {
+        mAmplitude = pAmplitude;
+        mFrequency = pFrequency;
+        mSpeed = pSpeed;
+    }
+
+    /**
+     * @brief Gets the wave amplitude.
+     * @return The amplitude.
+     */
+    float GetAmplitude() const
+    {
+        return mAmplitude;
+    }
+
+    /**
+     * @brief Gets the wave frequency.
+     * @return The frequency.
+     */
+    float GetFrequency() const
+    {
+        return mFrequency;
+    }
+
+    /**
+     * @brief Gets the wave speed.
+     * @return The speed.
+     */
+    float GetSpeed() const
+    {
+        return mSpeed;
+    }
+};
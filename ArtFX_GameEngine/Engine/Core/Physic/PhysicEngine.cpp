@@ -3,15 +3,36 @@
  * @brief Implementation of the PhysicEngine class, which manages physics simulation, rigidbodies, and constraints.
  */
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <Core/Physic/PhysicEngine.h>
 
 #include "CollisionDetection.h"
 #include "Contact.h"
 #include "PhysicConstants.h"
+#include "Component/HeightfieldCollisionComponent.h"
+#include "Component/PolyCollisionComponent.h"
+#include "Component/SphereCollisionComponent.h"
+#include "Core/Class/Actor/Actor.h"
+#include "Core/Class/Scene/Scene.h"
+#include "Core/Render/Component/MeshComponent.h"
+#include "Debug/Log.h"
+#include "Debug/Profiler.h"
+
+thread_local PhysicEngine* PhysicEngine::ThreadInstance = nullptr;
 
 PhysicEngine::PhysicEngine() =default;
 
+PhysicEngine& PhysicEngine::GetInstance()
+{
+    if (ThreadInstance) return *ThreadInstance;
+    if (Scene::ActiveScene) return Scene::ActiveScene->GetPhysicEngine();
+
+    static PhysicEngine instance;
+    return instance;
+}
+
 PhysicEngine::~PhysicEngine()
 {
     for (Constraint* constraint : mConstraints)
@@ -23,79 +44,388 @@ PhysicEngine::~PhysicEngine()
 void PhysicEngine::Update()
 {
     if (mRigidbodyComponents.empty()) return;
-    
-    std::vector<PenetrationConstraint> penetrations;
 
-    for (RigidbodyComponent* rigidbody : mRigidbodyComponents)
+    if (mStepping.exchange(true))
     {
-        Vec3 weight = Vec3(0.0f, 0.0f, rigidbody->GetMass() * (GRAVITY * rigidbody->GetGravityScale())* PIXELS_PER_METER);
-        rigidbody->AddForce(weight);
+        Log::Error(LogType::Error, "PhysicEngine stepped from two threads at once, each world must be stepped by a single thread");
+        return;
+    }
+    PROFILE_SCOPE("Physics");
+    std::vector<PenetrationConstraint> penetrations;
 
-        for (Vec3 force : mForces)
+    {
+        PROFILE_SCOPE("Physics::IntegrateForces");
+        for (RigidbodyComponent* rigidbody : mRigidbodyComponents)
         {
-            rigidbody->AddForce(force);
+            if (!rigidbody) continue;
+            Vec3 weight = Vec3(0.0f, 0.0f, rigidbody->GetMass() * (GRAVITY * rigidbody->GetGravityScale())* PIXELS_PER_METER);
+            rigidbody->AddForce(weight);
+
+            for (Vec3 force : mForces)
+            {
+                rigidbody->AddForce(force);
+            }
+            for (Vec3 torque : mTorques)
+            {
+                rigidbody->AddTorque(torque);
+            }
         }
-        for (Vec3 torque : mTorques)
+        for (RigidbodyComponent* rigidbody : mRigidbodyComponents) 
         {
-            rigidbody->AddTorque(torque);
+            if (!rigidbody) continue;
+            rigidbody->IntegrateForces();
         }
     }
-    for (RigidbodyComponent* rigidbody : mRigidbodyComponents) 
-    {
-        rigidbody->IntegrateForces();
-    }
 
-    for (int i = 0; i <= mRigidbodyComponents.size() - 1; i++) {
-        for (int j = i + 1; j < mRigidbodyComponents.size(); j++) {
-            RigidbodyComponent* a = mRigidbodyComponents[i];
-            RigidbodyComponent* b = mRigidbodyComponents[j];
+    {
+        PROFILE_SCOPE("Physics::Collisions");
+        for (int i = 0; i <= mRigidbodyComponents.size() - 1; i++) {
+            for (int j = i + 1; j < mRigidbodyComponents.size(); j++) {
+                RigidbodyComponent* a = mRigidbodyComponents[i];
+                RigidbodyComponent* b = mRigidbodyComponents[j];
+                if (!a || !b) continue;
 
-            std::vector<Contact> contacts;
-            if (CollisionDetection::IsColliding(a, b, contacts)) {
-                for (auto contact : contacts) {
-                    PenetrationConstraint penetretion(contact.a, contact.b, contact.start, contact.end, contact.normal);
-                    penetrations.push_back(penetretion);
+                std::vector<Contact> contacts;
+                if (CollisionDetection::IsColliding(a, b, contacts)) {
+                    for (auto contact : contacts) {
+                        PenetrationConstraint penetretion(contact.a, contact.b, contact.start, contact.end, contact.normal);
+                        penetrations.push_back(penetretion);
+                    }
                 }
             }
         }
     }
 
-    for (auto& constraint : mConstraints) {
-        constraint->PreSolve();
-    }
-
-    for (auto& constraint : penetrations) {
-        constraint.PreSolve();
-    }
-
-    for (int i = 0; i < 5; i++)
     {
+        PROFILE_SCOPE("Physics::Solve");
         for (auto& constraint : mConstraints) {
-            constraint->Solve();
+            constraint->PreSolve();
         }
+
         for (auto& constraint : penetrations) {
-            constraint.Solve();
+            constraint.PreSolve();
         }
-    }   
 
-    for (auto& constraint : mConstraints) {
-        constraint->PostSolve();
-    }
+        for (int i = 0; i < 5; i++)
+        {
+            for (auto& constraint : mConstraints) {
+                constraint->Solve();
+            }
+            for (auto& constraint : penetrations) {
+                constraint.Solve();
+            }
+        }   
 
-    for (auto& constraint : penetrations) {
-        constraint.PostSolve();
+        for (auto& constraint : mConstraints) {
+            constraint->PostSolve();
+        }
+
+        for (auto& constraint : penetrations) {
+            constraint.PostSolve();
+        }
     }
 
-    for (auto& rigidbody : mRigidbodyComponents) {
-        rigidbody->IntegrateVelocity();
+    {
+        PROFILE_SCOPE("Physics::IntegrateVelocities");
+        for (auto& rigidbody : mRigidbodyComponents) {
+            if (!rigidbody) continue;
+            rigidbody->IntegrateVelocity();
+        }
     }
+
+    mStepping = false;
+    FlushPendingRemovals();
 }
 
-void PhysicEngine::AddRigidbody(RigidbodyComponent* rigidbody)
+RigidbodyHandle PhysicEngine::AddRigidbody(RigidbodyComponent* rigidbody)
 {
+    if (rigidbody->GetPhysicEngine() == this && IsValid(rigidbody->GetPhysicHandle())) return rigidbody->GetPhysicHandle();
+    // A body registered in another world, such as the one current when its collision was created, leaves it first
+    if (PhysicEngine* previousEngine = rigidbody->GetPhysicEngine())
+    {
+        previousEngine->RemoveRigidbody(rigidbody);
+    }
+
+    uint32_t slotIndex;
+    if (!mFreeSlots.empty())
+    {
+        slotIndex = mFreeSlots.back();
+        mFreeSlots.pop_back();
+    }
+    else
+    {
+        slotIndex = static_cast<uint32_t>(mSlots.size());
+        mSlots.emplace_back();
+    }
+
+    RigidbodySlot& slot = mSlots[slotIndex];
+    slot.denseIndex = static_cast<uint32_t>(mRigidbodyComponents.size());
     mRigidbodyComponents.push_back(rigidbody);
+    mDenseToSlot.push_back(slotIndex);
+
+    RigidbodyHandle handle = { slotIndex, slot.generation };
+    rigidbody->SetPhysicHandle(handle);
+    rigidbody->SetPhysicEngine(this);
+    return handle;
 }
 
 void PhysicEngine::RemoveRigidbody(RigidbodyComponent* rigidbody)
 {
+    if (rigidbody->GetPhysicEngine() != this) return;
+
+    RemoveRigidbody(rigidbody->GetPhysicHandle());
+    rigidbody->SetPhysicHandle(RigidbodyHandle());
+    rigidbody->SetPhysicEngine(nullptr);
+}
+
+void PhysicEngine::RemoveRigidbody(RigidbodyHandle pHandle)
+{
+    if (!IsValid(pHandle)) return;
+
+    if (mStepping)
+    {
+        // The component may be destroyed before the step ends, the rest of the step skips its entry
+        mRigidbodyComponents[mSlots[pHandle.index].denseIndex] = nullptr;
+        mPendingRemovals.push_back(pHandle);
+        return;
+    }
+    ReleaseRigidbody(pHandle);
+}
+
+bool PhysicEngine::IsValid(RigidbodyHandle pHandle) const
+{
+    if (pHandle.index >= mSlots.size()) return false;
+
+    const RigidbodySlot& slot = mSlots[pHandle.index];
+    return slot.generation == pHandle.generation && slot.denseIndex != RigidbodyHandle::InvalidIndex;
+}
+
+RigidbodyComponent* PhysicEngine::GetRigidbody(RigidbodyHandle pHandle) const
+{
+    if (!IsValid(pHandle)) return nullptr;
+    return mRigidbodyComponents[mSlots[pHandle.index].denseIndex];
+}
+
+void PhysicEngine::ReleaseRigidbody(RigidbodyHandle pHandle)
+{
+    if (!IsValid(pHandle)) return;
+
+    RigidbodySlot& slot = mSlots[pHandle.index];
+    uint32_t denseIndex = slot.denseIndex;
+    uint32_t lastIndex = static_cast<uint32_t>(mRigidbodyComponents.size() - 1);
+
+    if (denseIndex != lastIndex)
+    {
+        mRigidbodyComponents[denseIndex] = mRigidbodyComponents[lastIndex];
+        mDenseToSlot[denseIndex] = mDenseToSlot[lastIndex];
+        mSlots[mDenseToSlot[denseIndex]].denseIndex = denseIndex;
+    }
+    mRigidbodyComponents.pop_back();
+    mDenseToSlot.pop_back();
+
+    slot.denseIndex = RigidbodyHandle::InvalidIndex;
+    slot.generation++;
+    mFreeSlots.push_back(pHandle.index);
+}
+
+void PhysicEngine::FlushPendingRemovals()
+{
+    for (RigidbodyHandle handle : mPendingRemovals)
+    {
+        ReleaseRigidbody(handle);
+    }
+    mPendingRemovals.clear();
+}
+
+const std::vector<Vec3>& PhysicEngine::PredictTrajectory(const RigidbodyComponent* pBody, const Vec3& pImpulse, int pSteps, const Vec3& pAngularImpulse)
+{
+    mPredictionPoints.clear();
+    if (!pBody || pBody->IsStatic() || pSteps <= 0) return mPredictionPoints;
+
+    GatherPredictionObstacles(pBody);
+    mPredictionPoints.reserve(pSteps);
+
+    // Same radius as the sphere collider would use, so an unregistered preview body matches the thrown one
+    float radius = 0.0f;
+    BaseCollisionComponent* collision = pBody->GetCollisionComponent();
+    if (SphereCollisionComponent* sphere = dynamic_cast<SphereCollisionComponent*>(collision))
+    {
+        radius = sphere->GetRadius();
+    }
+    else if (BoxCollisionComponent* box = dynamic_cast<BoxCollisionComponent*>(collision))
+    {
+        radius = box->GetRadius();
+    }
+    else if (MeshComponent* meshComponent = pBody->GetOwner()->GetComponent<MeshComponent>())
+    {
+        if (meshComponent->GetMesh()) radius = meshComponent->GetMesh()->GetRadius();
+    }
+
+    float mass = pBody->GetMass();
+    float inverseMass = pBody->GetInverseMass();
+    Mat3 inverseInertia = pBody->GetInverseMomentOfInertia();
+    bool lockRotation = pBody->IsRotationLocked();
+    float linearDamping = 1.0f - DELTA_STEP * pBody->GetLinearDamping() / mass;
+    float angularDamping = 1.0f - DELTA_STEP * pBody->GetAngularDamping() / mass;
+
+    // Forces are constant during the prediction, so they are summed once as in Update
+    Vec3 acceleration = Vec3(0.0f, 0.0f, GRAVITY * pBody->GetGravityScale() * PIXELS_PER_METER);
+    for (Vec3 force : mForces)
+    {
+        acceleration += force * inverseMass;
+    }
+    Vec3 torque = Vec3::zero;
+    for (Vec3 globalTorque : mTorques)
+    {
+        torque += globalTorque;
+    }
+    Vec3 angularAcceleration = inverseInertia * torque;
+
+    Vec3 location = pBody->GetLocation();
+    Vec3 velocity = pBody->GetVelocity() + pImpulse * inverseMass;
+    Vec3 angularVelocity = lockRotation ? pBody->GetAngularVelocity() : pBody->GetAngularVelocity() + inverseInertia * pAngularImpulse;
+
+    for (int step = 0; step < pSteps; step++)
+    {
+        velocity += acceleration * DELTA_STEP;
+        angularVelocity += angularAcceleration * DELTA_STEP;
+
+        for (const PredictionObstacle& obstacle : mPredictionObstacles)
+        {
+            Vec3 normal;
+            float depth;
+            if (!FindPredictionContact(obstacle, location, radius, normal, depth)) continue;
+
+            location += normal * depth;
+
+            Vec3 arm = normal * -radius;
+            Vec3 contactVelocity = velocity + Vec3::Cross(angularVelocity, arm);
+            float normalSpeed = Vec3::Dot(contactVelocity, normal);
+            if (normalSpeed >= 0.0f) continue;
+
+            // The arm is along the normal, so the normal impulse only changes the linear velocity
+            float restitution = std::min(pBody->GetRestitution(), obstacle.restitution);
+            float normalImpulse = -(1.0f + restitution) * normalSpeed * mass;
+            velocity += normal * (normalImpulse * inverseMass);
+
+            Vec3 tangentVelocity = contactVelocity - normal * normalSpeed;
+            float tangentSpeed = tangentVelocity.Length();
+            if (tangentSpeed < EPSILON) continue;
+
+            Vec3 tangent = tangentVelocity / tangentSpeed;
+            Vec3 angularPerImpulse = lockRotation ? Vec3::zero : inverseInertia * Vec3::Cross(arm, tangent);
+            float effectiveMass = inverseMass + Vec3::Dot(Vec3::Cross(angularPerImpulse, arm), tangent);
+            float friction = std::max(pBody->GetFriction(), obstacle.friction);
+            float frictionImpulse = std::min(tangentSpeed / effectiveMass, friction * normalImpulse);
+
+            velocity -= tangent * (frictionImpulse * inverseMass);
+            angularVelocity -= angularPerImpulse * frictionImpulse;
+        }
+
+        location += velocity * DELTA_STEP;
+        velocity *= linearDamping;
+        if (!lockRotation)
+        {
+            angularVelocity *= angularDamping;
+        }
+
+        mPredictionPoints.push_back(location);
+    }
+
+    return mPredictionPoints;
+}
+
+void PhysicEngine::GatherPredictionObstacles(const RigidbodyComponent* pBody)
+{
+    mPredictionObstacles.clear();
+
+    for (RigidbodyComponent* rigidbody : mRigidbodyComponents)
+    {
+        if (!rigidbody || rigidbody == pBody || !rigidbody->IsStatic() || !rigidbody->GetCollisionComponent()) continue;
+
+        BaseCollisionComponent* collision = rigidbody->GetCollisionComponent();
+        Quaternion rotation = rigidbody->GetOwner()->GetRotation();
+
+        PredictionObstacle obstacle;
+        obstacle.center = rigidbody->GetLocation();
+        obstacle.axes[0] = rotation * Vec3::unitX;
+        obstacle.axes[1] = rotation * Vec3::unitY;
+        obstacle.axes[2] = rotation * Vec3::unitZ;
+        obstacle.friction = rigidbody->GetFriction();
+        obstacle.restitution = rigidbody->GetRestitution();
+
+        switch (collision->GetCollisionType())
+        {
+        case CollisionType::Heightfield:
+            obstacle.heightfield = static_cast<const HeightfieldCollisionComponent*>(collision);
+            break;
+        case CollisionType::Sphere:
+            obstacle.radius = static_cast<const SphereCollisionComponent*>(collision)->GetRadius();
+            break;
+        case CollisionType::Box:
+        case CollisionType::Mesh:
+        {
+            // Same oriented box as CollisionDetection::IsCollidingBoxSphere
+            Box bounds = static_cast<const BoxCollisionComponent*>(collision)->GetBoundingBox();
+            Vec3 localCenter = (bounds.min + bounds.max) * 0.5f;
+            Vec3 halfSize = (bounds.max - bounds.min) * 0.5f;
+            obstacle.center += obstacle.axes[0] * localCenter.x + obstacle.axes[1] * localCenter.y + obstacle.axes[2] * localCenter.z;
+            obstacle.halfSize[0] = halfSize.x;
+            obstacle.halfSize[1] = halfSize.y;
+            obstacle.halfSize[2] = halfSize.z;
+            break;
+        }
+        default:
+            continue;
+        }
+
+        mPredictionObstacles.push_back(obstacle);
+    }
+}
+
+bool PhysicEngine::FindPredictionContact(const PredictionObstacle& pObstacle, const Vec3& pCenter, float pRadius, Vec3& pOutNormal, float& pOutDepth)
+{
+    if (pObstacle.heightfield)
+    {
+        Vec3 point;
+        return pObstacle.heightfield->IntersectSphere(pCenter, pRadius, point, pOutNormal, pOutDepth);
+    }
+
+    Vec3 delta = pCenter - pObstacle.center;
+    Vec3 closestPoint = pObstacle.center;
+    float projections[3];
+    for (int i = 0; i < 3; i++)
+    {
+        projections[i] = Vec3::Dot(delta, pObstacle.axes[i]);
+        closestPoint += pObstacle.axes[i] * std::clamp(projections[i], -pObstacle.halfSize[i], pObstacle.halfSize[i]);
+    }
+
+    float reach = pRadius + pObstacle.radius;
+    Vec3 difference = pCenter - closestPoint;
+    float distanceSquared = difference.LengthSq();
+    if (distanceSquared > reach * reach) return false;
+
+    if (distanceSquared > EPSILON)
+    {
+        float distance = sqrtf(distanceSquared);
+        pOutNormal = difference / distance;
+        pOutDepth = reach - distance;
+        return true;
+    }
+
+    // Center inside the box, push out through the closest face
+    int axis = 0;
+    float overlap = pObstacle.halfSize[0] - fabs(projections[0]);
+    for (int i = 1; i < 3; i++)
+    {
+        float axisOverlap = pObstacle.halfSize[i] - fabs(projections[i]);
+        if (axisOverlap < overlap)
+        {
+            overlap = axisOverlap;
+            axis = i;
+        }
+    }
+    pOutNormal = projections[axis] < 0.0f ? -pObstacle.axes[axis] : pObstacle.axes[axis];
+    pOutDepth = overlap + reach;
+    return true;
 }
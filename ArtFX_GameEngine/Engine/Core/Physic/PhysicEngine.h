@@ -4,31 +4,88 @@
  */
 
 #pragma once
+#include <atomic>
 #include <deque>
+#include <vector>
 
 #include "Constraint.h"
+#include "RigidbodyHandle.h"
+
+class HeightfieldCollisionComponent;
 
 /**
  * @class PhysicEngine
- * @brief Singleton class that manages all physics simulation, rigidbody components, and constraints.
+ * @brief Manages physics simulation, rigidbody components, and constraints.
+ *
+ * Each Scene owns its world. Other instances can be created to run independent simulations,
+ * and bound to a thread so the components built on it register there. Different instances share
+ * no state and can be stepped concurrently, each from a single thread.
  */
 class PhysicEngine
 {
 private:
     /**
-     * @brief Private constructor for singleton pattern.
+     * @brief Instance bound to the current thread, or nullptr to use the default instance.
      */
-    PhysicEngine();
+    static thread_local PhysicEngine* ThreadInstance;
 
     /**
-     * @brief Destructor, cleans up constraints.
+     * @struct RigidbodySlot
+     * @brief Entry of the handle registry, pointing to a rigidbody in the dense array.
      */
-    ~PhysicEngine();
+    struct RigidbodySlot
+    {
+        /**
+         * @brief Index of the rigidbody in the dense array, or InvalidIndex if the slot is free.
+         */
+        uint32_t denseIndex = RigidbodyHandle::InvalidIndex;
+
+        /**
+         * @brief Current generation of the slot.
+         */
+        uint32_t generation = 0;
+    };
+
+    /**
+     * @brief Contiguous list of all registered rigidbody components.
+     */
+    std::vector<RigidbodyComponent*> mRigidbodyComponents;
+
+    /**
+     * @brief Slot index of each rigidbody in the dense array (parallel to mRigidbodyComponents).
+     */
+    std::vector<uint32_t> mDenseToSlot;
+
+    /**
+     * @brief Handle registry, indexed by RigidbodyHandle::index.
+     */
+    std::vector<RigidbodySlot> mSlots;
 
     /**
-     * @brief List of all registered rigidbody components.
+     * @brief Indices of the released slots, reused by the next registrations.
      */
-    std::deque<RigidbodyComponent*> mRigidbodyComponents;
+    std::vector<uint32_t> mFreeSlots;
+
+    /**
+     * @brief Rigidbodies removed during a step, released at the end of the step. Their dense entry is nullptr until then.
+     */
+    std::vector<RigidbodyHandle> mPendingRemovals;
+
+    /**
+     * @brief Whether the simulation is currently being stepped.
+     */
+    std::atomic<bool> mStepping = false;
+
+    /**
+     * @brief Releases a slot and swaps the last rigidbody into its dense index.
+     * @param pHandle Handle of the rigidbody to release.
+     */
+    void ReleaseRigidbody(RigidbodyHandle pHandle);
+
+    /**
+     * @brief Releases every rigidbody removed during the last step.
+     */
+    void FlushPendingRemovals();
 
     /**
      * @brief List of all registered constraints.
@@ -45,15 +102,111 @@ private:
      */
     std::deque<Vec3> mTorques;
 
+    /**
+     * @struct PredictionObstacle
+     * @brief Static collider copied into flat data for trajectory predictions.
+     *
+     * Boxes and meshes are kept as oriented boxes, spheres as a box of zero size rounded by their radius.
+     */
+    struct PredictionObstacle
+    {
+        /**
+         * @brief Center of the box in world space.
+         */
+        Vec3 center;
+
+        /**
+         * @brief Axes of the box in world space.
+         */
+        Vec3 axes[3];
+
+        /**
+         * @brief Half size of the box along each axis.
+         */
+        float halfSize[3] = { 0.0f, 0.0f, 0.0f };
+
+        /**
+         * @brief Radius added around the box.
+         */
+        float radius = 0.0f;
+
+        /**
+         * @brief Friction coefficient of the collider.
+         */
+        float friction = 0.0f;
+
+        /**
+         * @brief Restitution coefficient of the collider.
+         */
+        float restitution = 0.0f;
+
+        /**
+         * @brief Terrain to query instead of the box, or nullptr.
+         */
+        const HeightfieldCollisionComponent* heightfield = nullptr;
+    };
+
+    /**
+     * @brief Static colliders of the last prediction. Kept between calls to avoid reallocations.
+     */
+    std::vector<PredictionObstacle> mPredictionObstacles;
+
+    /**
+     * @brief Positions of the last predicted trajectory. Kept between calls to avoid reallocations.
+     */
+    std::vector<Vec3> mPredictionPoints;
+
+    /**
+     * @brief Copies the static colliders of the world into mPredictionObstacles.
+     * @param pBody The predicted body, skipped if it is registered.
+     */
+    void GatherPredictionObstacles(const RigidbodyComponent* pBody);
+
+    /**
+     * @brief Finds the contact between a sphere and a static collider.
+     * @param pObstacle The static collider.
+     * @param pCenter Center of the sphere in world space.
+     * @param pRadius Radius of the sphere.
+     * @param pOutNormal Output contact normal, pointing out of the collider.
+     * @param pOutDepth Output penetration depth.
+     * @return True if the sphere touches the collider.
+     */
+    static bool FindPredictionContact(const PredictionObstacle& pObstacle, const Vec3& pCenter, float pRadius, Vec3& pOutNormal, float& pOutDepth);
+
 public:
     /**
-     * @brief Gets the singleton instance of the PhysicEngine.
-     * @return Reference to the PhysicEngine instance.
+     * @brief Constructs an empty simulation.
      */
-    static PhysicEngine& GetInstance()
+    PhysicEngine();
+
+    /**
+     * @brief Destructor, cleans up constraints.
+     */
+    ~PhysicEngine();
+
+    /**
+     * @brief Gets the default world of the current thread.
+     * @return Reference to the instance bound to the thread, else to the world of the active scene,
+     * else to a process wide fallback instance.
+     */
+    static PhysicEngine& GetInstance();
+
+    /**
+     * @brief Binds a PhysicEngine to the current thread. Rigidbodies created afterwards on this thread register in it.
+     * @param pPhysicEngine The instance to bind, or nullptr to go back to the default instance.
+     */
+    static void SetThreadInstance(PhysicEngine* pPhysicEngine)
+    {
+        ThreadInstance = pPhysicEngine;
+    }
+
+    /**
+     * @brief Gets the PhysicEngine bound to the current thread.
+     * @return The bound instance, or nullptr if none is bound.
+     */
+    static PhysicEngine* GetThreadInstance()
     {
-        static PhysicEngine instance;
-        return instance;
+        return ThreadInstance;
     }
 
     /**
@@ -72,17 +225,51 @@ public:
     void Update();
 
     /**
-     * @brief Adds a rigidbody to the simulation.
+     * @brief Predicts the path of a body after an impulse, colliding against static geometry only.
+     * The body state is copied, the world is left untouched and, once the internal buffers are warm,
+     * no memory is allocated, so it can be called every frame.
+     * @param pBody The body to predict, registered or not. Its collider, else its mesh, gives the radius of the sphere used for contacts.
+     * @param pImpulse Linear impulse applied before the first step.
+     * @param pSteps Number of DELTA_STEP steps to simulate.
+     * @param pAngularImpulse Angular impulse applied before the first step.
+     * @return The positions of the body after each step. Valid until the next call.
+     */
+    const std::vector<Vec3>& PredictTrajectory(const RigidbodyComponent* pBody, const Vec3& pImpulse, int pSteps, const Vec3& pAngularImpulse = Vec3::zero);
+
+    /**
+     * @brief Adds a rigidbody to the simulation, removing it from the world it was simulated in before.
      * @param rigidbody Pointer to the RigidbodyComponent to add.
+     * @return Handle of the rigidbody, also stored on the component.
      */
-    void AddRigidbody(RigidbodyComponent* rigidbody);
+    RigidbodyHandle AddRigidbody(RigidbodyComponent* rigidbody);
 
     /**
-     * @brief Removes a rigidbody from the simulation.
+     * @brief Removes a rigidbody from the simulation in O(1).
+     * Removals requested while the simulation is stepping are applied at the end of the step.
      * @param rigidbody Pointer to the RigidbodyComponent to remove.
      */
     void RemoveRigidbody(RigidbodyComponent* rigidbody);
 
+    /**
+     * @brief Removes the rigidbody referenced by a handle from the simulation.
+     * @param pHandle Handle of the rigidbody to remove. Stale handles are ignored.
+     */
+    void RemoveRigidbody(RigidbodyHandle pHandle);
+
+    /**
+     * @brief Checks if a handle still references a registered rigidbody.
+     * @param pHandle The handle to check.
+     * @return True if the rigidbody is still registered, false otherwise.
+     */
+    bool IsValid(RigidbodyHandle pHandle) const;
+
+    /**
+     * @brief Gets the rigidbody referenced by a handle.
+     * @param pHandle The handle of the rigidbody.
+     * @return Pointer to the rigidbody, or nullptr if the handle is stale.
+     */
+    RigidbodyComponent* GetRigidbody(RigidbodyHandle pHandle) const;
+
     /**
      * @brief Gets the list of constraints.
      * @return Reference to the deque of Constraint pointers.
@@ -94,9 +281,9 @@ public:
 
     /**
      * @brief Gets the list of rigidbodies.
-     * @return Reference to the deque of RigidbodyComponent pointers.
+     * @return Reference to the contiguous list of RigidbodyComponent pointers, nullptr for a rigidbody removed during the running step.
      */
-    std::deque<RigidbodyComponent*>& GetRigidbodies()
+    const std::vector<RigidbodyComponent*>& GetRigidbodies() const
     {
         return mRigidbodyComponents;
     }
@@ -0,0 +1,51 @@
+/**
+ * @file RigidbodyHandle.h
+ * @brief Defines the RigidbodyHandle struct, a generational handle to a rigidbody registered in the PhysicEngine.
+ */
+
+#pragma once
+#include <cstdint>
+
+/**
+ * @struct RigidbodyHandle
+ * @brief Generational handle identifying a rigidbody slot in the PhysicEngine registry.
+ *
+ * The generation is bumped every time a slot is released, so a handle kept after
+ * its rigidbody was removed is detected as stale instead of aliasing a new body.
+ */
+struct RigidbodyHandle
+{
+    /**
+     * @brief Index value used by handles that do not reference any slot.
+     */
+    static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+    /**
+     * @brief Index of the slot in the registry.
+     */
+    uint32_t index = InvalidIndex;
+
+    /**
+     * @brief Generation of the slot when the handle was created.
+     */
+    uint32_t generation = 0;
+
+    /**
+     * @brief Checks if the handle references a slot.
+     * @return True if the handle was issued by the registry, false otherwise.
+     */
+    bool IsValid() const
+    {
+        return index != InvalidIndex;
+    }
+
+    /**
+     * @brief Compares two handles.
+     * @param pOther The other handle.
+     * @return True if both handles reference the same slot and generation.
+     */
+    bool operator==(const RigidbodyHandle& pOther) const
+    {
+        return index == pOther.index && generation == pOther.generation;
+    }
+};
@@ -2,6 +2,7 @@
 
 #include "PhysicEngine.h"
 #include "Component/BoxCollisionComponent.h"
+#include "Component/HeightfieldCollisionComponent.h"
 #include "Component/RigidbodyComponent.h"
 #include "Core/Class/Actor/Actor.h"
 #include "Core/Class/Mesh/Mesh.h"
@@ -12,8 +13,23 @@ HitResult TraceSystem::LineTrace(Vec3& start, Vec3& end, RigidbodyComponent* sel
     Vec3 dir = Vec3::Normalize(end - start);
     float maxDist = start.Distance(end);
 
-    for (RigidbodyComponent* rigidbody : PhysicEngine::GetInstance().GetRigidbodies()) {
-        if (ignoreSelf && rigidbody == self) continue;
+    PhysicEngine& world = self && self->GetPhysicEngine() ? *self->GetPhysicEngine() : PhysicEngine::GetInstance();
+    for (RigidbodyComponent* rigidbody : world.GetRigidbodies()) {
+        if (!rigidbody || (ignoreSelf && rigidbody == self)) continue;
+
+        if (rigidbody->GetCollisionComponent()->GetCollisionType() == CollisionType::Heightfield) {
+            HeightfieldCollisionComponent* heightfield = static_cast<HeightfieldCollisionComponent*>(rigidbody->GetCollisionComponent());
+            float t = 0.0f;
+            Vec3 normal;
+            if (heightfield->Raycast(start, dir, maxDist, t, normal) && t < result.distance) {
+                result.hit = true;
+                result.distance = t;
+                result.hitPoint = start + dir * t;
+                result.hitNormal = normal;
+                result.hitActor = rigidbody->GetOwner();
+            }
+            continue;
+        }
         
         BoxCollisionComponent* col = dynamic_cast<BoxCollisionComponent*>(rigidbody->GetCollisionComponent());
         if (!col) continue;
@@ -33,7 +49,6 @@ HitResult TraceSystem::LineTrace(Vec3& start, Vec3& end, RigidbodyComponent* sel
                 result.hitPoint = start + dir * t;
                 result.hitNormal = normal;
                 result.hitActor = rigidbody->GetOwner();
-                return result;
             }
         }
     }
@@ -7,7 +7,9 @@
 
 #include <sstream>
 
+#include "AssetLoader.h"
 #include "RendererSdl.h"
+#include "Core/Class/Mesh/MeshOptimizer.h"
 #include "Debug/Log.h"
 #include "tiny_obj_loader.h"
 
@@ -21,9 +23,16 @@
 
 std::map<std::string, Texture> Asset::mTextures = {};
 std::map<std::string, Mesh> Asset::mMeshes = {};
+AssetLoader* Asset::mStreamingLoader = nullptr;
+std::map<std::string, std::string> Asset::mMeshFiles = {};
 
 Texture Asset::LoadTexture(IRenderer& renderer, const std::string& filePath, const std::string& name)
 {
+    if (mStreamingLoader)
+    {
+        mStreamingLoader->RequestTexture(filePath, name);
+        return {};
+    }
     mTextures[name] = LoadTextureFromFile(renderer, filePath);
     return mTextures[name];
 }
@@ -48,11 +57,18 @@ Texture& Asset::GetTexture(const std::string& name)
  * @brief Loads a mesh from a file and stores it in the asset manager.
  * @param pFileName Path to the mesh file.
  * @param pName Name to associate with the loaded mesh.
+ * @param pUploadToGpu Whether to upload the mesh to the GPU. False for headless simulations.
  * @return The loaded mesh.
  */
-Mesh Asset::LoadMesh(const std::string& pFileName, const std::string& pName)
+Mesh Asset::LoadMesh(const std::string& pFileName, const std::string& pName, bool pUploadToGpu)
 {
-    mMeshes[pName] = LoadMeshFromFile(pFileName);
+    mMeshFiles[pName] = pFileName;
+    if (mStreamingLoader)
+    {
+        mStreamingLoader->RequestMesh(pFileName, pName, pUploadToGpu);
+        return {};
+    }
+    mMeshes[pName] = LoadMeshFromFile(pFileName, pUploadToGpu);
     return mMeshes[pName];
 }
 
@@ -70,6 +86,17 @@ Mesh& Asset::GetMesh(const std::string& pName)
     return mMeshes[pName];
 }
 
+/**
+ * @brief Gets the file a mesh was loaded from.
+ * @param pName Name of the mesh.
+ * @return Path to the mesh file relative to Resources/Meshes, empty if the mesh was not loaded from a file.
+ */
+std::string Asset::GetMeshFileName(const std::string& pName)
+{
+    auto file = mMeshFiles.find(pName);
+    return file != mMeshFiles.end() ? file->second : std::string();
+}
+
 /**
  * @brief Clears all loaded assets from the asset manager.
  */
@@ -82,6 +109,15 @@ void Asset::Clear()
     mTextures.clear();
 }
 
+/**
+ * @brief Redirects LoadTexture and LoadMesh to a streaming loader, so a scene Load only queues its assets.
+ * @param pLoader The loader, or nullptr to load synchronously again.
+ */
+void Asset::SetStreamingLoader(AssetLoader* pLoader)
+{
+    mStreamingLoader = pLoader;
+}
+
 /**
  * @brief Loads a texture from a file.
  * @param renderer Reference to the renderer.
@@ -98,11 +134,31 @@ Texture Asset::LoadTextureFromFile(IRenderer& renderer, const std::string& fileP
 /**
  * @brief Loads a mesh from a file.
  * @param pFileName Path to the mesh file.
+ * @param pUploadToGpu Whether to upload the mesh to the GPU.
  * @return The loaded mesh.
  */
-Mesh Asset::LoadMeshFromFile(const std::string& pFileName)
+Mesh Asset::LoadMeshFromFile(const std::string& pFileName, bool pUploadToGpu)
+{
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    if (!ReadMeshFile(pFileName, vertices, indices))
+    {
+        return Mesh();
+    }
+    return Mesh(std::move(vertices), std::move(indices), pUploadToGpu);
+}
+
+/**
+ * @brief Reads the vertices of a mesh file. Does not touch the GPU nor the asset maps, so it can run on any thread.
+ * The corners of the triangles are welded into unique vertices, then the triangles are ordered for the
+ * post-transform vertex cache and the vertices for the order they are fetched in.
+ * @param pFileName Path to the mesh file, relative to Resources/Meshes.
+ * @param pOutVertices Receives the unique vertices.
+ * @param pOutIndices Receives three indices per triangle, ordered for the post-transform vertex cache.
+ * @return True if the file was read.
+ */
+bool Asset::ReadMeshFile(const std::string& pFileName, std::vector<Vertex>& pOutVertices, std::vector<unsigned int>& pOutIndices)
 {
-    Mesh loaded;
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
     std::vector<tinyobj::material_t> materials;
@@ -112,11 +168,7 @@ Mesh Asset::LoadMeshFromFile(const std::string& pFileName)
     if (!succes)
     {
         Log::Error(LogType::Error, "Mesh + " + pFileName + " could not be loaded");
-        return Mesh();
-    }
-    else
-    {
-        Log::Info("Mesh " + pFileName + " loaded");
+        return false;
     }
     std::vector<Vertex> vertices;
     for (int i = 0; i < shapes.size(); i++)
@@ -147,5 +199,13 @@ Mesh Asset::LoadMeshFromFile(const std::string& pFileName)
             vertices.push_back(vert);
         }
     }
-    return Mesh(vertices);
+
+    MeshOptimizer::WeldVertices(vertices, pOutVertices, pOutIndices);
+    float soupMissRatio = MeshOptimizer::GetAverageCacheMissRatio(pOutIndices, pOutVertices.size());
+    MeshOptimizer::OptimizeVertexCache(pOutIndices, pOutVertices.size());
+    MeshOptimizer::OptimizeVertexFetch(pOutVertices, pOutIndices);
+    Log::Info("Mesh " + pFileName + " loaded : " + std::to_string(vertices.size()) + " corners welded into " +
+        std::to_string(pOutVertices.size()) + " vertices, cache miss ratio " + std::to_string(soupMissRatio) + " -> " +
+        std::to_string(MeshOptimizer::GetAverageCacheMissRatio(pOutIndices, pOutVertices.size())));
+    return true;
 }
@@ -11,6 +11,7 @@
 
 #define TINYOBJLOADER_IMPLEMENTATION
 
+class AssetLoader;
 class IRenderer;
 
 /**
@@ -32,6 +33,7 @@ public:
 
     /**
      * @brief Loads a texture from a file and stores it in the asset manager.
+     * While a streaming loader is set, the texture is only requested from it and an empty texture is returned.
      * @param renderer Reference to the renderer.
      * @param filePath Path to the texture file.
      * @param name Name to associate with the loaded texture.
@@ -48,11 +50,13 @@ public:
 
     /**
      * @brief Loads a mesh from a file and stores it in the asset manager.
+     * While a streaming loader is set, the mesh is only requested from it and an empty mesh is returned.
      * @param pFileName Path to the mesh file.
      * @param pName Name to associate with the loaded mesh.
+     * @param pUploadToGpu Whether to upload the mesh to the GPU. False for headless simulations.
      * @return The loaded mesh.
      */
-    static Mesh LoadMesh(const std::string& pFileName, const std::string& pName);
+    static Mesh LoadMesh(const std::string& pFileName, const std::string& pName, bool pUploadToGpu = true);
 
     /**
      * @brief Retrieves a mesh by name.
@@ -66,12 +70,44 @@ public:
      */
     static void Clear();
 
+    /**
+     * @brief Redirects LoadTexture and LoadMesh to a streaming loader, so a scene Load only queues its assets.
+     * @param pLoader The loader, or nullptr to load synchronously again.
+     */
+    static void SetStreamingLoader(AssetLoader* pLoader);
+
+    /**
+     * @brief Reads the vertices of a mesh file. Does not touch the GPU nor the asset maps, so it can run on any thread.
+     * @param pFileName Path to the mesh file, relative to Resources/Meshes.
+     * @param pOutVertices Receives the unique vertices.
+     * @param pOutIndices Receives three indices per triangle, ordered for the post-transform vertex cache.
+     * @return True if the file was read.
+     */
+    static bool ReadMeshFile(const std::string& pFileName, std::vector<Vertex>& pOutVertices, std::vector<unsigned int>& pOutIndices);
+
+    /**
+     * @brief Gets the file a mesh was loaded from.
+     * @param pName Name of the mesh.
+     * @return Path to the mesh file relative to Resources/Meshes, empty if the mesh was not loaded from a file.
+     */
+    static std::string GetMeshFileName(const std::string& pName);
+
 private:
     /**
      * @brief Private constructor to prevent instantiation.
      */
     Asset() = default;
 
+    /**
+     * @brief Loader receiving the load requests, nullptr when loading synchronously.
+     */
+    static AssetLoader* mStreamingLoader;
+
+    /**
+     * @brief File of each mesh loaded with LoadMesh, by mesh name.
+     */
+    static std::map<std::string, std::string> mMeshFiles;
+
     /**
      * @brief Loads a texture from a file.
      * @param renderer Reference to the renderer.
@@ -83,7 +119,8 @@ private:
     /**
      * @brief Loads a mesh from a file.
      * @param pFileName Path to the mesh file.
+     * @param pUploadToGpu Whether to upload the mesh to the GPU.
      * @return The loaded mesh.
      */
-    static Mesh LoadMeshFromFile(const std::string& pFileName);
+    static Mesh LoadMeshFromFile(const std::string& pFileName, bool pUploadToGpu);
 };
@@ -0,0 +1,196 @@
+/**
+ * @file AssetLoader.cpp
+ * @brief Implementation of the AssetLoader class, which streams the assets of a scene in the background.
+ */
+
+#include "AssetLoader.h"
+
+#include <chrono>
+#include "Asset.h"
+#include "Debug/Log.h"
+#include "Debug/Profiler.h"
+
+/**
+ * @brief Constructs an empty loader.
+ * @param pRenderer Renderer creating the textures.
+ */
+AssetLoader::AssetLoader(IRenderer& pRenderer) : mRenderer(pRenderer)
+{
+}
+
+/**
+ * @brief Stops the decode threads and releases what was not committed.
+ */
+AssetLoader::~AssetLoader()
+{
+    mStopping = true;
+    for (std::thread& worker : mWorkers)
+    {
+        worker.join();
+    }
+
+    for (AssetRequest& request : mRequests)
+    {
+        if (request.surface)
+        {
+            SDL_FreeSurface(request.surface);
+        }
+    }
+    for (auto& texture : mTextures)
+    {
+        texture.second.unload();
+    }
+    for (auto& mesh : mMeshes)
+    {
+        mesh.second.Unload();
+    }
+}
+
+/**
+ * @brief Requests a texture. Only valid before Start.
+ * @param pFilePath Path to the texture file.
+ * @param pName Name of the texture in the asset manager.
+ */
+void AssetLoader::RequestTexture(const std::string& pFilePath, const std::string& pName)
+{
+    AssetRequest& request = mRequests.emplace_back();
+    request.filePath = pFilePath;
+    request.name = pName;
+}
+
+/**
+ * @brief Requests a mesh. Only valid before Start.
+ * @param pFileName Path to the mesh file, relative to Resources/Meshes.
+ * @param pName Name of the mesh in the asset manager.
+ * @param pUploadToGpu Whether to upload the mesh to the GPU.
+ */
+void AssetLoader::RequestMesh(const std::string& pFileName, const std::string& pName, bool pUploadToGpu)
+{
+    AssetRequest& request = mRequests.emplace_back();
+    request.isMesh = true;
+    request.filePath = pFileName;
+    request.name = pName;
+    request.uploadToGpu = pUploadToGpu;
+}
+
+/**
+ * @brief Starts decoding the requests in the background.
+ * @param pThreadCount Number of decode threads.
+ */
+void AssetLoader::Start(int pThreadCount)
+{
+    Log::Info("Streaming " + std::to_string(mRequests.size()) + " assets");
+    for (int i = 0; i < pThreadCount; i++)
+    {
+        mWorkers.emplace_back(&AssetLoader::DecodeLoop, this);
+    }
+}
+
+/**
+ * @brief Loop of a decode thread: reads and decodes requests until none is left.
+ */
+void AssetLoader::DecodeLoop()
+{
+    PROFILE_THREAD_NAME("Asset decoder");
+    while (!mStopping)
+    {
+        size_t index = mNextRequest++;
+        if (index >= mRequests.size()) return;
+
+        PROFILE_SCOPE("Decode asset");
+        AssetRequest& request = mRequests[index];
+        if (request.isMesh)
+        {
+            std::vector<Vertex> vertices;
+            std::vector<unsigned int> indices;
+            if (Asset::ReadMeshFile(request.filePath, vertices, indices))
+            {
+                request.mesh = Mesh(std::move(vertices), std::move(indices), false);
+            }
+        }
+        else
+        {
+            request.surface = IMG_Load(request.filePath.c_str());
+            if (!request.surface)
+            {
+                Log::Error(LogType::Application, "Failed to load texture file : " + request.filePath);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mDecoded.push_back(index);
+    }
+}
+
+/**
+ * @brief Uploads decoded requests until the budget is spent. At least one request is uploaded if one is ready.
+ * @param pBudgetMs Time allowed, in milliseconds.
+ */
+void AssetLoader::Update(float pBudgetMs)
+{
+    auto start = std::chrono::steady_clock::now();
+    while (!IsReady())
+    {
+        size_t index;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mDecoded.empty()) return;
+            index = mDecoded.back();
+            mDecoded.pop_back();
+        }
+
+        {
+            PROFILE_SCOPE("Upload asset");
+            Upload(mRequests[index]);
+        }
+        mUploadedCount++;
+
+        std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= pBudgetMs) return;
+    }
+}
+
+/**
+ * @brief Creates the GPU resources of a decoded request. Failed requests still count as uploaded.
+ * @param pRequest The request.
+ */
+void AssetLoader::Upload(AssetRequest& pRequest)
+{
+    if (pRequest.isMesh)
+    {
+        if (pRequest.uploadToGpu && pRequest.mesh.GetVerticesCount() > 0)
+        {
+            pRequest.mesh.UploadToGpu();
+        }
+        mMeshes[pRequest.name] = std::move(pRequest.mesh);
+    }
+    else if (pRequest.surface)
+    {
+        mTextures[pRequest.name].LoadFromSurface(mRenderer, pRequest.filePath, pRequest.surface);
+        pRequest.surface = nullptr;
+    }
+}
+
+/**
+ * @brief Moves the uploaded assets into the asset manager. Call once IsReady, after unloading the previous scene.
+ * The base texture of the uploaded meshes is set here, once the textures of the new scene are in place.
+ */
+void AssetLoader::Commit()
+{
+    for (auto& texture : mTextures)
+    {
+        Asset::mTextures[texture.first] = texture.second;
+    }
+    mTextures.clear();
+
+    for (auto& mesh : mMeshes)
+    {
+        Mesh& committed = Asset::mMeshes[mesh.first];
+        committed = std::move(mesh.second);
+        if (committed.IsUploaded())
+        {
+            committed.AddTexture(&Asset::GetTexture("BaseTexture"));
+        }
+    }
+    mMeshes.clear();
+}
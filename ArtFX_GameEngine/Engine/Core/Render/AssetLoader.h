@@ -0,0 +1,197 @@
+/**
+ * @file AssetLoader.h
+ * @brief Declaration of the AssetLoader class, which streams the assets of a scene in the background.
+ */
+
+#pragma once
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Texture.h"
+#include "Core/Class/Mesh/Mesh.h"
+
+class IRenderer;
+
+/**
+ * @struct AssetRequest
+ * @brief A texture or mesh requested from an AssetLoader, filled by a decode thread.
+ */
+struct AssetRequest
+{
+    /**
+     * @brief Whether the request is a mesh, otherwise a texture.
+     */
+    bool isMesh = false;
+
+    /**
+     * @brief Path of the file, relative to Resources/Meshes for a mesh.
+     */
+    std::string filePath;
+
+    /**
+     * @brief Name of the asset in the asset manager.
+     */
+    std::string name;
+
+    /**
+     * @brief Whether the mesh is uploaded to the GPU.
+     */
+    bool uploadToGpu = true;
+
+    /**
+     * @brief Decoded texture, nullptr until decoded or if the file could not be read.
+     */
+    SDL_Surface* surface = nullptr;
+
+    /**
+     * @brief Decoded mesh, with its bounds and mass properties but not uploaded yet.
+     */
+    Mesh mesh;
+};
+
+/**
+ * @class AssetLoader
+ * @brief Loads a set of textures and meshes without blocking the main thread.
+ *
+ * Files are read and decoded by background threads: images into surfaces, meshes into vertices, bounds and
+ * mass properties. The main thread then creates the GPU resources in Update, a few at a time under a time budget,
+ * and Commit finally moves everything into the Asset maps at once, so the assets of the running scene are never
+ * replaced while it is drawn.
+ */
+class AssetLoader
+{
+private:
+    /**
+     * @brief Renderer creating the textures.
+     */
+    IRenderer& mRenderer;
+
+    /**
+     * @brief Requested assets. Not resized once the decode threads are started.
+     */
+    std::vector<AssetRequest> mRequests;
+
+    /**
+     * @brief Decode threads.
+     */
+    std::vector<std::thread> mWorkers;
+
+    /**
+     * @brief Next request to decode.
+     */
+    std::atomic<size_t> mNextRequest = 0;
+
+    /**
+     * @brief Whether the decode threads must stop before the next request.
+     */
+    std::atomic<bool> mStopping = false;
+
+    /**
+     * @brief Guards mDecoded.
+     */
+    std::mutex mMutex;
+
+    /**
+     * @brief Requests decoded and waiting to be uploaded.
+     */
+    std::vector<size_t> mDecoded;
+
+    /**
+     * @brief Requests uploaded by the main thread.
+     */
+    size_t mUploadedCount = 0;
+
+    /**
+     * @brief Uploaded textures, waiting for Commit.
+     */
+    std::map<std::string, Texture> mTextures;
+
+    /**
+     * @brief Uploaded meshes, waiting for Commit.
+     */
+    std::map<std::string, Mesh> mMeshes;
+
+    /**
+     * @brief Loop of a decode thread.
+     */
+    void DecodeLoop();
+
+    /**
+     * @brief Creates the GPU resources of a decoded request.
+     * @param pRequest The request.
+     */
+    void Upload(AssetRequest& pRequest);
+
+public:
+    /**
+     * @brief Default time given to Update each frame, in milliseconds.
+     */
+    static constexpr float DefaultFrameBudgetMs = 4.0f;
+
+    /**
+     * @brief Constructs an empty loader.
+     * @param pRenderer Renderer creating the textures.
+     */
+    explicit AssetLoader(IRenderer& pRenderer);
+
+    /**
+     * @brief Stops the decode threads and releases what was not committed.
+     */
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    /**
+     * @brief Requests a texture. Only valid before Start.
+     * @param pFilePath Path to the texture file.
+     * @param pName Name of the texture in the asset manager.
+     */
+    void RequestTexture(const std::string& pFilePath, const std::string& pName);
+
+    /**
+     * @brief Requests a mesh. Only valid before Start.
+     * @param pFileName Path to the mesh file, relative to Resources/Meshes.
+     * @param pName Name of the mesh in the asset manager.
+     * @param pUploadToGpu Whether to upload the mesh to the GPU.
+     */
+    void RequestMesh(const std::string& pFileName, const std::string& pName, bool pUploadToGpu);
+
+    /**
+     * @brief Starts decoding the requests in the background.
+     * @param pThreadCount Number of decode threads.
+     */
+    void Start(int pThreadCount = 2);
+
+    /**
+     * @brief Uploads decoded requests until the budget is spent. At least one request is uploaded if one is ready.
+     * @param pBudgetMs Time allowed, in milliseconds.
+     */
+    void Update(float pBudgetMs = DefaultFrameBudgetMs);
+
+    /**
+     * @brief Moves the uploaded assets into the asset manager. Call once IsReady, after unloading the previous scene.
+     */
+    void Commit();
+
+    /**
+     * @brief Checks if every request is uploaded.
+     * @return True if Commit can be called.
+     */
+    bool IsReady() const
+    {
+        return mUploadedCount == mRequests.size();
+    }
+
+    /**
+     * @brief Gets the loading progress.
+     * @return Uploaded requests over requested ones, between 0 and 1.
+     */
+    float GetProgress() const
+    {
+        return mRequests.empty() ? 1.0f : static_cast<float>(mUploadedCount) / static_cast<float>(mRequests.size());
+    }
+};
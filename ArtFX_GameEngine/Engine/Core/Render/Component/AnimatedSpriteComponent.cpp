@@ -44,3 +44,9 @@ void AnimatedSpriteComponent::Update()
     }
     SetTexture(*mAnimationTextures[static_cast<int>(mCurrentFrame)]);
 }
+
+// Only advances its own frame, so the scene can update the animated sprites of different actors in parallel
+ComponentAccess AnimatedSpriteComponent::GetAccess() const
+{
+    return { AccessOwner, AccessOwner };
+}
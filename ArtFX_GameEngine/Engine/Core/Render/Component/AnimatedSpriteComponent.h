@@ -5,6 +5,8 @@
 
 class AnimatedSpriteComponent : public SpriteComponent
 {
+    COMPONENT_TYPE(AnimatedSpriteComponent, SpriteComponent)
+    POOLED_COMPONENT(AnimatedSpriteComponent)
 private:
     std::vector<Texture*> mAnimationTextures;
     float mCurrentFrame;
@@ -22,4 +24,5 @@ public:
     void SetAnimationFps(float fps);
 
     void Update() override;  
+    ComponentAccess GetAccess() const override;
 };
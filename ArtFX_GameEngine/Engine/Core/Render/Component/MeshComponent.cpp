@@ -1,59 +1,93 @@
 ﻿#include "MeshComponent.h"
 
+#include <algorithm>
+
 #include "Core/Class/Actor/Actor.h"
 #include "Core/Class/Scene/Scene.h"
 #include "Core/Render/OpenGL/VertexArray.h"
-#include "Math/Time.h"
 
 MeshComponent::MeshComponent(Actor* pOwner) : Component(pOwner), mMesh(nullptr), mTextureIndex(0), mVisible(true)
 {
-    glPatchParameteri(GL_PATCH_VERTICES, 3);
+    if (Scene::ActiveScene) glPatchParameteri(GL_PATCH_VERTICES, 3);
 }
 
 MeshComponent::~MeshComponent()
 {
-    Scene::ActiveScene->GetRenderer().RemoveMesh(this);
+    if (mInRenderer && Scene::ActiveScene) Scene::ActiveScene->GetRenderer().RemoveMesh(this);
 }
 
-void MeshComponent::Draw(Matrix4Row viewProj)
+void MeshComponent::Draw(RenderState& pState)
 {
-    if (!mMesh) return;
+    if (!mMesh || !mMesh->GetShaderProgram()) return;
 
-    mTime += Time::deltaTime;
-    
-    Matrix4Row wt = mOwner->GetWorldTransform();
-    mMesh->GetShaderProgram().Use();
-    mMesh->GetShaderProgram().setMatrix4Row("uViewProj", viewProj);
-    mMesh->GetShaderProgram().setMatrix4Row("uWorldTransform", wt);
-    mMesh->GetShaderProgram().setInteger("uTessellationLevel", mTessellationLevel);
-    mMesh->GetShaderProgram().setVector2f("uTiling", mTiling);
-    mMesh->GetShaderProgram().setFloat("uDisplacementScale", mDisplacementScale);
-    mMesh->GetShaderProgram().setFloat("uTime", mTime);
-
-    //Active AlbedoTexture
-    glActiveTexture(GL_TEXTURE0);
-    Texture* albedoTexture = mMesh->GetTexture(mTextureIndex);
-    if (albedoTexture)
+    ShaderProgram& program = *mMesh->GetShaderProgram();
+    pState.BindProgram(program);
+    if (mUseTessellation)
     {
-        albedoTexture->SetActive();
+        //Tessellation displaces the vertices in mesh space, between the dequantization and the world transform
+        program.setMatrix4Row("uVertexTransform", mMesh->GetVertexTransform());
+        program.setMatrix4Row("uWorldTransform", mOwner->GetWorldTransform());
     }
-
-    //Active NoiseTexture
-    glActiveTexture(GL_TEXTURE1);
-    Texture* noiseTexture = mMesh->GetNoiseTexture();
-    if (noiseTexture)
+    else
     {
-        noiseTexture->SetActive();
+        program.setMatrix4Row("uWorldTransform", mMesh->GetVertexTransform() * mOwner->GetWorldTransform());
     }
+    program.setInteger("uTessellationLevel", mTessellationLevel);
+    program.setVector2f("uTiling", mTiling);
+    program.setFloat("uDisplacementScale", mDisplacementScale);
+
+    //Active AlbedoTexture and NoiseTexture
+    pState.BindTexture(0, mMesh->GetTexture(mTextureIndex));
+    pState.BindTexture(1, mMesh->GetNoiseTexture());
     
-    mMesh->GetVertexArray()->SetActive();
-    glDrawArrays(mUseTessellation ? GL_PATCHES : GL_TRIANGLES, 0, mMesh->GetVerticesCount());
+    pState.BindVertexArray(*mMesh->GetVertexArray());
+    pState.DrawElements(mUseTessellation ? GL_PATCHES : GL_TRIANGLES, mMesh->GetIndicesCount());
+}
+
+void MeshComponent::DrawInstanced(RenderState& pState, unsigned int pInstanceBuffer, size_t pInstanceOffset, int pInstanceCount)
+{
+    pState.BindProgram(*mMesh->GetInstancedShaderProgram());
+    pState.BindTexture(0, mMesh->GetTexture(mTextureIndex));
+    pState.BindTexture(1, mMesh->GetNoiseTexture());
+
+    pState.BindVertexArray(*mMesh->GetVertexArray());
+    mMesh->GetVertexArray()->SetInstanceTransforms(pInstanceBuffer, pInstanceOffset);
+    pState.DrawElementsInstanced(GL_TRIANGLES, mMesh->GetIndicesCount(), pInstanceCount);
+}
+
+bool MeshComponent::CanInstance() const
+{
+    return mMesh && !mUseTessellation && mMesh->GetInstancedShaderProgram();
+}
+
+uint64_t MeshComponent::GetDrawKey(RenderQueue& pQueue, float pDepth) const
+{
+    uint16_t material = pQueue.GetMaterialIndex(mMesh->GetTexture(mTextureIndex), mMesh->GetNoiseTexture());
+    return RenderQueue::MakeKey(mMesh->GetShaderProgram() ? mMesh->GetShaderProgram()->GetID() : 0, material, mMesh->GetVertexArray()->GetId(), pDepth);
+}
+
+void MeshComponent::GetWorldBoundingSphere(Vec3& pOutCenter, float& pOutRadius) const
+{
+    Box bounds = mMesh->GetBoundingBox();
+    Vec3 center = (bounds.min + bounds.max) * 0.5f;
+    Matrix4Row wt = mOwner->GetWorldTransform();
+    pOutCenter = Vec3(
+        center.x * wt.mat[0][0] + center.y * wt.mat[1][0] + center.z * wt.mat[2][0] + wt.mat[3][0],
+        center.x * wt.mat[0][1] + center.y * wt.mat[1][1] + center.z * wt.mat[2][1] + wt.mat[3][1],
+        center.x * wt.mat[0][2] + center.y * wt.mat[1][2] + center.z * wt.mat[2][2] + wt.mat[3][2]);
+
+    Vec3 scale = wt.GetScale();
+    pOutRadius = (bounds.max - bounds.min).Length() * 0.5f * std::max({scale.x, scale.y, scale.z});
 }
 
 void MeshComponent::SetMesh(Mesh& mesh)
 {
     mMesh = &mesh;
-    Scene::ActiveScene->GetRenderer().AddMesh(this);
+    if (!mInRenderer && Scene::ActiveScene)
+    {
+        Scene::ActiveScene->GetRenderer().AddMesh(this);
+        mInRenderer = true;
+    }
 }
 
 void MeshComponent::SetTextureIndex(size_t pTextureIndex)
@@ -6,6 +6,7 @@
 #pragma once
 #include "Core/Class/Component/Component.h"
 #include "Core/Class/Mesh/Mesh.h"
+#include "Core/Render/RenderQueue.h"
 
 /**
  * @class MeshComponent
@@ -13,6 +14,8 @@
  */
 class MeshComponent : public Component
 {
+    COMPONENT_TYPE(MeshComponent, Component)
+    POOLED_COMPONENT(MeshComponent)
 protected:
     /**
      * @brief Pointer to the mesh associated with this component.
@@ -34,6 +37,11 @@ protected:
      */
     bool mUseTessellation = false;
 
+    /**
+     * @brief Whether the component is registered in the renderer of the active scene.
+     */
+    bool mInRenderer = false;
+
     /**
      * @brief Scale factor for displacement mapping.
      */
@@ -49,11 +57,6 @@ protected:
      */
     Vec2 mTiling = Vec2(1.0f, 1.0f);
 
-    /**
-     * @brief Time variable used for animations or effects.
-     */
-    float mTime = 0.0f;
-
 public:
     /**
      * @brief Constructs a MeshComponent and initializes rendering properties.
@@ -67,10 +70,40 @@ public:
     virtual ~MeshComponent();
 
     /**
-     * @brief Draws the mesh using the specified view-projection matrix.
-     * @param viewProj The view-projection matrix.
+     * @brief Draws the mesh. The view-projection matrix and the time come from the frame data.
+     * @param pState State bound by the previous draws, only what differs is bound again.
+     */
+    virtual void Draw(RenderState& pState);
+
+    /**
+     * @brief Draws the mesh of this component once per world transform of the instance buffer.
+     * @param pState State bound by the previous draws, only what differs is bound again.
+     * @param pInstanceBuffer Buffer of the world transforms.
+     * @param pInstanceOffset Offset of the first world transform in the buffer, in bytes.
+     * @param pInstanceCount Number of instances.
      */
-    virtual void Draw(Matrix4Row viewProj);
+    void DrawInstanced(RenderState& pState, unsigned int pInstanceBuffer, size_t pInstanceOffset, int pInstanceCount);
+
+    /**
+     * @brief Checks if the mesh can be drawn with other components in an instanced call.
+     * @return True if the mesh has an instanced program and is not tessellated.
+     */
+    bool CanInstance() const;
+
+    /**
+     * @brief Builds the key sorting the mesh in the render queue.
+     * @param pQueue The queue the mesh is submitted to, which gives the index of its textures.
+     * @param pDepth Distance to the camera, 0 at the camera and 1 at the far plane.
+     * @return The key.
+     */
+    uint64_t GetDrawKey(RenderQueue& pQueue, float pDepth) const;
+
+    /**
+     * @brief Gets the sphere bounding the mesh in world space, built on its bounding box.
+     * @param pOutCenter Receives the center of the sphere.
+     * @param pOutRadius Receives the radius, scaled by the largest scale of the world transform.
+     */
+    void GetWorldBoundingSphere(Vec3& pOutCenter, float& pOutRadius) const;
 
     // Getter and Setter methods
 
@@ -86,6 +119,15 @@ public:
      */
     void SetTextureIndex(size_t pTextureIndex);
 
+    /**
+     * @brief Gets the index of the texture used for rendering.
+     * @return Index of the texture in the textures of the mesh.
+     */
+    size_t GetTextureIndex() const
+    {
+        return mTextureIndex;
+    }
+
     /**
      * @brief Adds a texture to the mesh associated with this component.
      * @param pTexture Reference to the texture object.
@@ -107,6 +149,23 @@ public:
         return mVisible;
     }
 
+    /**
+     * @brief Checks if the component is registered in the renderer.
+     * @return True once a mesh was set with an active scene, until the component is removed.
+     */
+    bool IsInRenderer() const
+    {
+        return mInRenderer;
+    }
+
+    /**
+     * @brief Marks the component as removed from the renderer by a batch, so the destructor skips it.
+     */
+    void DetachFromRenderer()
+    {
+        mInRenderer = false;
+    }
+
     /**
      * @brief Gets the mesh associated with this component.
      * @return Pointer to the mesh object.
@@ -125,6 +184,15 @@ public:
         mUseTessellation = pUseTessellation;
     }
 
+    /**
+     * @brief Checks if tessellation is enabled.
+     * @return True if the mesh is drawn as tessellated patches.
+     */
+    bool GetUseTessellation() const
+    {
+        return mUseTessellation;
+    }
+
     /**
      * @brief Sets the scale factor for displacement mapping.
      * @param pDisplacementScale Scale factor for displacement.
@@ -134,6 +202,15 @@ public:
         mDisplacementScale = pDisplacementScale;
     }
 
+    /**
+     * @brief Gets the scale factor for displacement mapping.
+     * @return Scale factor for displacement.
+     */
+    float GetDisplacementScale() const
+    {
+        return mDisplacementScale;
+    }
+
     /**
      * @brief Sets the level of tessellation to be applied.
      * @param pTessellationLevel Level of tessellation.
@@ -143,6 +220,15 @@ public:
         mTessellationLevel = pTessellationLevel;
     }
 
+    /**
+     * @brief Gets the level of tessellation.
+     * @return Level of tessellation.
+     */
+    int GetTessellationLevel() const
+    {
+        return mTessellationLevel;
+    }
+
     /**
      * @brief Sets the tiling factor for texture mapping.
      * @param pTiling Tiling factor as a Vec2 object.
@@ -151,4 +237,13 @@ public:
     {
         mTiling = pTiling;
     }
+
+    /**
+     * @brief Gets the tiling factor for texture mapping.
+     * @return Tiling factor as a Vec2 object.
+     */
+    Vec2 GetTiling() const
+    {
+        return mTiling;
+    }
 };
@@ -6,6 +6,7 @@
 
 class SpriteComponent : public Component
 {
+    COMPONENT_TYPE(SpriteComponent, Component)
 protected:
     Texture mTexture;
     int mDrawOrder;
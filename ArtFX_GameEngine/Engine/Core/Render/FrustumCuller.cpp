@@ -0,0 +1,123 @@
+/**
+ * @file FrustumCuller.cpp
+ * @brief Implementation of the FrustumCuller class, which tests bounding spheres against the view frustum.
+ */
+
+#include "FrustumCuller.h"
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#define FRUSTUM_CULLER_SSE
+#include <xmmintrin.h>
+#endif
+
+/**
+ * @brief Extracts the frustum planes from a view projection. A point is inside when -w <= x, y, z <= w in clip space.
+ * @param pViewProj View projection, row vectors multiplied on the left.
+ */
+void FrustumCuller::SetViewProj(const Matrix4Row& pViewProj)
+{
+    // A clip coordinate is the dot product of the point with a column of the matrix
+    for (int axis = 0; axis < 3; axis++)
+    {
+        for (int row = 0; row < 4; row++)
+        {
+            mPlanes[axis * 2][row] = pViewProj.mat[row][3] + pViewProj.mat[row][axis];
+            mPlanes[axis * 2 + 1][row] = pViewProj.mat[row][3] - pViewProj.mat[row][axis];
+        }
+    }
+
+    // Normalized, the plane equation gives the distance to the plane
+    for (float* plane : mPlanes)
+    {
+        float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (length <= 0.0f) continue;
+        for (int i = 0; i < 4; i++)
+        {
+            plane[i] /= length;
+        }
+    }
+}
+
+/**
+ * @brief Removes every sphere.
+ */
+void FrustumCuller::Clear()
+{
+    mCentersX.clear();
+    mCentersY.clear();
+    mCentersZ.clear();
+    mRadii.clear();
+    mCount = 0;
+    mVisibleCount = 0;
+}
+
+/**
+ * @brief Adds a sphere to test.
+ * @param pCenter Center in world space.
+ * @param pRadius Radius in world space, infinite to never cull the sphere.
+ * @return Index of the sphere, to read its result.
+ */
+size_t FrustumCuller::AddSphere(const Vec3& pCenter, float pRadius)
+{
+    mCentersX.push_back(pCenter.x);
+    mCentersY.push_back(pCenter.y);
+    mCentersZ.push_back(pCenter.z);
+    mRadii.push_back(pRadius);
+    return mCount++;
+}
+
+/**
+ * @brief Tests every sphere against the frustum, four at a time.
+ */
+void FrustumCuller::Cull()
+{
+    // Pad to whole groups of four, the padding is never read back
+    size_t paddedCount = (mCount + 3) & ~static_cast<size_t>(3);
+    mCentersX.resize(paddedCount, 0.0f);
+    mCentersY.resize(paddedCount, 0.0f);
+    mCentersZ.resize(paddedCount, 0.0f);
+    mRadii.resize(paddedCount, 0.0f);
+    mVisible.resize(paddedCount);
+
+    mVisibleCount = 0;
+    for (size_t group = 0; group < paddedCount; group += 4)
+    {
+#ifdef FRUSTUM_CULLER_SSE
+        __m128 x = _mm_loadu_ps(&mCentersX[group]);
+        __m128 y = _mm_loadu_ps(&mCentersY[group]);
+        __m128 z = _mm_loadu_ps(&mCentersZ[group]);
+        __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&mRadii[group]));
+
+        __m128 inside = _mm_cmpeq_ps(x, x);
+        for (const float* plane : mPlanes)
+        {
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane[0])), _mm_mul_ps(y, _mm_set1_ps(plane[1]))),
+                _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane[2])), _mm_set1_ps(plane[3])));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negativeRadius));
+        }
+        int mask = _mm_movemask_ps(inside);
+        for (int lane = 0; lane < 4; lane++)
+        {
+            mVisible[group + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+        }
+#else
+        for (size_t i = group; i < group + 4; i++)
+        {
+            bool inside = true;
+            for (const float* plane : mPlanes)
+            {
+                float distance = mCentersX[i] * plane[0] + mCentersY[i] * plane[1] + mCentersZ[i] * plane[2] + plane[3];
+                inside = inside && distance >= -mRadii[i];
+            }
+            mVisible[i] = inside ? 1 : 0;
+        }
+#endif
+    }
+
+    for (size_t i = 0; i < mCount; i++)
+    {
+        mVisibleCount += mVisible[i];
+    }
+}
@@ -0,0 +1,107 @@
+/**
+ * @file FrustumCuller.h
+ * @brief Declaration of the FrustumCuller class, which tests bounding spheres against the view frustum.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Math/Matrix4Row.h"
+#include "Math/Vec3.h"
+
+/**
+ * @class FrustumCuller
+ * @brief Tests a list of world space bounding spheres against the six planes of a view projection.
+ *
+ * The spheres are stored as separate arrays of coordinates, so Cull tests them four at a time with SSE.
+ * A sphere is culled only when it is fully behind one plane, so spheres crossing a corner of the frustum are kept.
+ */
+class FrustumCuller
+{
+private:
+    /**
+     * @brief Planes of the frustum as (normal, distance), normalized and facing inside.
+     */
+    float mPlanes[6][4] = {};
+
+    /**
+     * @brief Coordinates of the sphere centers, padded to a multiple of four.
+     */
+    std::vector<float> mCentersX;
+    std::vector<float> mCentersY;
+    std::vector<float> mCentersZ;
+
+    /**
+     * @brief Radii of the spheres, padded to a multiple of four.
+     */
+    std::vector<float> mRadii;
+
+    /**
+     * @brief Result of the last Cull, 1 per visible sphere.
+     */
+    std::vector<uint8_t> mVisible;
+
+    /**
+     * @brief Number of spheres added since the last Clear.
+     */
+    size_t mCount = 0;
+
+    /**
+     * @brief Number of visible spheres found by the last Cull.
+     */
+    size_t mVisibleCount = 0;
+
+public:
+    /**
+     * @brief Extracts the frustum planes from a view projection. A point is inside when -w <= x, y, z <= w in clip space.
+     * @param pViewProj View projection, row vectors multiplied on the left.
+     */
+    void SetViewProj(const Matrix4Row& pViewProj);
+
+    /**
+     * @brief Removes every sphere.
+     */
+    void Clear();
+
+    /**
+     * @brief Adds a sphere to test.
+     * @param pCenter Center in world space.
+     * @param pRadius Radius in world space, infinite to never cull the sphere.
+     * @return Index of the sphere, to read its result.
+     */
+    size_t AddSphere(const Vec3& pCenter, float pRadius);
+
+    /**
+     * @brief Tests every sphere against the frustum.
+     */
+    void Cull();
+
+    /**
+     * @brief Checks if a sphere was found in the frustum by the last Cull.
+     * @param pIndex Index returned by AddSphere.
+     * @return True if the sphere is at least partly inside.
+     */
+    bool IsVisible(size_t pIndex) const
+    {
+        return mVisible[pIndex] != 0;
+    }
+
+    /**
+     * @brief Gets the number of spheres found in the frustum by the last Cull.
+     * @return Number of visible spheres.
+     */
+    size_t GetVisibleCount() const
+    {
+        return mVisibleCount;
+    }
+
+    /**
+     * @brief Gets the number of spheres tested.
+     * @return Number of spheres added since the last Clear.
+     */
+    size_t GetCount() const
+    {
+        return mCount;
+    }
+};
@@ -0,0 +1,95 @@
+/**
+ * @file HeightMap.cpp
+ * @brief Implementation of the HeightMap class, a single channel image kept in memory to sample textures on the CPU.
+ */
+
+#include "HeightMap.h"
+
+#include <cmath>
+#include "SDL_image.h"
+#include "Debug/Log.h"
+
+/**
+ * @brief Loads the red channel of an image file.
+ * @param pFilePath Path to the image file.
+ * @return True if the image was loaded successfully.
+ */
+bool HeightMap::Load(const std::string& pFilePath)
+{
+    SDL_Surface* surface = IMG_Load(pFilePath.c_str());
+    if (!surface)
+    {
+        Log::Error(LogType::Application, "Failed to load height map file : " + pFilePath);
+        return false;
+    }
+
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(surface);
+    if (!converted)
+    {
+        Log::Error(LogType::Application, "Failed to convert height map : " + pFilePath);
+        return false;
+    }
+
+    mWidth = converted->w;
+    mHeight = converted->h;
+    mValues.resize(static_cast<size_t>(mWidth) * mHeight);
+
+    SDL_LockSurface(converted);
+    const Uint8* pixels = static_cast<const Uint8*>(converted->pixels);
+    for (int y = 0; y < mHeight; y++)
+    {
+        const Uint8* row = pixels + y * converted->pitch;
+        for (int x = 0; x < mWidth; x++)
+        {
+            mValues[static_cast<size_t>(y) * mWidth + x] = row[x * 4] / 255.0f;
+        }
+    }
+    SDL_UnlockSurface(converted);
+    SDL_FreeSurface(converted);
+
+    Log::Info("Loaded height map : " + pFilePath);
+    return true;
+}
+
+/**
+ * @brief Gets the value of a pixel, wrapping coordinates outside the image.
+ * @param pX Column of the pixel.
+ * @param pY Row of the pixel.
+ * @return The normalized value of the pixel.
+ */
+float HeightMap::GetValue(int pX, int pY) const
+{
+    if (mValues.empty()) return 0.0f;
+
+    int x = pX % mWidth;
+    int y = pY % mHeight;
+    if (x < 0) x += mWidth;
+    if (y < 0) y += mHeight;
+    return mValues[static_cast<size_t>(y) * mWidth + x];
+}
+
+/**
+ * @brief Samples the image at texture coordinates, matching GL_LINEAR filtering and GL_REPEAT wrapping.
+ * @param pU Horizontal texture coordinate.
+ * @param pV Vertical texture coordinate.
+ * @return The filtered normalized value.
+ */
+float HeightMap::Sample(float pU, float pV) const
+{
+    if (mValues.empty()) return 0.0f;
+
+    // Texel centers sit at half pixel offsets
+    float x = pU * mWidth - 0.5f;
+    float y = pV * mHeight - 0.5f;
+    float x0 = floorf(x);
+    float y0 = floorf(y);
+    float fx = x - x0;
+    float fy = y - y0;
+    int ix = static_cast<int>(x0);
+    int iy = static_cast<int>(y0);
+
+    float top = GetValue(ix, iy) + (GetValue(ix + 1, iy) - GetValue(ix, iy)) * fx;
+    float bottom = GetValue(ix, iy + 1) + (GetValue(ix + 1, iy + 1) - GetValue(ix, iy + 1)) * fx;
+    return top + (bottom - top) * fy;
+}
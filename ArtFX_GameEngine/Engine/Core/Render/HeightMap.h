@@ -0,0 +1,88 @@
+/**
+ * @file HeightMap.h
+ * @brief Declaration of the HeightMap class, a single channel image kept in memory to sample textures on the CPU.
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+
+/**
+ * @class HeightMap
+ * @brief Red channel of an image stored as normalized floats, sampled the same way the GPU samples
+ * the matching texture (bilinear filtering, repeat wrapping).
+ */
+class HeightMap
+{
+private:
+    /**
+     * @brief Normalized values of the red channel, row by row from the top of the image.
+     */
+    std::vector<float> mValues;
+
+    /**
+     * @brief Width of the image in pixels.
+     */
+    int mWidth = 0;
+
+    /**
+     * @brief Height of the image in pixels.
+     */
+    int mHeight = 0;
+
+public:
+    /**
+     * @brief Constructs an empty HeightMap.
+     */
+    HeightMap() = default;
+
+    /**
+     * @brief Loads the red channel of an image file.
+     * @param pFilePath Path to the image file.
+     * @return True if the image was loaded successfully.
+     */
+    bool Load(const std::string& pFilePath);
+
+    /**
+     * @brief Gets the value of a pixel, wrapping coordinates outside the image.
+     * @param pX Column of the pixel.
+     * @param pY Row of the pixel.
+     * @return The normalized value of the pixel.
+     */
+    float GetValue(int pX, int pY) const;
+
+    /**
+     * @brief Samples the image at texture coordinates, matching GL_LINEAR filtering and GL_REPEAT wrapping.
+     * @param pU Horizontal texture coordinate.
+     * @param pV Vertical texture coordinate.
+     * @return The filtered normalized value.
+     */
+    float Sample(float pU, float pV) const;
+
+    /**
+     * @brief Checks if an image has been loaded.
+     * @return True if the height map holds data.
+     */
+    bool IsValid() const
+    {
+        return !mValues.empty();
+    }
+
+    /**
+     * @brief Gets the width of the image.
+     * @return Width in pixels.
+     */
+    int GetWidth() const
+    {
+        return mWidth;
+    }
+
+    /**
+     * @brief Gets the height of the image.
+     * @return Height in pixels.
+     */
+    int GetHeight() const
+    {
+        return mHeight;
+    }
+};
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "../Engine/Core/Render/Window.h"
+#include "Core/Render/RenderQueue.h"
 #include "Core/Render/OpenGL/DrawType.h"
 #include "Core/Render/Shader/ShaderProgram.h"
 #include "Math/Rectangle.h"
@@ -40,6 +41,11 @@ protected:
      * @brief Current draw type (wireframe, solid, etc.).
      */
     DrawType mDrawType;
+
+    /**
+     * @brief GL calls issued to draw the meshes of the last frame.
+     */
+    RenderStats mStats;
 public:
     /**
      * @enum Flip
@@ -163,6 +169,13 @@ public:
      */
     virtual void RemoveMesh(MeshComponent* mesh) = 0;
 
+    /**
+     * @brief Removes several mesh and collision components with a single pass over each list.
+     * @param meshes Mesh components to remove.
+     * @param collisions Collision components to remove.
+     */
+    virtual void RemoveBatch(const std::vector<MeshComponent*>& meshes, const std::vector<BaseCollisionComponent*>& collisions) = 0;
+
     /**
      * @brief Sets the view matrix for rendering.
      * @param matrix The view matrix.
@@ -174,4 +187,13 @@ public:
      * @param type The draw type.
      */
     virtual void SetDawType(DrawType type) = 0;
+
+    /**
+     * @brief Gets the GL calls issued to draw the meshes of the last frame.
+     * @return The counters, all 0 for renderers without meshes.
+     */
+    const RenderStats& GetStats() const
+    {
+        return mStats;
+    }
 };
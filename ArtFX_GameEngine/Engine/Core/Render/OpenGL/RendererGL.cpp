@@ -6,6 +6,7 @@
 #include "RendererGL.h"
 
 #include <glew.h>
+#include <limits>
 #include <SDL_image.h>
 
 #include "Core/Class/Actor/Actor.h"
@@ -14,6 +15,9 @@
 #include "Core/Render/Component/MeshComponent.h"
 #include "Core/Render/Component/SpriteComponent.h"
 #include "Debug/Log.h"
+#include "Math/Time.h"
+
+static_assert(sizeof(Matrix4Row) == 16 * sizeof(float), "Instanced world transforms are streamed as 16 floats");
 
 /**
  * @brief Constructs a RendererGL object and initializes rendering matrices.
@@ -21,7 +25,7 @@
 RendererGL::RendererGL() : mWindow(nullptr), mSpriteVAO(nullptr), mContext(nullptr),
 mSpriteViewProj(Matrix4Row::CreateSimpleViewProj(Window::Dimensions.x, Window::Dimensions.y)),
 mView(Matrix4Row::CreateLookAt(Vec3(0,0,5), Vec3::unitX, Vec3::unitZ)),
-mProj(Matrix4Row::CreatePerspectiveFOV(0.8f, mWindow->GetDimensions().x , mWindow->GetDimensions().y, 0.01f, 10000.0f))
+mProj(Matrix4Row::CreatePerspectiveFOV(0.8f, mWindow->GetDimensions().x , mWindow->GetDimensions().y, NearPlane, FarPlane))
 {
     mDrawType = DrawType::Unlit;
 }
@@ -72,6 +76,8 @@ bool RendererGL::Initialize(Window& rWindow)
         &mSpriteFragmentShader
     });
     mSpriteVAO = new VertexArray(spriteVertices, 4);
+    mFrameBuffer.Create(FrameDataBinding, sizeof(FrameData));
+    glGenBuffers(1, &mInstanceBuffer);
     
     return true;
 }
@@ -87,9 +93,15 @@ void RendererGL::BeginDraw()
 
 /**
  * @brief Draws all registered objects based on the current draw type.
+ * The uniforms shared by every mesh and collision program are uploaded once, before any draw.
  */
 void RendererGL::Draw()
 {
+    FrameData frameData;
+    frameData.viewProj = mView * mProj;
+    frameData.time = Time::elapsedTime;
+    mFrameBuffer.Update(&frameData);
+
     switch (mDrawType)
     {
     case DrawType::Unlit:        
@@ -138,21 +150,103 @@ void RendererGL::DrawSprites()
 }
 
 /**
- * @brief Draws all registered mesh components.
+ * @brief Draws all registered mesh components inside the view frustum, sorted by render state then front to back.
+ * Consecutive components sharing a mesh and a texture are drawn by one instanced call, their world transforms
+ * streamed in a single upload for the whole frame.
  */
 void RendererGL::DrawMeshes()
 {
     glEnable(GL_DEPTH_TEST);
     glDisable(GL_BLEND);
+
+    Matrix4Row viewProj = mView * mProj;
+    mFrustumCuller.SetViewProj(viewProj);
+    mFrustumCuller.Clear();
+    mCullCandidates.clear();
     for (MeshComponent* mesh : mMeshes)
     {
-        if (mesh->GetVisible())
-            mesh->Draw(mView * mProj);
+        if (!mesh->GetVisible() || !mesh->GetMesh()) continue;
+        Vec3 center;
+        float radius;
+        mesh->GetWorldBoundingSphere(center, radius);
+        // Tessellated meshes are displaced on the GPU beyond their bounds, they are never culled
+        if (mesh->GetUseTessellation()) radius = std::numeric_limits<float>::infinity();
+        mFrustumCuller.AddSphere(center, radius);
+        mCullCandidates.push_back(mesh);
+    }
+    mFrustumCuller.Cull();
+
+    mRenderQueue.Clear();
+    for (size_t i = 0; i < mCullCandidates.size(); i++)
+    {
+        if (!mFrustumCuller.IsVisible(i)) continue;
+        MeshComponent* mesh = mCullCandidates[i];
+        // W of the clip position is the distance along the view direction
+        Vec3 position = mesh->GetOwner()->GetWorldTransform().GetTranslation();
+        float depth = position.x * viewProj.mat[0][3] + position.y * viewProj.mat[1][3] + position.z * viewProj.mat[2][3] + viewProj.mat[3][3];
+        mRenderQueue.Submit(mesh->GetDrawKey(mRenderQueue, depth / FarPlane), mesh);
+    }
+    mRenderQueue.Sort();
+
+    const std::vector<DrawCommand>& commands = mRenderQueue.GetCommands();
+    mDrawBatches.clear();
+    mInstanceTransforms.clear();
+    for (size_t begin = 0; begin < commands.size();)
+    {
+        MeshComponent* first = commands[begin].mesh;
+        size_t end = begin + 1;
+        if (first->CanInstance())
+        {
+            while (end < commands.size() && commands[end].mesh->GetMesh() == first->GetMesh() &&
+                commands[end].mesh->GetTextureIndex() == first->GetTextureIndex() && commands[end].mesh->CanInstance())
+            {
+                end++;
+            }
+        }
+
+        DrawBatch& batch = mDrawBatches.emplace_back();
+        batch.begin = begin;
+        batch.count = end - begin;
+        batch.instanceOffset = mInstanceTransforms.size() * sizeof(Matrix4Row);
+        if (batch.count > 1)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                mInstanceTransforms.push_back(first->GetMesh()->GetVertexTransform() * commands[i].mesh->GetOwner()->GetWorldTransform());
+            }
+        }
+        begin = end;
+    }
+
+    if (!mInstanceTransforms.empty())
+    {
+        // Orphan the storage of the previous frame instead of waiting for the draws still reading it
+        glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+        glBufferData(GL_ARRAY_BUFFER, mInstanceTransforms.size() * sizeof(Matrix4Row), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, mInstanceTransforms.size() * sizeof(Matrix4Row), mInstanceTransforms.data());
     }
+
+    RenderState state;
+    for (const DrawBatch& batch : mDrawBatches)
+    {
+        MeshComponent* mesh = commands[batch.begin].mesh;
+        if (batch.count > 1)
+        {
+            mesh->DrawInstanced(state, mInstanceBuffer, batch.instanceOffset, static_cast<int>(batch.count));
+        }
+        else
+        {
+            mesh->Draw(state);
+        }
+    }
+    mStats = state.stats;
+    mStats.meshesVisible = static_cast<uint32_t>(mFrustumCuller.GetVisibleCount());
+    mStats.meshesCulled = static_cast<uint32_t>(mFrustumCuller.GetCount() - mFrustumCuller.GetVisibleCount());
 }
 
 /**
- * @brief Draws all registered collision components.
+ * @brief Draws the registered collision components of the active actors. Paused actors, such as the free
+ * instances of an ActorPool, are out of the physics world and their shapes are not drawn.
  */
 void RendererGL::DrawCollisions()
 {
@@ -160,7 +254,8 @@ void RendererGL::DrawCollisions()
     glDisable(GL_BLEND);
     for (BaseCollisionComponent* collision : mCollisions)
     {
-        collision->Draw(mView * mProj);
+        if (collision->GetOwner()->GetState() != ActorState::Active) continue;
+        collision->Draw();
     }
 }
 
@@ -181,7 +276,7 @@ void RendererGL::RemoveMesh(MeshComponent* mesh)
 {
     std::vector<MeshComponent*>::iterator it;
     it = std::find(mMeshes.begin(), mMeshes.end(), mesh);
-    mMeshes.erase(it);
+    if (it != mMeshes.end()) mMeshes.erase(it);
 }
 
 /**
@@ -201,7 +296,36 @@ void RendererGL::RemoveCollision(BaseCollisionComponent* collision)
 {
     std::vector<BaseCollisionComponent*>::iterator it;
     it = std::find(mCollisions.begin(), mCollisions.end(), collision);
-    mCollisions.erase(it);
+    if (it != mCollisions.end()) mCollisions.erase(it);
+}
+
+/**
+ * @brief Removes several mesh and collision components with a single pass over each list.
+ * The batches are sorted so each registered component is checked with a binary search.
+ * @param meshes Mesh components to remove.
+ * @param collisions Collision components to remove.
+ */
+void RendererGL::RemoveBatch(const std::vector<MeshComponent*>& meshes, const std::vector<BaseCollisionComponent*>& collisions)
+{
+    if (!meshes.empty())
+    {
+        std::vector<MeshComponent*> sortedMeshes = meshes;
+        std::sort(sortedMeshes.begin(), sortedMeshes.end());
+        std::erase_if(mMeshes, [&sortedMeshes](MeshComponent* mesh)
+        {
+            return std::binary_search(sortedMeshes.begin(), sortedMeshes.end(), mesh);
+        });
+    }
+
+    if (!collisions.empty())
+    {
+        std::vector<BaseCollisionComponent*> sortedCollisions = collisions;
+        std::sort(sortedCollisions.begin(), sortedCollisions.end());
+        std::erase_if(mCollisions, [&sortedCollisions](BaseCollisionComponent* collision)
+        {
+            return std::binary_search(sortedCollisions.begin(), sortedCollisions.end(), collision);
+        });
+    }
 }
 
 /**
@@ -280,6 +404,8 @@ void RendererGL::ShowWireframe(bool status)
  */
 void RendererGL::Close()
 {
+    mFrameBuffer.Unload();
+    glDeleteBuffers(1, &mInstanceBuffer);
     SDL_GL_DeleteContext(mContext);
     delete mSpriteVAO;
 }
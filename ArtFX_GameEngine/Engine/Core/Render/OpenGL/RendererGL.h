@@ -5,7 +5,9 @@
 
 #pragma once
 
+#include "Core/Render/FrustumCuller.h"
 #include "Core/Render/Interface/IRenderer.h"
+#include "Core/Render/Shader/UniformBuffer.h"
 #include "VertexArray.h"
 #include <vector>
 
@@ -58,6 +60,51 @@ private:
      */
     Matrix4Row mProj;
 
+    /**
+     * @brief Uniform buffer of the FrameData block, uploaded once per frame for every mesh and collision program.
+     */
+    UniformBuffer mFrameBuffer;
+
+    /**
+     * @brief Bounding spheres of the visible meshes, tested against the frustum each frame.
+     */
+    FrustumCuller mFrustumCuller;
+
+    /**
+     * @brief Mesh components tested by mFrustumCuller, in the order of their spheres.
+     */
+    std::vector<MeshComponent*> mCullCandidates;
+
+    /**
+     * @brief Draws of the visible meshes, sorted each frame.
+     */
+    RenderQueue mRenderQueue;
+
+    /**
+     * @brief Draw calls of the sorted queue, rebuilt each frame.
+     */
+    std::vector<DrawBatch> mDrawBatches;
+
+    /**
+     * @brief World transforms of the instanced batches, uploaded to mInstanceBuffer once per frame.
+     */
+    std::vector<Matrix4Row> mInstanceTransforms;
+
+    /**
+     * @brief Vertex buffer of the instanced world transforms.
+     */
+    unsigned int mInstanceBuffer = 0;
+
+    /**
+     * @brief Distance of the near plane of the projection.
+     */
+    static constexpr float NearPlane = 0.01f;
+
+    /**
+     * @brief Distance of the far plane of the projection.
+     */
+    static constexpr float FarPlane = 10000.0f;
+
 public:
     /**
      * @brief Constructs a RendererGL object and initializes rendering matrices.
@@ -107,7 +154,7 @@ public:
     void DrawMeshes() override;
 
     /**
-     * @brief Draws all registered collision components.
+     * @brief Draws the registered collision components of the active actors.
      */
     void DrawCollisions() override;
 
@@ -179,6 +226,13 @@ public:
      */
     void RemoveCollision(BaseCollisionComponent* collision) override;
 
+    /**
+     * @brief Removes several mesh and collision components with a single pass over each list.
+     * @param meshes Mesh components to remove.
+     * @param collisions Collision components to remove.
+     */
+    void RemoveBatch(const std::vector<MeshComponent*>& meshes, const std::vector<BaseCollisionComponent*>& collisions) override;
+
     /**
      * @brief Sets the view matrix for rendering.
      * @param matrix The view matrix.
@@ -2,8 +2,47 @@
 
 #include <glew.h>
 
-VertexArray::VertexArray(const float* vertices, unsigned int verticeCount) : verticeCount(verticeCount), indexCount(indexCount), vertexArrayId(0),
-vertexBufferId(0), indexBufferId(0)
+const VertexLayout& VertexLayout::Full()
+{
+    static const VertexLayout layout = {{
+        {PositionAttribute, 3, GL_FLOAT, false, 0},
+        {NormalAttribute, 3, GL_FLOAT, false, 3 * sizeof(float)},
+        {TexCoordAttribute, 2, GL_FLOAT, false, 6 * sizeof(float)}
+    }, 8 * sizeof(float)};
+    return layout;
+}
+
+const VertexLayout& VertexLayout::Compact(bool halfTexCoords)
+{
+    //The position takes 4 components to keep the next attributes aligned on 4 bytes, w is ignored by the shaders
+    static const VertexLayout unormLayout = {{
+        {PositionAttribute, 4, GL_SHORT, true, 0},
+        {NormalAttribute, 2, GL_SHORT, true, 4 * sizeof(short)},
+        {TexCoordAttribute, 2, GL_UNSIGNED_SHORT, true, 6 * sizeof(short)}
+    }, 8 * sizeof(short)};
+    static const VertexLayout halfLayout = {{
+        {PositionAttribute, 4, GL_SHORT, true, 0},
+        {NormalAttribute, 2, GL_SHORT, true, 4 * sizeof(short)},
+        {TexCoordAttribute, 2, GL_HALF_FLOAT, false, 6 * sizeof(short)}
+    }, 8 * sizeof(short)};
+    return halfTexCoords ? halfLayout : unormLayout;
+}
+
+const VertexLayout& VertexLayout::PositionOnly()
+{
+    static const VertexLayout layout = {{
+        {PositionAttribute, 3, GL_FLOAT, false, 0}
+    }, 3 * sizeof(float)};
+    return layout;
+}
+
+VertexArray::VertexArray(const float* vertices, unsigned int verticeCount) : VertexArray(vertices, verticeCount, VertexLayout::Full())
+{
+}
+
+VertexArray::VertexArray(const void* vertices, unsigned int verticeCount, const VertexLayout& layout, const unsigned int* indices,
+    unsigned int indexCount) :
+verticeCount(verticeCount), indexCount(indexCount), vertexArrayId(0), vertexBufferId(0), indexBufferId(0)
 {
     //Generate VAO
     glGenVertexArrays(1, &vertexArrayId);
@@ -12,24 +51,29 @@ vertexBufferId(0), indexBufferId(0)
     //Generate VBO
     glGenBuffers(1, &vertexBufferId);
     glBindBuffer(GL_ARRAY_BUFFER, vertexBufferId);
-    glBufferData(GL_ARRAY_BUFFER, verticeCount * 8 * sizeof(float), vertices, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<size_t>(verticeCount) * layout.stride, vertices, GL_STATIC_DRAW);
 
-    //Pos
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    //Normal
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    //TexCoord
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
+    for (const VertexAttribute& attribute : layout.attributes)
+    {
+        glEnableVertexAttribArray(attribute.location);
+        glVertexAttribPointer(attribute.location, attribute.componentCount, attribute.type, attribute.normalized ? GL_TRUE : GL_FALSE,
+            layout.stride, (void*)static_cast<size_t>(attribute.offset));
+    }
+
+    //Generate EBO, bound to the VAO
+    if (indexCount > 0)
+    {
+        glGenBuffers(1, &indexBufferId);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBufferId);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(unsigned int), indices, GL_STATIC_DRAW);
+    }
 }
 
 VertexArray::~VertexArray()
 {
     glDeleteBuffers(1, &vertexBufferId);
     glDeleteBuffers(1, &indexBufferId);
-    glDeleteBuffers(1, &vertexArrayId);
+    glDeleteVertexArrays(1, &vertexArrayId);
 
 }
 
@@ -37,3 +81,15 @@ void VertexArray::SetActive()
 {
     glBindVertexArray(vertexArrayId);
 }
+
+void VertexArray::SetInstanceTransforms(unsigned int bufferId, size_t offset)
+{
+    //WorldTransform, a mat4 attribute takes one location per row
+    glBindBuffer(GL_ARRAY_BUFFER, bufferId);
+    for (unsigned int row = 0; row < 4; row++)
+    {
+        glEnableVertexAttribArray(3 + row);
+        glVertexAttribPointer(3 + row, 4, GL_FLOAT, GL_FALSE, 16 * sizeof(float), (void*)(offset + row * 4 * sizeof(float)));
+        glVertexAttribDivisor(3 + row, 1);
+    }
+}
@@ -1,4 +1,6 @@
 ﻿#pragma once
+#include <cstddef>
+#include <vector>
 
 constexpr float spriteVertices[] = {
     //POSITION                      NORMALS                     TEXCOORDS
@@ -8,6 +10,37 @@ constexpr float spriteVertices[] = {
     0.5f, -0.5f, 0.0f,              0.0f, 0.0f, 0.0f,           1.0f, 1.0f,     //bottom right
 };
 
+//Locations of the vertex attributes, the same in every layout so the shaders do not depend on it
+constexpr unsigned int PositionAttribute = 0;
+constexpr unsigned int NormalAttribute = 1;
+constexpr unsigned int TexCoordAttribute = 2;
+
+struct VertexAttribute
+{
+    unsigned int location;
+    int componentCount;
+    //GL type of a component
+    unsigned int type;
+    //Integer components are read as floats in [-1, 1] when signed, [0, 1] otherwise
+    bool normalized;
+    unsigned int offset;
+};
+
+//Format of the vertices of a buffer, attributes missing from the layout are left disabled
+struct VertexLayout
+{
+    std::vector<VertexAttribute> attributes;
+    unsigned int stride = 0;
+
+    //Float position, normal and texture coordinates, 32 bytes
+    static const VertexLayout& Full();
+    //Snorm16 position within the mesh bounds, octahedral snorm16 normal, and unorm16 texture coordinates,
+    //or half floats when they leave [0, 1] to tile, 16 bytes
+    static const VertexLayout& Compact(bool halfTexCoords);
+    //Float position only, 12 bytes, for the debug shapes
+    static const VertexLayout& PositionOnly();
+};
+
 class VertexArray
 {
 private:
@@ -19,10 +52,17 @@ private:
     unsigned int indexBufferId;
     
 public:
+    //Vertices in the Full layout
     VertexArray(const float* vertices, unsigned int verticeCount);
+    //Vertices in any layout, indexed ones are drawn with glDrawElements
+    VertexArray(const void* vertices, unsigned int verticeCount, const VertexLayout& layout, const unsigned int* indices = nullptr,
+        unsigned int indexCount = 0);
     ~VertexArray();
 
     void SetActive();
+    //Points the instanced world transform attribute at a buffer of row major matrices, the vertex array must be active
+    void SetInstanceTransforms(unsigned int bufferId, size_t offset);
+    unsigned int GetId() const { return vertexArrayId; }
     unsigned int GetVerticeCount() const { return verticeCount; }
     unsigned int GetIndicesCount() const { return indexCount; }
 };
@@ -0,0 +1,136 @@
+/**
+ * @file RenderQueue.cpp
+ * @brief Implementation of the RenderQueue class, which sorts the draws of a frame by render state.
+ */
+
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <glew.h>
+#include "Texture.h"
+#include "Core/Render/OpenGL/VertexArray.h"
+#include "Core/Render/Shader/ShaderProgram.h"
+
+/**
+ * @brief Binds a program if it is not bound yet.
+ * @param pProgram The program.
+ */
+void RenderState::BindProgram(ShaderProgram& pProgram)
+{
+    if (program == pProgram.GetID()) return;
+    program = pProgram.GetID();
+    pProgram.Use();
+    stats.programBinds++;
+}
+
+/**
+ * @brief Binds a texture on a unit if it is not bound there yet.
+ * @param pUnit Texture unit, 0 or 1.
+ * @param pTexture The texture, nullptr keeps the bound one.
+ */
+void RenderState::BindTexture(int pUnit, const Texture* pTexture)
+{
+    if (!pTexture || textures[pUnit] == pTexture->GetID()) return;
+    textures[pUnit] = pTexture->GetID();
+    glActiveTexture(GL_TEXTURE0 + pUnit);
+    pTexture->SetActive();
+    stats.textureBinds++;
+}
+
+/**
+ * @brief Binds a vertex array if it is not bound yet.
+ * @param pVertexArray The vertex array.
+ */
+void RenderState::BindVertexArray(VertexArray& pVertexArray)
+{
+    if (vertexArray == pVertexArray.GetId()) return;
+    vertexArray = pVertexArray.GetId();
+    pVertexArray.SetActive();
+    stats.vertexArrayBinds++;
+}
+
+/**
+ * @brief Draws the indexed vertices of the bound vertex array.
+ * @param pMode Primitive type.
+ * @param pCount Number of indices.
+ */
+void RenderState::DrawElements(unsigned int pMode, int pCount)
+{
+    glDrawElements(pMode, pCount, GL_UNSIGNED_INT, nullptr);
+    stats.drawCalls++;
+}
+
+/**
+ * @brief Draws several instances of the indexed vertices of the bound vertex array.
+ * @param pMode Primitive type.
+ * @param pCount Number of indices.
+ * @param pInstanceCount Number of instances.
+ */
+void RenderState::DrawElementsInstanced(unsigned int pMode, int pCount, int pInstanceCount)
+{
+    glDrawElementsInstanced(pMode, pCount, GL_UNSIGNED_INT, nullptr, pInstanceCount);
+    stats.drawCalls++;
+    stats.instances += pInstanceCount;
+}
+
+/**
+ * @brief Builds a sort key. Ids are truncated to 16 bits, two ids may share a key part and only be less grouped.
+ * @param pProgram Id of the program.
+ * @param pMaterial Index of the textures, given by GetMaterialIndex.
+ * @param pVertexArray Id of the vertex array.
+ * @param pDepth Distance to the camera, 0 at the camera and 1 at the far plane.
+ * @return The key, programs in the most significant bits and depth in the least.
+ */
+uint64_t RenderQueue::MakeKey(uint32_t pProgram, uint16_t pMaterial, uint32_t pVertexArray, float pDepth)
+{
+    uint64_t depth = static_cast<uint64_t>(std::clamp(pDepth, 0.0f, 1.0f) * 0xFFFF);
+    return (static_cast<uint64_t>(pProgram & 0xFFFF) << 48) | (static_cast<uint64_t>(pMaterial) << 32) |
+        (static_cast<uint64_t>(pVertexArray & 0xFFFF) << 16) | depth;
+}
+
+/**
+ * @brief Gets the index of a pair of textures, so every pair drawn gets its own material key part whatever
+ * its texture ids. Past 65536 pairs the indices wrap and some materials are only less grouped.
+ * @param pAlbedo Albedo texture, may be nullptr.
+ * @param pNoise Noise texture, may be nullptr.
+ * @return The material index.
+ */
+uint16_t RenderQueue::GetMaterialIndex(const Texture* pAlbedo, const Texture* pNoise)
+{
+    uint64_t textures = (static_cast<uint64_t>(pAlbedo ? pAlbedo->GetID() : 0) << 32) | (pNoise ? pNoise->GetID() : 0);
+    auto material = mMaterials.try_emplace(textures, static_cast<uint16_t>(mMaterials.size())).first;
+    return material->second;
+}
+
+/**
+ * @brief Sorts the draws by key, with a least significant digit radix sort on bytes.
+ * A byte shared by every key, such as the program byte of a scene using one program, skips its pass.
+ */
+void RenderQueue::Sort()
+{
+    if (mCommands.size() < 2) return;
+    mScratch.resize(mCommands.size());
+
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        size_t offsets[256] = {};
+        for (const DrawCommand& command : mCommands)
+        {
+            offsets[(command.key >> shift) & 0xFF]++;
+        }
+        if (offsets[(mCommands[0].key >> shift) & 0xFF] == mCommands.size()) continue;
+
+        size_t offset = 0;
+        for (size_t& count : offsets)
+        {
+            size_t bucket = count;
+            count = offset;
+            offset += bucket;
+        }
+        for (const DrawCommand& command : mCommands)
+        {
+            mScratch[offsets[(command.key >> shift) & 0xFF]++] = command;
+        }
+        mCommands.swap(mScratch);
+    }
+}
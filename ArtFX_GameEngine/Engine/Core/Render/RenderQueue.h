@@ -0,0 +1,204 @@
+/**
+ * @file RenderQueue.h
+ * @brief Declaration of the RenderQueue class, which sorts the draws of a frame by render state.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class MeshComponent;
+class ShaderProgram;
+class Texture;
+class VertexArray;
+
+/**
+ * @struct DrawCommand
+ * @brief A draw submitted to a RenderQueue.
+ */
+struct DrawCommand
+{
+    /**
+     * @brief Sort key built by RenderQueue::MakeKey.
+     */
+    uint64_t key;
+
+    /**
+     * @brief Component drawn.
+     */
+    MeshComponent* mesh;
+};
+
+/**
+ * @struct DrawBatch
+ * @brief Consecutive draws of a sorted queue drawn by a single call, instanced when there are several.
+ */
+struct DrawBatch
+{
+    /**
+     * @brief Index of the first draw in the queue.
+     */
+    size_t begin;
+
+    /**
+     * @brief Number of draws.
+     */
+    size_t count;
+
+    /**
+     * @brief Offset of the first world transform in the instance buffer, in bytes.
+     */
+    size_t instanceOffset;
+};
+
+/**
+ * @struct RenderStats
+ * @brief GL calls issued to draw the meshes of a frame, and meshes removed by the frustum culling.
+ */
+struct RenderStats
+{
+    uint32_t meshesVisible = 0;     /**< Visible mesh components inside the frustum, submitted to the queue. */
+    uint32_t meshesCulled = 0;      /**< Visible mesh components outside the frustum. */
+    uint32_t drawCalls = 0;         /**< glDrawElements and glDrawElementsInstanced calls. */
+    uint32_t instances = 0;         /**< Meshes drawn by instanced calls. */
+    uint32_t programBinds = 0;      /**< glUseProgram calls. */
+    uint32_t textureBinds = 0;      /**< glBindTexture calls. */
+    uint32_t vertexArrayBinds = 0;  /**< glBindVertexArray calls. */
+};
+
+/**
+ * @struct RenderState
+ * @brief State bound while the sorted draws are issued, so a draw only binds what differs from the previous one.
+ */
+struct RenderState
+{
+    /**
+     * @brief Marks a binding as unknown, the next bind always reaches GL.
+     */
+    static constexpr unsigned int Unknown = ~0u;
+
+    unsigned int program = Unknown;                   /**< Bound program. */
+    unsigned int textures[2] = { Unknown, Unknown };  /**< Texture bound on units 0 and 1. */
+    unsigned int vertexArray = Unknown;               /**< Bound vertex array. */
+
+    /**
+     * @brief Calls issued so far.
+     */
+    RenderStats stats;
+
+    /**
+     * @brief Binds a program if it is not bound yet.
+     * @param pProgram The program.
+     */
+    void BindProgram(ShaderProgram& pProgram);
+
+    /**
+     * @brief Binds a texture on a unit if it is not bound there yet.
+     * @param pUnit Texture unit, 0 or 1.
+     * @param pTexture The texture, nullptr keeps the bound one.
+     */
+    void BindTexture(int pUnit, const Texture* pTexture);
+
+    /**
+     * @brief Binds a vertex array if it is not bound yet.
+     * @param pVertexArray The vertex array.
+     */
+    void BindVertexArray(VertexArray& pVertexArray);
+
+    /**
+     * @brief Draws the indexed vertices of the bound vertex array.
+     * @param pMode Primitive type.
+     * @param pCount Number of indices.
+     */
+    void DrawElements(unsigned int pMode, int pCount);
+
+    /**
+     * @brief Draws several instances of the indexed vertices of the bound vertex array.
+     * @param pMode Primitive type.
+     * @param pCount Number of indices.
+     * @param pInstanceCount Number of instances.
+     */
+    void DrawElementsInstanced(unsigned int pMode, int pCount, int pInstanceCount);
+};
+
+/**
+ * @class RenderQueue
+ * @brief Draws of a frame, radix sorted by program, textures, vertex array and depth.
+ *
+ * Draws sharing a program end up next to each other, then draws sharing textures, then a vertex array, so
+ * RenderState skips most binds. Among draws of the same state, the nearest are drawn first to reject hidden
+ * fragments early.
+ */
+class RenderQueue
+{
+private:
+    /**
+     * @brief Submitted draws, sorted by Sort.
+     */
+    std::vector<DrawCommand> mCommands;
+
+    /**
+     * @brief Buffer of the sort passes, kept to avoid an allocation per frame.
+     */
+    std::vector<DrawCommand> mScratch;
+
+    /**
+     * @brief Compact index of every pair of albedo and noise texture ids drawn so far, kept across frames so a
+     * material keeps its place in the sort.
+     */
+    std::unordered_map<uint64_t, uint16_t> mMaterials;
+
+public:
+    /**
+     * @brief Builds a sort key. Ids are truncated to 16 bits, two ids may share a key part and only be less grouped.
+     * @param pProgram Id of the program.
+     * @param pMaterial Index of the textures, given by GetMaterialIndex.
+     * @param pVertexArray Id of the vertex array.
+     * @param pDepth Distance to the camera, 0 at the camera and 1 at the far plane.
+     * @return The key, programs in the most significant bits and depth in the least.
+     */
+    static uint64_t MakeKey(uint32_t pProgram, uint16_t pMaterial, uint32_t pVertexArray, float pDepth);
+
+    /**
+     * @brief Gets the index of a pair of textures, so every pair drawn gets its own material key part whatever
+     * its texture ids. Past 65536 pairs the indices wrap and some materials are only less grouped.
+     * @param pAlbedo Albedo texture, may be nullptr.
+     * @param pNoise Noise texture, may be nullptr.
+     * @return The material index.
+     */
+    uint16_t GetMaterialIndex(const Texture* pAlbedo, const Texture* pNoise);
+
+    /**
+     * @brief Removes every draw, keeping the memory.
+     */
+    void Clear()
+    {
+        mCommands.clear();
+    }
+
+    /**
+     * @brief Adds a draw.
+     * @param pKey Sort key built by MakeKey.
+     * @param pMesh Component drawn.
+     */
+    void Submit(uint64_t pKey, MeshComponent* pMesh)
+    {
+        mCommands.push_back({ pKey, pMesh });
+    }
+
+    /**
+     * @brief Sorts the draws by key.
+     */
+    void Sort();
+
+    /**
+     * @brief Gets the draws, in key order once sorted.
+     * @return The draws.
+     */
+    const std::vector<DrawCommand>& GetCommands() const
+    {
+        return mCommands;
+    }
+};
@@ -98,7 +98,7 @@ void RendererSdl::DrawRect(Rectangle& rRect, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 void RendererSdl::DrawSprite(Actor& actor, Texture& tex, Rectangle rect, Vec2 pos, Flip orientation)
 {
 	SDL_Rect destinationRect;
-	Transform transform = actor.GetTransform();
+	Transform& transform = actor.GetTransform();
 	destinationRect.w = static_cast<int>(static_cast<float>(tex.GetWidht()) * transform.GetScale().x);
 	destinationRect.h = static_cast<int>(static_cast<float>(tex.GetWidht()) * transform.GetScale().y);
 	destinationRect.x = static_cast<int>(transform.GetPosition().x - pos.x);
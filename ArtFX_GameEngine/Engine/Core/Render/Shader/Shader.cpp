@@ -6,6 +6,7 @@
 #include "Shader.h"
 
 #include <glew.h>
+#include <sstream>
 #include "Debug/Log.h"
 
 /**
@@ -43,24 +44,51 @@ Shader::~Shader()
  * @brief Loads the shader source code from a file and compiles it.
  * @param fileName Path to the shader file.
  * @param shaderType Type of the shader.
+ * @param defines Lines inserted after the #version line, empty by default.
  */
-void Shader::Load(std::string fileName, ShaderType shaderType)
+void Shader::Load(std::string fileName, ShaderType shaderType, const std::string& defines)
 {
-    mType = shaderType;
-    std::ifstream myFile;
-    myFile.open(SHADER_PATH + fileName);
+    Compile(ReadSource(fileName, defines), shaderType);
+}
+
+/**
+ * @brief Reads the source code of a shader file.
+ * @param fileName Path to the shader file.
+ * @param defines Lines inserted after the #version line, empty by default.
+ * @return The source code, empty if the file could not be read.
+ */
+std::string Shader::ReadSource(const std::string& fileName, const std::string& defines)
+{
+    std::ifstream myFile(SHADER_PATH + fileName);
     if (myFile.fail()) {
         Log::Error(LogType::Video, "Error - failed to open " + fileName);
+        return "";
     }
-    std::string fileText = "";
-    std::string line = "";
-    while (getline(myFile, line)) {
-        fileText += line + '\n';
+    std::ostringstream fileText;
+    fileText << myFile.rdbuf();
+    std::string code = fileText.str();
+
+    if (!defines.empty())
+    {
+        // #version must stay the first line of the shader
+        size_t version = code.find("#version");
+        size_t insert = version == std::string::npos ? 0 : code.find('\n', version);
+        insert = insert == std::string::npos ? code.size() : insert + (version == std::string::npos ? 0 : 1);
+        code.insert(insert, defines);
     }
-  
-    myFile.close();
-    mCode = fileText;
-  
+    return code;
+}
+
+/**
+ * @brief Compiles source code as a shader.
+ * @param code Source code of the shader.
+ * @param shaderType Type of the shader.
+ */
+void Shader::Compile(const std::string& code, ShaderType shaderType)
+{
+    mType = shaderType;
+    mCode = code;
+
     switch (mType)
     {
     case VERTEX:
@@ -77,8 +77,24 @@ public:
      * @brief Loads the shader source code from a file and compiles it.
      * @param fileName Path to the shader file.
      * @param shaderType Type of the shader.
+     * @param defines Lines inserted after the #version line, empty by default.
      */
-    void Load(std::string fileName, ShaderType shaderType);
+    void Load(std::string fileName, ShaderType shaderType, const std::string& defines = "");
+
+    /**
+     * @brief Reads the source code of a shader file.
+     * @param fileName Path to the shader file.
+     * @param defines Lines inserted after the #version line, empty by default.
+     * @return The source code, empty if the file could not be read.
+     */
+    static std::string ReadSource(const std::string& fileName, const std::string& defines = "");
+
+    /**
+     * @brief Compiles source code as a shader.
+     * @param code Source code of the shader.
+     * @param shaderType Type of the shader.
+     */
+    void Compile(const std::string& code, ShaderType shaderType);
 
     /**
      * @brief Gets the source code of the shader.
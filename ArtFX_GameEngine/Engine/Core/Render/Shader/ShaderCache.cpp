@@ -0,0 +1,310 @@
+/**
+ * @file ShaderCache.cpp
+ * @brief Implementation of the ShaderCache class, which compiles and links each shader program once.
+ */
+
+#include "ShaderCache.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include "Debug/Log.h"
+
+std::unordered_map<std::string, ShaderProgram> ShaderCache::mPrograms = {};
+std::unordered_map<std::string, Shader> ShaderCache::mShaders = {};
+bool ShaderCache::mEnabled = true;
+size_t ShaderCache::mLinkCount = 0;
+size_t ShaderCache::mCompileCount = 0;
+size_t ShaderCache::mRequestCount = 0;
+std::string ShaderCache::mBinaryDirectory = "ShaderCache/";
+size_t ShaderCache::mBinaryLoadCount = 0;
+
+/**
+ * @brief Identifies a program binary file, "AXPB" read as a little endian integer.
+ */
+static constexpr uint32_t ProgramBinaryMagic = 0x42505841;
+
+/**
+ * @brief Version of the program binary files. Increment when the header or the hashed data change.
+ */
+static constexpr uint32_t ProgramBinaryVersion = 1;
+
+/**
+ * @struct ProgramBinaryHeader
+ * @brief Header of a program binary file, followed by the binary returned by the driver.
+ */
+struct ProgramBinaryHeader
+{
+    uint32_t magic;     /**< ProgramBinaryMagic. */
+    uint32_t version;   /**< ProgramBinaryVersion. */
+    uint64_t hash;      /**< Hash of the sources and driver, also naming the file. */
+    uint32_t format;    /**< Format of the binary, given by the driver. */
+    uint32_t length;    /**< Size of the binary in bytes. */
+};
+
+/**
+ * @brief Hashes bytes with 64 bit FNV-1a.
+ * @param pHash Hash of the previous bytes.
+ * @param pData Bytes to hash.
+ * @param pSize Number of bytes.
+ * @return The combined hash.
+ */
+static uint64_t HashBytes(uint64_t pHash, const void* pData, size_t pSize)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(pData);
+    for (size_t i = 0; i < pSize; i++)
+    {
+        pHash ^= bytes[i];
+        pHash *= 0x100000001b3ull;
+    }
+    return pHash;
+}
+
+/**
+ * @brief Hashes a string, its size included so concatenations do not collide.
+ * @param pHash Hash of the previous bytes.
+ * @param pString String to hash.
+ * @return The combined hash.
+ */
+static uint64_t HashString(uint64_t pHash, const std::string& pString)
+{
+    uint64_t size = pString.size();
+    pHash = HashBytes(pHash, &size, sizeof(size));
+    return HashBytes(pHash, pString.data(), pString.size());
+}
+
+/**
+ * @brief Gets a string of the driver.
+ * @param pName GL_VENDOR, GL_RENDERER or GL_VERSION.
+ * @return The string, empty if unavailable.
+ */
+static std::string GetDriverString(GLenum pName)
+{
+    const GLubyte* value = glGetString(pName);
+    return value ? reinterpret_cast<const char*>(value) : "";
+}
+
+/**
+ * @brief Gets the hash of the driver, seeding the hash of every program. Binaries of another driver never match.
+ * @return The hash, 0 if the driver does not support program binaries.
+ */
+static uint64_t GetDriverHash()
+{
+    static uint64_t driverHash = []() -> uint64_t
+    {
+        if (!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary) return 0;
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        if (formatCount <= 0) return 0;
+
+        uint64_t hash = 0xcbf29ce484222325ull;
+        hash = HashBytes(hash, &ProgramBinaryVersion, sizeof(ProgramBinaryVersion));
+        hash = HashString(hash, GetDriverString(GL_VENDOR));
+        hash = HashString(hash, GetDriverString(GL_RENDERER));
+        hash = HashString(hash, GetDriverString(GL_VERSION));
+        return hash;
+    }();
+    return driverHash;
+}
+
+/**
+ * @brief Gets the path of a program binary file.
+ * @param pDirectory Directory of the binaries.
+ * @param pHash Hash of the program.
+ * @return The path.
+ */
+static std::filesystem::path GetBinaryPath(const std::string& pDirectory, uint64_t pHash)
+{
+    char name[24];
+    snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(pHash));
+    return std::filesystem::path(pDirectory) / name;
+}
+
+/**
+ * @brief Builds the key of a stage.
+ * @param pStage The stage.
+ * @param pDefines Lines inserted after the #version line.
+ * @return The key.
+ */
+static std::string GetStageKey(const ShaderStage& pStage, const std::string& pDefines)
+{
+    return pStage.fileName + ":" + std::to_string(pStage.type) + "|" + pDefines;
+}
+
+/**
+ * @brief Gets the program linking the given stages, compiling and linking it on first use.
+ * @param pStages Stages of the program.
+ * @param pDefines Lines inserted after the #version line of every stage, such as "#define INSTANCED\n".
+ * @return The program, owned by the cache until Clear. Programs are shared, a uniform set on it applies to every user.
+ */
+ShaderProgram* ShaderCache::GetProgram(const std::vector<ShaderStage>& pStages, const std::string& pDefines)
+{
+    mRequestCount++;
+
+    if (!mEnabled)
+    {
+        // Same work as before the cache, the shader objects were never deleted either
+        std::vector<Shader> shaders(pStages.size());
+        std::vector<Shader*> stages;
+        for (size_t i = 0; i < pStages.size(); i++)
+        {
+            shaders[i].Load(pStages[i].fileName, pStages[i].type, pDefines);
+            stages.push_back(&shaders[i]);
+            mCompileCount++;
+        }
+        ShaderProgram& program = mPrograms["#" + std::to_string(mRequestCount)];
+        program.Compose(stages);
+        mLinkCount++;
+        return &program;
+    }
+
+    std::string key;
+    for (const ShaderStage& stage : pStages)
+    {
+        key += stage.fileName + ":" + std::to_string(stage.type) + ";";
+    }
+    key += "|" + pDefines;
+
+    auto cached = mPrograms.find(key);
+    if (cached != mPrograms.end())
+    {
+        return &cached->second;
+    }
+
+    std::vector<std::string> sources;
+    uint64_t hash = mBinaryDirectory.empty() ? 0 : GetDriverHash();
+    for (const ShaderStage& stage : pStages)
+    {
+        sources.push_back(Shader::ReadSource(stage.fileName, pDefines));
+        if (hash != 0)
+        {
+            hash = HashBytes(hash, &stage.type, sizeof(stage.type));
+            hash = HashString(hash, sources.back());
+        }
+    }
+
+    ShaderProgram& program = mPrograms[key];
+    if (hash != 0 && LoadBinary(program, hash))
+    {
+        mBinaryLoadCount++;
+        return &program;
+    }
+
+    std::vector<Shader*> stages;
+    for (size_t i = 0; i < pStages.size(); i++)
+    {
+        stages.push_back(GetShader(pStages[i], pDefines, sources[i]));
+    }
+    program.Compose(stages, hash != 0);
+    mLinkCount++;
+    if (hash != 0)
+    {
+        SaveBinary(program, hash);
+    }
+    return &program;
+}
+
+/**
+ * @brief Loads a program from its binary file. A file that does not match or is rejected by the driver is deleted,
+ * the program linked from source then saves a new one.
+ * @param pProgram Receives the program.
+ * @param pHash Hash of the program sources and driver.
+ * @return True if loaded, false if the program must be linked from source.
+ */
+bool ShaderCache::LoadBinary(ShaderProgram& pProgram, uint64_t pHash)
+{
+    std::filesystem::path path = GetBinaryPath(mBinaryDirectory, pHash);
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    ProgramBinaryHeader header = {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    std::vector<unsigned char> binary;
+    bool valid = file && header.magic == ProgramBinaryMagic && header.version == ProgramBinaryVersion &&
+        header.hash == pHash && header.length > 0;
+    if (valid)
+    {
+        binary.resize(header.length);
+        file.read(reinterpret_cast<char*>(binary.data()), header.length);
+        valid = file && pProgram.LoadBinary(header.format, binary.data(), static_cast<GLsizei>(header.length));
+    }
+    file.close();
+
+    if (!valid)
+    {
+        Log::Warning(LogType::Video, "Program binary " + path.string() + " is outdated, linking from source");
+        std::error_code error;
+        std::filesystem::remove(path, error);
+    }
+    return valid;
+}
+
+/**
+ * @brief Saves the binary of a linked program. Failures are logged, the program is linked again on the next start.
+ * @param pProgram The program.
+ * @param pHash Hash of the program sources and driver.
+ */
+void ShaderCache::SaveBinary(ShaderProgram& pProgram, uint64_t pHash)
+{
+    GLenum format = 0;
+    std::vector<unsigned char> binary;
+    if (!pProgram.GetBinary(format, binary)) return;
+
+    ProgramBinaryHeader header = {};
+    header.magic = ProgramBinaryMagic;
+    header.version = ProgramBinaryVersion;
+    header.hash = pHash;
+    header.format = format;
+    header.length = static_cast<uint32_t>(binary.size());
+
+    std::error_code error;
+    std::filesystem::create_directories(mBinaryDirectory, error);
+    std::filesystem::path path = GetBinaryPath(mBinaryDirectory, pHash);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(binary.data()), static_cast<std::streamsize>(binary.size()));
+    if (!file)
+    {
+        Log::Error(LogType::Video, "Could not write program binary " + path.string());
+    }
+}
+
+/**
+ * @brief Gets a compiled stage, compiling it on first use.
+ * @param pStage The stage.
+ * @param pDefines Lines inserted after the #version line.
+ * @param pSource Source code of the stage, defines included.
+ * @return The compiled stage.
+ */
+Shader* ShaderCache::GetShader(const ShaderStage& pStage, const std::string& pDefines, const std::string& pSource)
+{
+    std::string key = GetStageKey(pStage, pDefines);
+    auto cached = mShaders.find(key);
+    if (cached != mShaders.end())
+    {
+        return &cached->second;
+    }
+
+    Shader& shader = mShaders[key];
+    shader.Compile(pSource, pStage.type);
+    mCompileCount++;
+    return &shader;
+}
+
+/**
+ * @brief Deletes every cached program and shader. Programs returned before must not be used anymore.
+ */
+void ShaderCache::Clear()
+{
+    for (auto& program : mPrograms)
+    {
+        program.second.Unload();
+    }
+    mPrograms.clear();
+
+    for (auto& shader : mShaders)
+    {
+        glDeleteShader(shader.second.GetId());
+    }
+    mShaders.clear();
+}
@@ -0,0 +1,178 @@
+/**
+ * @file ShaderCache.h
+ * @brief Declaration of the ShaderCache class, which compiles and links each shader program once.
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ShaderProgram.h"
+
+/**
+ * @struct ShaderStage
+ * @brief A shader file and the stage it is compiled for.
+ */
+struct ShaderStage
+{
+    /**
+     * @brief Path to the shader file, relative to Shader::SHADER_PATH.
+     */
+    std::string fileName;
+
+    /**
+     * @brief Stage of the shader.
+     */
+    ShaderType type;
+};
+
+/**
+ * @class ShaderCache
+ * @brief Static cache of shader programs, keyed by their stages and defines.
+ *
+ * Every mesh and collision shape used to compile and link its own copy of the same program. The cache returns the
+ * program linked for the first request of a set of stages, and compiles a stage shared by several programs once.
+ *
+ * When the driver supports program binaries, linked programs are also saved under a cache directory, keyed by a
+ * hash of their sources, defines and driver. The next start loads them from there without compiling or linking,
+ * and falls back to the sources when a binary is missing or rejected.
+ */
+class ShaderCache
+{
+public:
+    ShaderCache() = delete; /**< Deleted default constructor to prevent instantiation. */
+
+    /**
+     * @brief Gets the program linking the given stages, compiling and linking it on first use.
+     * @param pStages Stages of the program.
+     * @param pDefines Lines inserted after the #version line of every stage, such as "#define INSTANCED\n".
+     * @return The program, owned by the cache until Clear. Programs are shared, a uniform set on it applies to every user.
+     */
+    static ShaderProgram* GetProgram(const std::vector<ShaderStage>& pStages, const std::string& pDefines = "");
+
+    /**
+     * @brief Deletes every cached program and shader. Programs returned before must not be used anymore.
+     */
+    static void Clear();
+
+    /**
+     * @brief Enables or disables the cache. A disabled cache compiles and links every requested program, to measure the cache.
+     * @param pEnabled Whether programs are shared.
+     */
+    static void SetEnabled(bool pEnabled)
+    {
+        mEnabled = pEnabled;
+    }
+
+    /**
+     * @brief Sets the directory of the program binaries.
+     * @param pDirectory Directory, created on first save. An empty directory disables the binaries.
+     */
+    static void SetBinaryDirectory(const std::string& pDirectory)
+    {
+        mBinaryDirectory = pDirectory;
+    }
+
+    /**
+     * @brief Gets the number of programs loaded from a binary since the start.
+     * @return Number of programs neither compiled nor linked.
+     */
+    static size_t GetBinaryLoadCount()
+    {
+        return mBinaryLoadCount;
+    }
+
+    /**
+     * @brief Gets the number of programs linked since the start.
+     * @return Number of glLinkProgram calls.
+     */
+    static size_t GetLinkCount()
+    {
+        return mLinkCount;
+    }
+
+    /**
+     * @brief Gets the number of shader stages compiled since the start.
+     * @return Number of glCompileShader calls.
+     */
+    static size_t GetCompileCount()
+    {
+        return mCompileCount;
+    }
+
+    /**
+     * @brief Gets the number of programs requested since the start, cached or not.
+     * @return Number of GetProgram calls.
+     */
+    static size_t GetRequestCount()
+    {
+        return mRequestCount;
+    }
+
+private:
+    /**
+     * @brief Linked programs by key. The programs of a disabled cache are stored under a unique key.
+     * The elements of the map never move, so the returned pointers stay valid.
+     */
+    static std::unordered_map<std::string, ShaderProgram> mPrograms;
+
+    /**
+     * @brief Compiled stages by key, shared by the programs using them.
+     */
+    static std::unordered_map<std::string, Shader> mShaders;
+
+    /**
+     * @brief Whether programs are shared.
+     */
+    static bool mEnabled;
+
+    /**
+     * @brief Directory of the program binaries, empty if disabled.
+     */
+    static std::string mBinaryDirectory;
+
+    /**
+     * @brief Number of programs loaded from a binary.
+     */
+    static size_t mBinaryLoadCount;
+
+    /**
+     * @brief Number of programs linked.
+     */
+    static size_t mLinkCount;
+
+    /**
+     * @brief Number of stages compiled.
+     */
+    static size_t mCompileCount;
+
+    /**
+     * @brief Number of programs requested.
+     */
+    static size_t mRequestCount;
+
+    /**
+     * @brief Gets a compiled stage, compiling it on first use.
+     * @param pStage The stage.
+     * @param pDefines Lines inserted after the #version line.
+     * @param pSource Source code of the stage, defines included.
+     * @return The compiled stage.
+     */
+    static Shader* GetShader(const ShaderStage& pStage, const std::string& pDefines, const std::string& pSource);
+
+    /**
+     * @brief Loads a program from its binary file.
+     * @param pProgram Receives the program.
+     * @param pHash Hash of the program sources and driver.
+     * @return True if loaded, false if the program must be linked from source.
+     */
+    static bool LoadBinary(ShaderProgram& pProgram, uint64_t pHash);
+
+    /**
+     * @brief Saves the binary of a linked program.
+     * @param pProgram The program.
+     * @param pHash Hash of the program sources and driver.
+     */
+    static void SaveBinary(ShaderProgram& pProgram, uint64_t pHash);
+};
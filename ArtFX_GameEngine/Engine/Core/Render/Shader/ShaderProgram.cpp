@@ -4,6 +4,7 @@
  */
 
 #include "ShaderProgram.h"
+#include "UniformBuffer.h"
 #include "Math/Matrix4.h"
 
 /**
@@ -25,19 +26,115 @@ void ShaderProgram::Unload()
 /**
  * @brief Composes the shader program by attaching and linking multiple shaders.
  * @param shaders Vector of pointers to Shader objects.
+ * @param retrievable Whether the linked binary will be read back with GetBinary. Requires program binary support.
  */
-void ShaderProgram::Compose(std::vector<Shader*> shaders)
+void ShaderProgram::Compose(std::vector<Shader*> shaders, bool retrievable)
 {
     mId = glCreateProgram();
+    if (retrievable) {
+        glProgramParameteri(mId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     // Attach shaders to the program
     for (int s = 0; s < static_cast<int>(shaders.size()); s++) {
         glAttachShader(mId, shaders[s]->GetId());
     }
     // Link the program
     glLinkProgram(mId);
+    CacheUniforms();
     Use();
 }
 
+/**
+ * @brief Creates the shader program from a binary returned by GetBinary.
+ * A binary is rejected when the driver or its settings changed since it was saved.
+ * @param format Format of the binary, given by the driver.
+ * @param data The binary.
+ * @param length Size of the binary in bytes.
+ * @return True if the driver accepted the binary, false if the program must be linked from source.
+ */
+bool ShaderProgram::LoadBinary(GLenum format, const void* data, GLsizei length)
+{
+    mId = glCreateProgram();
+    glProgramBinary(mId, format, data, length);
+    GLint linked = GL_FALSE;
+    glGetProgramiv(mId, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        glDeleteProgram(mId);
+        mId = 0;
+        return false;
+    }
+    CacheUniforms();
+    Use();
+    return true;
+}
+
+/**
+ * @brief Reads back the binary of the linked program.
+ * @param format Receives the format of the binary.
+ * @param data Receives the binary.
+ * @return True if the program is linked and has a binary.
+ */
+bool ShaderProgram::GetBinary(GLenum& format, std::vector<unsigned char>& data)
+{
+    GLint linked = GL_FALSE;
+    glGetProgramiv(mId, GL_LINK_STATUS, &linked);
+    GLint length = 0;
+    glGetProgramiv(mId, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (linked != GL_TRUE || length <= 0) {
+        return false;
+    }
+    data.resize(length);
+    glGetProgramBinary(mId, length, &length, &format, data.data());
+    data.resize(length);
+    return length > 0;
+}
+
+/**
+ * @brief Reads the locations of the active uniforms and binds the uniform blocks of the engine.
+ * Block bindings are not part of a program binary, so this also runs after LoadBinary.
+ */
+void ShaderProgram::CacheUniforms()
+{
+    mUniformLocations.clear();
+    GLint uniformCount = 0;
+    glGetProgramiv(mId, GL_ACTIVE_UNIFORMS, &uniformCount);
+    GLint maxLength = 0;
+    glGetProgramiv(mId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::string name(maxLength, '\0');
+    for (GLint u = 0; u < uniformCount; u++) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(mId, u, maxLength, &length, &size, &type, name.data());
+        std::string uniform = name.substr(0, length);
+        // Arrays are reported as name[0], set by their plain name
+        if (uniform.size() > 3 && uniform.compare(uniform.size() - 3, 3, "[0]") == 0) {
+            uniform.resize(uniform.size() - 3);
+        }
+        // Members of a block have no location
+        GLint location = glGetUniformLocation(mId, uniform.c_str());
+        if (location >= 0) {
+            mUniformLocations[uniform] = location;
+        }
+    }
+
+    GLuint frameBlock = glGetUniformBlockIndex(mId, FrameDataBlockName);
+    if (frameBlock != GL_INVALID_INDEX) {
+        glUniformBlockBinding(mId, frameBlock, FrameDataBinding);
+    }
+}
+
+/**
+ * @brief Gets the location of a uniform, read when the program was linked.
+ * @param name Name of the uniform variable.
+ * @return The location, -1 if the program has no such uniform.
+ */
+GLint ShaderProgram::GetUniformLocation(const GLchar* name) const
+{
+    auto location = mUniformLocations.find(std::string_view(name));
+    return location != mUniformLocations.end() ? location->second : -1;
+}
+
 /**
  * @brief Gets the ID of the shader program.
  * @return OpenGL program ID.
@@ -62,7 +159,7 @@ void ShaderProgram::Use()
  */
 void ShaderProgram::setFloat(const GLchar* name, GLfloat value)
 {
-    glUniform1f(glGetUniformLocation(mId, name), value);
+    glUniform1f(GetUniformLocation(name), value);
 }
 
 /**
@@ -72,7 +169,7 @@ void ShaderProgram::setFloat(const GLchar* name, GLfloat value)
  */
 void ShaderProgram::setInteger(const GLchar* name, GLint value)
 {
-    glUniform1i(glGetUniformLocation(mId, name), value);
+    glUniform1i(GetUniformLocation(name), value);
 }
 
 /**
@@ -83,7 +180,7 @@ void ShaderProgram::setInteger(const GLchar* name, GLint value)
  */
 void ShaderProgram::setVector2f(const GLchar* name, GLfloat x, GLfloat y)
 {
-    glUniform2f(glGetUniformLocation(mId, name), x, y);
+    glUniform2f(GetUniformLocation(name), x, y);
 }
 
 /**
@@ -93,7 +190,7 @@ void ShaderProgram::setVector2f(const GLchar* name, GLfloat x, GLfloat y)
  */
 void ShaderProgram::setVector2f(const GLchar* name, const Vec2& value)
 {
-    glUniform2f(glGetUniformLocation(mId, name), value.x, value.y);
+    glUniform2f(GetUniformLocation(name), value.x, value.y);
 }
 
 /**
@@ -105,7 +202,7 @@ void ShaderProgram::setVector2f(const GLchar* name, const Vec2& value)
  */
 void ShaderProgram::setVector3f(const GLchar* name, GLfloat x, GLfloat y, GLfloat z)
 {
-    glUniform3f(glGetUniformLocation(mId, name), x, y, z);
+    glUniform3f(GetUniformLocation(name), x, y, z);
 }
 
 /**
@@ -115,7 +212,7 @@ void ShaderProgram::setVector3f(const GLchar* name, GLfloat x, GLfloat y, GLfloa
  */
 void ShaderProgram::setVector3f(const GLchar* name, const Vec3& value)
 {
-    glUniform3f(glGetUniformLocation(mId, name), value.x, value.y, value.z);
+    glUniform3f(GetUniformLocation(name), value.x, value.y, value.z);
 }
 
 /**
@@ -128,7 +225,7 @@ void ShaderProgram::setVector3f(const GLchar* name, const Vec3& value)
  */
 void ShaderProgram::setVector4f(const GLchar* name, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
 {
-    glUniform4f(glGetUniformLocation(mId, name), x, y, z, w);
+    glUniform4f(GetUniformLocation(name), x, y, z, w);
 }
 
 /**
@@ -138,7 +235,7 @@ void ShaderProgram::setVector4f(const GLchar* name, GLfloat x, GLfloat y, GLfloa
  */
 void ShaderProgram::setVector4f(const GLchar* name, const Vec4& value)
 {
-    glUniform4f(glGetUniformLocation(mId, name), value.x, value.y, value.z, value.w);
+    glUniform4f(GetUniformLocation(name), value.x, value.y, value.z, value.w);
 }
 
 /**
@@ -148,7 +245,7 @@ void ShaderProgram::setVector4f(const GLchar* name, const Vec4& value)
  */
 void ShaderProgram::setMatrix4(const GLchar* name, const Matrix4& matrix)
 {
-    glUniformMatrix4fv(glGetUniformLocation(mId, name), 1, GL_TRUE, matrix.GetAsFloatPtr());
+    glUniformMatrix4fv(GetUniformLocation(name), 1, GL_TRUE, matrix.GetAsFloatPtr());
 }
 
 /**
@@ -158,5 +255,5 @@ void ShaderProgram::setMatrix4(const GLchar* name, const Matrix4& matrix)
  */
 void ShaderProgram::setMatrix4Row(const GLchar* name, const Matrix4Row& matrix)
 {
-    glUniformMatrix4fv(glGetUniformLocation(mId, name), 1, GL_TRUE, matrix.GetAsFloatPtr());
+    glUniformMatrix4fv(GetUniformLocation(name), 1, GL_TRUE, matrix.GetAsFloatPtr());
 }
@@ -5,8 +5,11 @@
 
 #pragma once
 #include <glew.h>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include "Shader.h"
+#include "Core/StringHash.h"
 #include "Math/Matrix4Row.h"
 #include "Math/Vec2.h"
 #include "Math/Vec3.h"
@@ -24,6 +27,16 @@ private:
      */
     unsigned int mId;
 
+    /**
+     * @brief Locations of the active uniforms by name, read once the program is linked.
+     */
+    std::unordered_map<std::string, GLint, StringHash, std::equal_to<>> mUniformLocations;
+
+    /**
+     * @brief Reads the locations of the active uniforms and binds the uniform blocks of the engine.
+     */
+    void CacheUniforms();
+
 public:
     /**
      * @brief Constructs a ShaderProgram object.
@@ -43,8 +56,26 @@ public:
     /**
      * @brief Composes the shader program by linking multiple shaders.
      * @param shaders Vector of pointers to Shader objects.
+     * @param retrievable Whether the linked binary will be read back with GetBinary. Requires program binary support.
+     */
+    void Compose(std::vector<Shader*> shaders, bool retrievable = false);
+
+    /**
+     * @brief Creates the shader program from a binary returned by GetBinary.
+     * @param format Format of the binary, given by the driver.
+     * @param data The binary.
+     * @param length Size of the binary in bytes.
+     * @return True if the driver accepted the binary, false if the program must be linked from source.
+     */
+    bool LoadBinary(GLenum format, const void* data, GLsizei length);
+
+    /**
+     * @brief Reads back the binary of the linked program.
+     * @param format Receives the format of the binary.
+     * @param data Receives the binary.
+     * @return True if the program is linked and has a binary.
      */
-    void Compose(std::vector<Shader*> shaders);
+    bool GetBinary(GLenum& format, std::vector<unsigned char>& data);
 
     /**
      * @brief Gets the ID of the shader program.
@@ -57,6 +88,13 @@ public:
      */
     void Use();
 
+    /**
+     * @brief Gets the location of a uniform, read when the program was linked.
+     * @param name Name of the uniform variable.
+     * @return The location, -1 if the program has no such uniform.
+     */
+    GLint GetUniformLocation(const GLchar* name) const;
+
     /**
      * @brief Sets a float uniform variable in the shader program.
      * @param name Name of the uniform variable.
@@ -0,0 +1,39 @@
+/**
+ * @file UniformBuffer.cpp
+ * @brief Implementation of the UniformBuffer class, which holds a std140 uniform block shared by the shader programs.
+ */
+
+#include "UniformBuffer.h"
+
+/**
+ * @brief Creates the buffer and binds it to a binding point.
+ * @param pBinding Binding point of the block.
+ * @param pSize Size of the block in bytes.
+ */
+void UniformBuffer::Create(GLuint pBinding, GLsizeiptr pSize)
+{
+    mSize = pSize;
+    glGenBuffers(1, &mId);
+    glBindBuffer(GL_UNIFORM_BUFFER, mId);
+    glBufferData(GL_UNIFORM_BUFFER, mSize, nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, pBinding, mId);
+}
+
+/**
+ * @brief Replaces the content of the buffer.
+ * @param pData New content, of the size given to Create.
+ */
+void UniformBuffer::Update(const void* pData)
+{
+    glBindBuffer(GL_UNIFORM_BUFFER, mId);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, mSize, pData);
+}
+
+/**
+ * @brief Deletes the buffer.
+ */
+void UniformBuffer::Unload()
+{
+    glDeleteBuffers(1, &mId);
+    mId = 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file UniformBuffer.h
+ * @brief Declaration of the UniformBuffer class, which holds a std140 uniform block shared by the shader programs.
+ */
+
+#pragma once
+#include <glew.h>
+#include "Math/Matrix4Row.h"
+
+/**
+ * @brief Binding point of the FrameData block, set on every program declaring it when linked.
+ */
+constexpr GLuint FrameDataBinding = 0;
+
+/**
+ * @brief Name of the FrameData block in the shaders.
+ */
+constexpr const char* FrameDataBlockName = "FrameData";
+
+/**
+ * @struct FrameData
+ * @brief Uniforms set once per frame, laid out as the std140 FrameData block of the shaders:
+ * layout(std140, row_major) uniform FrameData { mat4 uViewProj; float uTime; };
+ */
+struct FrameData
+{
+    /**
+     * @brief View projection matrix, row major like the matrices set with setMatrix4Row.
+     */
+    Matrix4Row viewProj;
+
+    /**
+     * @brief Time since the start, in seconds.
+     */
+    float time = 0.0f;
+
+    /**
+     * @brief Pads the block to a multiple of 16 bytes, as std140 does.
+     */
+    float padding[3] = {};
+};
+
+static_assert(sizeof(FrameData) == 80, "FrameData must match the std140 layout of the FrameData block");
+
+/**
+ * @class UniformBuffer
+ * @brief OpenGL buffer bound to a uniform block binding point, read by every program using the block.
+ */
+class UniformBuffer
+{
+private:
+    /**
+     * @brief ID of the OpenGL buffer, 0 until created.
+     */
+    GLuint mId = 0;
+
+    /**
+     * @brief Size of the buffer in bytes.
+     */
+    GLsizeiptr mSize = 0;
+
+public:
+    /**
+     * @brief Creates the buffer and binds it to a binding point.
+     * @param pBinding Binding point of the block.
+     * @param pSize Size of the block in bytes.
+     */
+    void Create(GLuint pBinding, GLsizeiptr pSize);
+
+    /**
+     * @brief Replaces the content of the buffer.
+     * @param pData New content, of the size given to Create.
+     */
+    void Update(const void* pData);
+
+    /**
+     * @brief Deletes the buffer.
+     */
+    void Unload();
+};
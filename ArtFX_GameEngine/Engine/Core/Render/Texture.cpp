@@ -84,13 +84,25 @@ void Texture::SetActive() const
  */
 bool Texture::LoadTexture(IRenderer& renderer, const std::string& filePath)
 {
-    mFilePath = filePath;
-    SDL_Surface* surface = IMG_Load(mFilePath.c_str());
+    SDL_Surface* surface = IMG_Load(filePath.c_str());
     if(!surface)
     {
-        Log::Error(LogType::Application, "Failed to load texture file : " + mFilePath);
+        Log::Error(LogType::Application, "Failed to load texture file : " + filePath);
         return false;
     }
+    return LoadFromSurface(renderer, filePath, surface);
+}
+
+/**
+ * @brief Creates the texture from an already decoded surface, so the file can be read on another thread.
+ * @param renderer Reference to the renderer.
+ * @param filePath Path of the decoded file.
+ * @param surface Decoded surface, freed by this call.
+ * @return True if the texture was loaded successfully.
+ */
+bool Texture::LoadFromSurface(IRenderer& renderer, const std::string& filePath, SDL_Surface* surface)
+{
+    mFilePath = filePath;
     mWidth = surface->w;
     mHeight = surface->h;
 
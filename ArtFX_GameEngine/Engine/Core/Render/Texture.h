@@ -80,6 +80,15 @@ public:
      */
     bool LoadTexture(IRenderer& renderer, const std::string& filePath);
 
+    /**
+     * @brief Creates the texture from an already decoded surface, so the file can be read on another thread.
+     * @param renderer Reference to the renderer.
+     * @param filePath Path of the decoded file.
+     * @param surface Decoded surface, freed by this call.
+     * @return True if the texture was loaded successfully.
+     */
+    bool LoadFromSurface(IRenderer& renderer, const std::string& filePath, SDL_Surface* surface);
+
     /**
      * @brief Unloads the texture and releases resources.
      */
@@ -110,6 +119,24 @@ public:
      */
     int GetHeight();
 
+    /**
+     * @brief Gets the path of the file the texture was loaded from.
+     * @return File path of the texture.
+     */
+    const std::string& GetFilePath() const
+    {
+        return mFilePath;
+    }
+
+    /**
+     * @brief Gets the OpenGL id of the texture.
+     * @return OpenGL texture ID.
+     */
+    unsigned int GetID() const
+    {
+        return mTextureID;
+    }
+
     /**
      * @brief Gets the SDL texture object.
      * @return Pointer to the SDL texture object.
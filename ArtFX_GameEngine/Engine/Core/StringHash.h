@@ -0,0 +1,31 @@
+/**
+ * @file StringHash.h
+ * @brief Transparent string hash for unordered containers keyed by std::string.
+ */
+
+#pragma once
+#include <string>
+#include <string_view>
+
+/**
+ * @struct StringHash
+ * @brief Hashes std::string, string views and literals alike, so lookups with a std::string_view do not allocate.
+ * Use with std::equal_to<> as the key equality.
+ */
+struct StringHash
+{
+    /**
+     * @brief Enables heterogeneous lookup.
+     */
+    using is_transparent = void;
+
+    /**
+     * @brief Hashes a string.
+     * @param pString The string to hash.
+     * @return The hash of the characters.
+     */
+    size_t operator()(std::string_view pString) const
+    {
+        return std::hash<std::string_view>{}(pString);
+    }
+};
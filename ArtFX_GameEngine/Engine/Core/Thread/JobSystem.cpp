@@ -0,0 +1,143 @@
+/**
+ * @file JobSystem.cpp
+ * @brief Implementation of the JobSystem class, a pool of worker threads running data parallel loops.
+ */
+
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <string>
+
+#include "Debug/Profiler.h"
+
+/**
+ * @brief Starts the worker threads.
+ * @param pWorkerCount Number of workers, 0 uses one per hardware core besides the calling thread.
+ */
+JobSystem::JobSystem(int pWorkerCount)
+{
+    if (pWorkerCount <= 0)
+    {
+        pWorkerCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+
+    mWorkers.reserve(pWorkerCount);
+    for (int i = 0; i < pWorkerCount; i++)
+    {
+        mWorkers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+/**
+ * @brief Stops and joins the worker threads.
+ */
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mWakeCondition.notify_all();
+    for (std::thread& worker : mWorkers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Gets the job system shared by the scenes, started on first use.
+ * @return Reference to the shared job system.
+ */
+JobSystem& JobSystem::GetInstance()
+{
+    static JobSystem instance;
+    return instance;
+}
+
+/**
+ * @brief Runs a loop over [0, pCount) split in batches, on the workers and the calling thread.
+ * A loop of a single batch runs directly on the calling thread.
+ * @param pCount Number of iterations.
+ * @param pBatchSize Number of iterations taken at once by a thread.
+ * @param pJob Body of the loop, called with the first and past the last iteration of a batch.
+ */
+void JobSystem::ParallelFor(size_t pCount, size_t pBatchSize, const std::function<void(size_t, size_t)>& pJob)
+{
+    pBatchSize = std::max<size_t>(pBatchSize, 1);
+    if (pCount == 0) return;
+    if (mWorkers.empty() || pCount <= pBatchSize)
+    {
+        pJob(0, pCount);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJob = &pJob;
+        mJobCount = pCount;
+        mBatchSize = pBatchSize;
+        mNextIndex = 0;
+        mGeneration++;
+    }
+    mWakeCondition.notify_all();
+
+    RunBatches(pJob, pCount, pBatchSize);
+
+    // Every batch is taken, wait for the workers still running one
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDoneCondition.wait(lock, [this] { return mActiveWorkers == 0; });
+    mJob = nullptr;
+}
+
+/**
+ * @brief Loop of a worker thread. A worker waking up after the loop is over finds no job and goes back to sleep.
+ * @param pWorkerIndex Index of the worker, names its thread in the profiler.
+ */
+void JobSystem::WorkerLoop([[maybe_unused]] int pWorkerIndex)
+{
+    PROFILE_THREAD_NAME("Job worker " + std::to_string(pWorkerIndex));
+    uint64_t generation = 0;
+    while (true)
+    {
+        const std::function<void(size_t, size_t)>* job;
+        size_t count;
+        size_t batchSize;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeCondition.wait(lock, [this, generation] { return mStopping || mGeneration != generation; });
+            if (mStopping) return;
+
+            generation = mGeneration;
+            if (!mJob) continue;
+            job = mJob;
+            count = mJobCount;
+            batchSize = mBatchSize;
+            mActiveWorkers++;
+        }
+
+        RunBatches(*job, count, batchSize);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mActiveWorkers--;
+        }
+        mDoneCondition.notify_one();
+    }
+}
+
+/**
+ * @brief Takes and runs batches until the loop is fully taken.
+ * @param pJob Body of the loop.
+ * @param pCount Number of iterations.
+ * @param pBatchSize Number of iterations taken at once.
+ */
+void JobSystem::RunBatches(const std::function<void(size_t, size_t)>& pJob, size_t pCount, size_t pBatchSize)
+{
+    while (true)
+    {
+        size_t begin = mNextIndex.fetch_add(pBatchSize);
+        if (begin >= pCount) return;
+        PROFILE_SCOPE("Job batch");
+        pJob(begin, std::min(begin + pBatchSize, pCount));
+    }
+}
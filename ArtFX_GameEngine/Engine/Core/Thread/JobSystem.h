@@ -0,0 +1,131 @@
+/**
+ * @file JobSystem.h
+ * @brief Declaration of the JobSystem class, a pool of worker threads running data parallel loops.
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class JobSystem
+ * @brief Pool of worker threads splitting a loop into batches.
+ *
+ * The calling thread takes batches as well, and ParallelFor only returns once every batch is done, so a job
+ * can capture locals by reference. One loop runs at a time, ParallelFor must not be called from a job.
+ */
+class JobSystem
+{
+private:
+    /**
+     * @brief Worker threads.
+     */
+    std::vector<std::thread> mWorkers;
+
+    /**
+     * @brief Guards the job description and the worker counters.
+     */
+    std::mutex mMutex;
+
+    /**
+     * @brief Wakes the workers when a loop starts or the pool stops.
+     */
+    std::condition_variable mWakeCondition;
+
+    /**
+     * @brief Wakes the calling thread when a worker leaves the loop.
+     */
+    std::condition_variable mDoneCondition;
+
+    /**
+     * @brief Body of the running loop, or nullptr between loops.
+     */
+    const std::function<void(size_t, size_t)>* mJob = nullptr;
+
+    /**
+     * @brief Number of iterations of the running loop.
+     */
+    size_t mJobCount = 0;
+
+    /**
+     * @brief Number of iterations taken at once.
+     */
+    size_t mBatchSize = 1;
+
+    /**
+     * @brief First iteration not taken yet.
+     */
+    std::atomic<size_t> mNextIndex = 0;
+
+    /**
+     * @brief Number of workers inside the running loop.
+     */
+    int mActiveWorkers = 0;
+
+    /**
+     * @brief Incremented at each loop, so a worker never runs the same loop twice.
+     */
+    uint64_t mGeneration = 0;
+
+    /**
+     * @brief Whether the workers must exit.
+     */
+    bool mStopping = false;
+
+    /**
+     * @brief Loop of a worker thread.
+     * @param pWorkerIndex Index of the worker, names its thread in the profiler.
+     */
+    void WorkerLoop(int pWorkerIndex);
+
+    /**
+     * @brief Takes and runs batches until the loop is fully taken.
+     * @param pJob Body of the loop.
+     * @param pCount Number of iterations.
+     * @param pBatchSize Number of iterations taken at once.
+     */
+    void RunBatches(const std::function<void(size_t, size_t)>& pJob, size_t pCount, size_t pBatchSize);
+
+public:
+    /**
+     * @brief Starts the worker threads.
+     * @param pWorkerCount Number of workers, 0 uses one per hardware core besides the calling thread.
+     */
+    explicit JobSystem(int pWorkerCount = 0);
+
+    /**
+     * @brief Stops and joins the worker threads.
+     */
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+     * @brief Runs a loop over [0, pCount) split in batches, on the workers and the calling thread.
+     * @param pCount Number of iterations.
+     * @param pBatchSize Number of iterations taken at once by a thread.
+     * @param pJob Body of the loop, called with the first and past the last iteration of a batch.
+     */
+    void ParallelFor(size_t pCount, size_t pBatchSize, const std::function<void(size_t, size_t)>& pJob);
+
+    /**
+     * @brief Gets the number of worker threads.
+     * @return The number of workers, the calling thread excluded.
+     */
+    int GetWorkerCount() const
+    {
+        return static_cast<int>(mWorkers.size());
+    }
+
+    /**
+     * @brief Gets the job system shared by the scenes, started on first use.
+     * @return Reference to the shared job system.
+     */
+    static JobSystem& GetInstance();
+};
@@ -0,0 +1,104 @@
+/**
+ * @file ComponentBenchmark.cpp
+ * @brief Implementation of the ComponentBenchmark class, which times Actor::GetComponent.
+ */
+
+#include "ComponentBenchmark.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Log.h"
+#include "Core/Class/Actor/Actor.h"
+#include "Core/Physic/Component/RigidbodyComponent.h"
+#include "Miscellaneous/Component/MoveComponent.h"
+
+/**
+ * @brief Number of actors created for the benchmark.
+ */
+const int BENCHMARK_ACTOR_COUNT = 256;
+
+/**
+ * @brief Number of plain components added before the searched ones, as a mesh or a collider would be.
+ */
+const int BENCHMARK_FILLER_COUNT = 4;
+
+/**
+ * @brief Finds a component the way Actor::GetComponent did before the type table.
+ * @param pComponents Components of the actor.
+ * @return Pointer to the component or nullptr if not found.
+ */
+template<typename T>T* FindComponentWithDynamicCast(const std::vector<Component*>& pComponents)
+{
+    for (Component* component : pComponents)
+    {
+        T* result = dynamic_cast<T*>(component);
+        if (result)
+        {
+            return result;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Runs the benchmark and logs the results.
+ * Each actor holds plain components, a MoveComponent and a RigidbodyComponent last, which is the worst case of the scan.
+ * @param pIterations Number of lookups per actor and per implementation.
+ * @return Exit code of the application.
+ */
+int ComponentBenchmark::Run(int pIterations)
+{
+    std::vector<Actor*> actors;
+    std::vector<std::vector<Component*>> components;
+    for (int i = 0; i < BENCHMARK_ACTOR_COUNT; i++)
+    {
+        Actor* actor = new Actor();
+        for (int j = 0; j < BENCHMARK_FILLER_COUNT; j++)
+        {
+            new Component(actor);
+        }
+        new MoveComponent(actor);
+        new RigidbodyComponent(actor);
+        actors.push_back(actor);
+        components.push_back(actor->GetComponents());
+    }
+
+    // Both loops sum the masses so the lookups cannot be optimized away
+    float checksum = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int iteration = 0; iteration < pIterations; iteration++)
+    {
+        for (const std::vector<Component*>& actorComponents : components)
+        {
+            checksum += FindComponentWithDynamicCast<RigidbodyComponent>(actorComponents)->GetMass();
+        }
+    }
+    double dynamicCastSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int iteration = 0; iteration < pIterations; iteration++)
+    {
+        for (Actor* actor : actors)
+        {
+            checksum -= actor->GetComponent<RigidbodyComponent>()->GetMass();
+        }
+    }
+    double tableSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double lookups = static_cast<double>(pIterations) * BENCHMARK_ACTOR_COUNT;
+    Log::Info("GetComponent benchmark : " + std::to_string(static_cast<long long>(lookups)) + " lookups per implementation (checksum " + std::to_string(checksum) + ")");
+    Log::Info("dynamic_cast scan : " + std::to_string(dynamicCastSeconds * 1e9 / lookups) + " ns per lookup");
+    Log::Info("Type table : " + std::to_string(tableSeconds * 1e9 / lookups) + " ns per lookup");
+    if (tableSeconds > 0.0)
+    {
+        Log::Info("Speedup : x" + std::to_string(dynamicCastSeconds / tableSeconds));
+    }
+
+    for (Actor* actor : actors)
+    {
+        delete actor;
+    }
+    return 0;
+}
@@ -0,0 +1,23 @@
+/**
+ * @file ComponentBenchmark.h
+ * @brief Declaration of the ComponentBenchmark class, which times Actor::GetComponent.
+ */
+
+#pragma once
+
+/**
+ * @class ComponentBenchmark
+ * @brief Compares Actor::GetComponent against the previous dynamic_cast scan on headless actors.
+ */
+class ComponentBenchmark
+{
+public:
+    ComponentBenchmark() = delete; /**< Deleted default constructor to prevent instantiation. */
+
+    /**
+     * @brief Runs the benchmark and logs the results.
+     * @param pIterations Number of lookups per actor and per implementation.
+     * @return Exit code of the application.
+     */
+    static int Run(int pIterations);
+};
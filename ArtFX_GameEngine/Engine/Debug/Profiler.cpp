@@ -0,0 +1,213 @@
+/**
+ * @file Profiler.cpp
+ * @brief Implementation of the Profiler class, which records timed scopes per thread.
+ */
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+#include "Log.h"
+
+std::mutex Profiler::mMutex;
+std::vector<std::unique_ptr<Profiler::ThreadBuffer>> Profiler::mBuffers = {};
+thread_local Profiler::ThreadBuffer* Profiler::mThreadBuffer = nullptr;
+std::unordered_map<std::string, Profiler::PhaseHistory, StringHash, std::equal_to<>> Profiler::mPhases = {};
+uint64_t Profiler::mFrameCount = 0;
+uint64_t Profiler::mFrameFirstEvent = 0;
+
+/**
+ * @brief Time the profiler started, origin of the recorded times.
+ */
+static const std::chrono::steady_clock::time_point PROFILER_START = std::chrono::steady_clock::now();
+
+/**
+ * @brief Gets the current time.
+ * @return Nanoseconds since the profiler started.
+ */
+int64_t Profiler::Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - PROFILER_START).count();
+}
+
+/**
+ * @brief Gets the buffer of the calling thread, creating it on first use.
+ * @return The buffer.
+ */
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+{
+    if (!mThreadBuffer)
+    {
+        std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+        buffer->events = std::make_unique<ProfileEvent[]>(BufferCapacity);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        buffer->id = static_cast<int>(mBuffers.size());
+        buffer->name = "Thread " + std::to_string(buffer->id);
+        mThreadBuffer = buffer.get();
+        mBuffers.push_back(std::move(buffer));
+    }
+    return *mThreadBuffer;
+}
+
+/**
+ * @brief Records a scope in the buffer of the calling thread.
+ * @param pName Name of the scope, must outlive the profiler.
+ * @param pStart Start of the scope, from Now.
+ * @param pEnd End of the scope, from Now.
+ */
+void Profiler::Record(const char* pName, int64_t pStart, int64_t pEnd)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    uint64_t count = buffer.count.load(std::memory_order_relaxed);
+    buffer.events[count % BufferCapacity] = {pName, pStart, pEnd - pStart};
+    buffer.count.store(count + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Names the calling thread in the traces.
+ * @param pName Name of the thread.
+ */
+void Profiler::SetThreadName(const std::string& pName)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(mMutex);
+    buffer.name = pName;
+}
+
+/**
+ * @brief Sums the scopes recorded by the calling thread since the last call into the rolling averages.
+ * Call once per frame from the main thread.
+ */
+void Profiler::EndFrame()
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    uint64_t count = buffer.count.load(std::memory_order_relaxed);
+    // Scopes overwritten since the last frame are lost
+    uint64_t first = std::max(mFrameFirstEvent, count > BufferCapacity ? count - BufferCapacity : 0);
+    for (uint64_t i = first; i < count; i++)
+    {
+        const ProfileEvent& event = buffer.events[i % BufferCapacity];
+        auto phase = mPhases.find(std::string_view(event.name));
+        if (phase == mPhases.end())
+        {
+            phase = mPhases.emplace(event.name, PhaseHistory()).first;
+        }
+        phase->second.current += event.duration;
+    }
+    mFrameFirstEvent = count;
+
+    size_t slot = mFrameCount % AverageWindow;
+    for (auto& phase : mPhases)
+    {
+        PhaseHistory& history = phase.second;
+        history.sum += history.current - history.frames[slot];
+        history.frames[slot] = history.current;
+        history.current = 0;
+        history.samples = std::min(history.samples + 1, AverageWindow);
+    }
+    mFrameCount++;
+}
+
+/**
+ * @brief Gets the rolling average of a scope of the main thread. Call from the main thread.
+ * @param pName Name of the scope.
+ * Averaged over the frames since the scope was first seen, so a scope starting mid-window is not under-reported.
+ * @return Average time spent in the scope per frame, in milliseconds, 0 if never recorded.
+ */
+float Profiler::GetAverageMs(std::string_view pName)
+{
+    auto phase = mPhases.find(pName);
+    if (phase == mPhases.end() || phase->second.samples == 0) return 0.0f;
+
+    return static_cast<float>(static_cast<double>(phase->second.sum) / static_cast<double>(phase->second.samples) * 1e-6);
+}
+
+/**
+ * @brief Logs the rolling average of every scope of the main thread. Call from the main thread.
+ */
+void Profiler::LogAverages()
+{
+    std::vector<std::pair<float, std::string>> averages;
+    for (const auto& phase : mPhases)
+    {
+        averages.emplace_back(GetAverageMs(phase.first), phase.first);
+    }
+    std::sort(averages.begin(), averages.end(), std::greater<>());
+
+    Log::Info("Average over the last " + std::to_string(std::min<uint64_t>(mFrameCount, AverageWindow)) + " frames :");
+    for (const auto& average : averages)
+    {
+        Log::Info("  " + average.second + " : " + std::to_string(average.first) + " ms");
+    }
+}
+
+/**
+ * @brief Writes a string as a JSON string.
+ * @param pStream The output stream.
+ * @param pString The string.
+ */
+static void WriteJsonString(std::ofstream& pStream, std::string_view pString)
+{
+    pStream << '"';
+    for (char character : pString)
+    {
+        if (character == '"' || character == '\\') pStream << '\\';
+        pStream << character;
+    }
+    pStream << '"';
+}
+
+/**
+ * @brief Writes the buffers of every thread as a Chrome trace.
+ * Threads still recording may overwrite the oldest scopes while they are written.
+ * @param pFilePath Path to the JSON file.
+ * @return True if the file was written.
+ */
+bool Profiler::WriteChromeTrace(const std::string& pFilePath)
+{
+    std::ofstream file(pFilePath, std::ios::trunc);
+    if (!file)
+    {
+        Log::Error(LogType::Application, "Could not write trace " + pFilePath);
+        return false;
+    }
+
+    // Microseconds with a nanosecond precision, the default precision would round long sessions
+    file << std::fixed << std::setprecision(3);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    size_t eventCount = 0;
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : mBuffers)
+    {
+        if (!first) file << ",\n";
+        first = false;
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id << ",\"args\":{\"name\":";
+        WriteJsonString(file, buffer->name);
+        file << "}}";
+
+        uint64_t count = buffer->count.load(std::memory_order_acquire);
+        for (uint64_t i = count > BufferCapacity ? count - BufferCapacity : 0; i < count; i++)
+        {
+            const ProfileEvent& event = buffer->events[i % BufferCapacity];
+            file << ",\n{\"name\":";
+            WriteJsonString(file, event.name);
+            file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id << ",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << event.duration / 1000.0 << "}";
+            eventCount++;
+        }
+    }
+    file << "\n]}\n";
+
+    if (!file)
+    {
+        Log::Error(LogType::Application, "Could not write trace " + pFilePath);
+        return false;
+    }
+    Log::Info("Wrote " + std::to_string(eventCount) + " profiled scopes to " + pFilePath);
+    return true;
+}
@@ -0,0 +1,231 @@
+/**
+ * @file Profiler.h
+ * @brief Declaration of the Profiler class and of the profiling macros, compiled out without _DEBUG.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Core/StringHash.h"
+
+#if defined(_DEBUG) && !defined(PROFILER_DISABLED)
+#define PROFILER_ENABLED 1
+#else
+#define PROFILER_ENABLED 0
+#endif
+
+/**
+ * @struct ProfileEvent
+ * @brief A timed scope, in nanoseconds since the profiler started.
+ */
+struct ProfileEvent
+{
+    /**
+     * @brief Name of the scope, a string literal.
+     */
+    const char* name;
+
+    /**
+     * @brief Start of the scope.
+     */
+    int64_t start;
+
+    /**
+     * @brief Duration of the scope.
+     */
+    int64_t duration;
+};
+
+/**
+ * @class Profiler
+ * @brief Records timed scopes into one ring buffer per thread, without locking.
+ *
+ * The buffers keep the last BufferCapacity scopes of each thread and can be written as a Chrome trace, readable
+ * in chrome://tracing or Perfetto. The scopes of the thread calling EndFrame are also summed by name every frame
+ * into rolling averages, so the time of each frame phase can be read from code.
+ */
+class Profiler
+{
+public:
+    /**
+     * @brief Number of scopes kept per thread.
+     */
+    static constexpr size_t BufferCapacity = 1 << 15;
+
+    /**
+     * @brief Number of frames of the rolling averages.
+     */
+    static constexpr int AverageWindow = 60;
+
+    Profiler() = delete; /**< Deleted default constructor to prevent instantiation. */
+
+    /**
+     * @brief Gets the current time.
+     * @return Nanoseconds since the profiler started.
+     */
+    static int64_t Now();
+
+    /**
+     * @brief Records a scope in the buffer of the calling thread.
+     * @param pName Name of the scope, must outlive the profiler.
+     * @param pStart Start of the scope, from Now.
+     * @param pEnd End of the scope, from Now.
+     */
+    static void Record(const char* pName, int64_t pStart, int64_t pEnd);
+
+    /**
+     * @brief Names the calling thread in the traces.
+     * @param pName Name of the thread.
+     */
+    static void SetThreadName(const std::string& pName);
+
+    /**
+     * @brief Sums the scopes recorded by the calling thread since the last call into the rolling averages.
+     * Call once per frame from the main thread.
+     */
+    static void EndFrame();
+
+    /**
+     * @brief Gets the rolling average of a scope of the main thread. Call from the main thread.
+     * @param pName Name of the scope.
+     * @return Average time spent in the scope per frame, in milliseconds, 0 if never recorded.
+     */
+    static float GetAverageMs(std::string_view pName);
+
+    /**
+     * @brief Logs the rolling average of every scope of the main thread. Call from the main thread.
+     */
+    static void LogAverages();
+
+    /**
+     * @brief Writes the buffers of every thread as a Chrome trace.
+     * Threads still recording may overwrite the oldest scopes while they are written.
+     * @param pFilePath Path to the JSON file.
+     * @return True if the file was written.
+     */
+    static bool WriteChromeTrace(const std::string& pFilePath);
+
+private:
+    /**
+     * @struct ThreadBuffer
+     * @brief Ring buffer of the scopes of a thread, written by that thread only.
+     */
+    struct ThreadBuffer
+    {
+        int id = 0;                                     /**< Thread id in the traces. */
+        std::string name;                               /**< Thread name in the traces. */
+        std::unique_ptr<ProfileEvent[]> events;         /**< The ring, BufferCapacity scopes. */
+        std::atomic<uint64_t> count = 0;                /**< Number of scopes ever recorded. */
+    };
+
+    /**
+     * @struct PhaseHistory
+     * @brief Time spent in a scope over the last frames.
+     */
+    struct PhaseHistory
+    {
+        std::array<int64_t, AverageWindow> frames = {}; /**< Time of each frame of the window, by frame index modulo the window. */
+        int64_t sum = 0;                                /**< Sum of frames. */
+        int64_t current = 0;                            /**< Time of the frame being summed. */
+        int samples = 0;                                /**< Frames of the window since the scope was first seen. */
+    };
+
+    /**
+     * @brief Guards mBuffers and the thread names.
+     */
+    static std::mutex mMutex;
+
+    /**
+     * @brief Buffers of every thread that recorded a scope. Kept after their thread ends so its scopes can be written.
+     */
+    static std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+
+    /**
+     * @brief Buffer of the calling thread, nullptr until it records a scope.
+     */
+    static thread_local ThreadBuffer* mThreadBuffer;
+
+    /**
+     * @brief Rolling averages of the main thread scopes, by name.
+     */
+    static std::unordered_map<std::string, PhaseHistory, StringHash, std::equal_to<>> mPhases;
+
+    /**
+     * @brief Number of frames ended.
+     */
+    static uint64_t mFrameCount;
+
+    /**
+     * @brief First scope of the main thread not summed yet.
+     */
+    static uint64_t mFrameFirstEvent;
+
+    /**
+     * @brief Gets the buffer of the calling thread, creating it on first use.
+     * @return The buffer.
+     */
+    static ThreadBuffer& GetThreadBuffer();
+};
+
+/**
+ * @class ProfileScope
+ * @brief Records the time between its construction and its destruction. Use through PROFILE_SCOPE.
+ */
+class ProfileScope
+{
+private:
+    /**
+     * @brief Name of the scope.
+     */
+    const char* mName;
+
+    /**
+     * @brief Start of the scope.
+     */
+    int64_t mStart;
+
+public:
+    /**
+     * @brief Starts the scope.
+     * @param pName Name of the scope, a string literal.
+     */
+    explicit ProfileScope(const char* pName) : mName(pName), mStart(Profiler::Now())
+    {
+    }
+
+    /**
+     * @brief Ends and records the scope.
+     */
+    ~ProfileScope()
+    {
+        Profiler::Record(mName, mStart, Profiler::Now());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#if PROFILER_ENABLED
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+/** @brief Times the rest of the enclosing block under a name. */
+#define PROFILE_SCOPE(pName) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(pName)
+/** @brief Times the rest of the enclosing function under its name. */
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+/** @brief Ends the profiled frame, see Profiler::EndFrame. */
+#define PROFILE_END_FRAME() Profiler::EndFrame()
+/** @brief Names the calling thread in the traces. */
+#define PROFILE_THREAD_NAME(pName) Profiler::SetThreadName(pName)
+#else
+#define PROFILE_SCOPE(pName)
+#define PROFILE_FUNCTION()
+#define PROFILE_END_FRAME()
+#define PROFILE_THREAD_NAME(pName)
+#endif
@@ -0,0 +1,70 @@
+/**
+ * @file SceneLoadBenchmark.cpp
+ * @brief Implementation of the SceneLoadBenchmark class, which times the loading of a scene file.
+ */
+
+#include "SceneLoadBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "Log.h"
+#include "Core/Class/Actor/Actor.h"
+#include "Core/Class/Scene/SceneFile.h"
+#include "Core/Class/Scene/SceneSerializer.h"
+
+/**
+ * @brief Runs the benchmark and logs the results.
+ * The meshes are read once without being uploaded, the textures are skipped as there is no renderer.
+ * @param pFilePath Path to the scene file.
+ * @param pIterations Number of times the file is mapped and instantiated.
+ * @return Exit code of the application.
+ */
+int SceneLoadBenchmark::Run(const std::string& pFilePath, int pIterations)
+{
+    pIterations = std::max(1, pIterations);
+
+    SceneFile file;
+    auto start = std::chrono::steady_clock::now();
+    if (!file.Open(pFilePath)) return 1;
+    double firstOpenSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    SceneSerializer::LoadAssets(file, nullptr, false);
+    double assetSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // The file stays in the system cache, the following opens only measure the mapping and the header checks
+    double openSeconds = 0.0;
+    double instantiateSeconds = 0.0;
+    double destroySeconds = 0.0;
+    size_t actorCount = 0;
+    for (int iteration = 0; iteration < pIterations; iteration++)
+    {
+        start = std::chrono::steady_clock::now();
+        file.Open(pFilePath);
+        openSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        std::vector<Actor*> actors = SceneSerializer::Instantiate(file, nullptr);
+        instantiateSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        actorCount = actors.size();
+
+        start = std::chrono::steady_clock::now();
+        for (Actor* actor : actors)
+        {
+            delete actor;
+        }
+        destroySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    Log::Info("Scene load benchmark : " + pFilePath + ", " + std::to_string(file.GetActors().size()) + " actors, " +
+        std::to_string(file.GetComponents().size()) + " components, " + std::to_string(file.GetAssets().size()) + " assets");
+    Log::Info("First open : " + std::to_string(firstOpenSeconds * 1e3) + " ms");
+    Log::Info("Mesh loading : " + std::to_string(assetSeconds * 1e3) + " ms");
+    Log::Info("Open : " + std::to_string(openSeconds * 1e6 / pIterations) + " us per load");
+    Log::Info("Instantiate : " + std::to_string(instantiateSeconds * 1e6 / pIterations) + " us per load, " +
+        std::to_string(actorCount * pIterations / std::max(instantiateSeconds, 1e-9)) + " actors/s");
+    Log::Info("Destroy : " + std::to_string(destroySeconds * 1e6 / pIterations) + " us per load");
+    return 0;
+}
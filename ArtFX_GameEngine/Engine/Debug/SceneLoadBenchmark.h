@@ -0,0 +1,25 @@
+/**
+ * @file SceneLoadBenchmark.h
+ * @brief Declaration of the SceneLoadBenchmark class, which times the loading of a scene file.
+ */
+
+#pragma once
+#include <string>
+
+/**
+ * @class SceneLoadBenchmark
+ * @brief Times mapping a scene file, loading its meshes and instantiating its actors, headless.
+ */
+class SceneLoadBenchmark
+{
+public:
+    SceneLoadBenchmark() = delete; /**< Deleted default constructor to prevent instantiation. */
+
+    /**
+     * @brief Runs the benchmark and logs the results.
+     * @param pFilePath Path to the scene file.
+     * @param pIterations Number of times the file is mapped and instantiated.
+     * @return Exit code of the application.
+     */
+    static int Run(const std::string& pFilePath, int pIterations);
+};
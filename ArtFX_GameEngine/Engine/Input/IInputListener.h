@@ -14,9 +14,9 @@ class IInputListener
 {
 public:
     /**
-     * @brief Virtual destructor for IInputListener.
+     * @brief Virtual destructor for IInputListener. Unbinds the listener from every key.
      */
-    virtual ~IInputListener() = default;
+    virtual ~IInputListener();
 
     /**
      * @brief Callback method invoked when an input event occurs.
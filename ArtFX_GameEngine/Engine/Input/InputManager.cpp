@@ -4,6 +4,7 @@
  */
 
 #include "InputManager.h"
+#include "IInputListener.h"
 
 /**
  * @brief Destructor for InputManager. Cleans up all input events.
@@ -55,3 +56,23 @@ void InputManager::BindTo(SDL_Scancode keyCode, IInputListener* listener)
     }
     mInputEvents[keyCode]->BindEvent(listener);
 }
+
+/**
+ * @brief Unbinds an input listener from every key.
+ * @param listener Pointer to the input listener to unbind.
+ */
+void InputManager::Unbind(IInputListener* listener)
+{
+    for(auto& inputEvent : mInputEvents)
+    {
+        inputEvent.second->UnBindEvent(listener);
+    }
+}
+
+/**
+ * @brief Destructor for IInputListener. Unbinds the listener, so the components of an unloaded scene stop receiving inputs.
+ */
+IInputListener::~IInputListener()
+{
+    InputManager::Instance().Unbind(this);
+}
@@ -58,4 +58,10 @@ public:
      * @param listener Pointer to the input listener to bind.
      */
     void BindTo(SDL_Scancode keyCode, IInputListener* listener);
+
+    /**
+     * @brief Unbinds an input listener from every key.
+     * @param listener Pointer to the input listener to unbind.
+     */
+    void Unbind(IInputListener* listener);
 };
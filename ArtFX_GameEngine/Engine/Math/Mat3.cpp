@@ -84,6 +84,15 @@ Mat3 Mat3::operator*(const Mat3& rhs) const
     return result;
 }
 
+Mat3 Mat3::operator*(float scalar) const
+{
+    Mat3 result;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            result.m[i][j] = m[i][j] * scalar;
+    return result;
+}
+
 Vec3 Mat3::operator*(const Vec3& v) const
 {
     return Vec3(
@@ -23,6 +23,8 @@ public:
 
     Mat3 operator*(const Mat3& rhs) const;
 
+    Mat3 operator*(float scalar) const;
+
     Vec3 operator*(const Vec3& v) const;
 
     static Mat3 CrossProductMatrix(const Vec3& v);
@@ -280,6 +280,36 @@ public:
 		return Matrix4Row(mat);
 	}
 
+	// Same as CreateScale(scale) * CreateFromQuaternion(rotation) * CreateTranslation(position),
+	// without building and multiplying the three matrices
+	static Matrix4Row CreateFromTRS(const Vec3& position, const Quaternion& rotation, const Vec3& scale)
+	{
+		const Quaternion& q = rotation;
+		float temp[4][4] =
+		{
+			{
+				(1.0f - 2.0f * q.y * q.y - 2.0f * q.z * q.z) * scale.x,
+				(2.0f * q.x * q.y + 2.0f * q.w * q.z) * scale.x,
+				(2.0f * q.x * q.z - 2.0f * q.w * q.y) * scale.x,
+				0.0f
+			},
+			{
+				(2.0f * q.x * q.y - 2.0f * q.w * q.z) * scale.y,
+				(1.0f - 2.0f * q.x * q.x - 2.0f * q.z * q.z) * scale.y,
+				(2.0f * q.y * q.z + 2.0f * q.w * q.x) * scale.y,
+				0.0f
+			},
+			{
+				(2.0f * q.x * q.z + 2.0f * q.w * q.y) * scale.z,
+				(2.0f * q.y * q.z - 2.0f * q.w * q.x) * scale.z,
+				(1.0f - 2.0f * q.x * q.x - 2.0f * q.y * q.y) * scale.z,
+				0.0f
+			},
+			{ position.x, position.y, position.z, 1.0f }
+		};
+		return Matrix4Row(temp);
+	}
+
 	static Matrix4Row CreateLookAt(const Vec3& eye, const Vec3& target, const Vec3& up)
 	{
 		Vec3 zaxis = Vec3::Normalize(target - eye);
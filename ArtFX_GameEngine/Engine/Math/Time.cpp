@@ -7,6 +7,7 @@ unsigned int Time::mFrameStart = 0;
 unsigned int Time::mFrameTime = 0;
 unsigned int Time::mLastFrame = 0;
 float Time::deltaTime = 0;
+float Time::elapsedTime = 0;
 
 unsigned int Time::ComputeDeltaTime()
 {
@@ -15,6 +16,7 @@ unsigned int Time::ComputeDeltaTime()
     mLastFrame = mFrameStart;
     dt = std::min(dt, MAX_DT);
     deltaTime = dt / 1000.0f;
+    elapsedTime += deltaTime;
     return dt;
 }
 
@@ -12,8 +12,13 @@ public:
 
     static float deltaTime;
 
-private:
+    //Time since the first frame in seconds, sent to the shaders with the frame data
+    static float elapsedTime;
+
+    //Target frame rate, the physics is stepped once per frame
     const static unsigned int FPS = 144;
+
+private:
     const static unsigned int FRAME_DELAY = 1000 / FPS;
     //Maximum Delta Time
     const static unsigned int MAX_DT = 50; 
@@ -1,6 +1,9 @@
 ﻿#include "Transform.h"
 
+#include <algorithm>
 #include "Core/Class/Actor/Actor.h"
+#include "Core/Class/Scene/TransformHierarchy.h"
+#include "Debug/Log.h"
 
 Transform::Transform(Actor* owner, Vec3 position, Vec3 scale, Quaternion rotation) : owner(owner), position(position), scale(scale), rotation(rotation)
 {
@@ -12,16 +15,101 @@ Transform::Transform(Actor* owner) : owner(owner), position(Vec3::zero), scale(V
     mNeedsUpdate = true;
 }
 
+Transform::~Transform()
+{
+    SetParent(nullptr);
+    while (!mChildren.empty())
+    {
+        mChildren.back()->SetParent(nullptr);
+    }
+    if (mHierarchy)
+    {
+        mHierarchy->Unregister(this);
+    }
+}
+
 void Transform::ComputeWorldTransform()
 {
+    // A dirty parent always has dirty children, so it only needs to be checked when this one is dirty
     if(!mNeedsUpdate) return;
+    if(mParent && mParent->mNeedsUpdate)
+    {
+        mParent->ComputeWorldTransform();
+    }
+    UpdateWorldTransform();
+}
+
+// Expects the parent to be up to date
+void Transform::UpdateWorldTransform()
+{
     mNeedsUpdate = false;
-    worldTransform = Matrix4Row::CreateScale(scale);
-    worldTransform *= Matrix4Row::CreateFromQuaternion(rotation);
-    worldTransform *= Matrix4Row::CreateTranslation(position);
+    worldTransform = Matrix4Row::CreateFromTRS(position, rotation, scale);
+    if(mParent)
+    {
+        worldTransform = worldTransform * mParent->worldTransform;
+    }
     owner->UpdateComponentsTransform();
 }
 
+void Transform::SetParent(Transform* pParent)
+{
+    if(pParent == mParent) return;
+    for(Transform* ancestor = pParent; ancestor; ancestor = ancestor->mParent)
+    {
+        if(ancestor == this)
+        {
+            Log::Error(LogType::Error, "A transform can not be attached to itself or to one of its children");
+            return;
+        }
+    }
+
+    if(mParent)
+    {
+        std::erase(mParent->mChildren, this);
+    }
+    mParent = pParent;
+    if(mParent)
+    {
+        mParent->mChildren.push_back(this);
+    }
+
+    if(mHierarchy)
+    {
+        mHierarchy->MarkOrderDirty();
+    }
+    SetNeedsUpdate(true);
+}
+
+void Transform::SetNeedsUpdate(bool needsUpdate)
+{
+    if(!needsUpdate)
+    {
+        mNeedsUpdate = false;
+        return;
+    }
+    if(mNeedsUpdate) return;
+
+    // Only the topmost dirty transform is queued, the hierarchy recomputes its whole subtree
+    if(mHierarchy && (!mParent || mParent->mHierarchy != mHierarchy || !mParent->mNeedsUpdate))
+    {
+        mHierarchy->MarkDirty(this);
+    }
+    MarkSubtreeDirty();
+}
+
+void Transform::MarkSubtreeDirty()
+{
+    mNeedsUpdate = true;
+    for(Transform* child : mChildren)
+    {
+        // An already dirty child already has dirty children
+        if(!child->mNeedsUpdate)
+        {
+            child->MarkSubtreeDirty();
+        }
+    }
+}
+
 Vec3 Transform::GetPosition()
 {
     return position;
@@ -39,7 +127,7 @@ Quaternion Transform::GetRotation()
 
 void Transform::ForceComputeWorldTransform()
 {
-    mNeedsUpdate = true;
+    SetNeedsUpdate(true);
     ComputeWorldTransform();
 }
 
@@ -63,14 +151,14 @@ void Transform::Rotate(Vec3 pRotation)
         newRotation = Quaternion::Concatenate(newRotation, increment);
     }
     rotation = newRotation;    
-    mNeedsUpdate = true;
+    SetNeedsUpdate(true);
 }
 
 void Transform::Rotate(float pRotation, Vec3 pAxis)
 {
     Quaternion increment(pAxis, pRotation);
     rotation = Quaternion::Concatenate(rotation, increment);
-    mNeedsUpdate = true;
+    SetNeedsUpdate(true);
 }
 
 void Transform::RotateX(float pRotation)
@@ -79,7 +167,7 @@ void Transform::RotateX(float pRotation)
     Quaternion increment = Quaternion(Vec3::unitZ, pRotation);
     newRotation = Quaternion::Concatenate(newRotation, increment);
     rotation = newRotation;
-    mNeedsUpdate = true;
+    SetNeedsUpdate(true);
 }
 
 void Transform::RotateY(float pRotation)
@@ -88,7 +176,7 @@ void Transform::RotateY(float pRotation)
     Quaternion increment = Quaternion(Vec3::unitX, pRotation);
     newRotation = Quaternion::Concatenate(newRotation, increment);
     rotation = newRotation;
-    mNeedsUpdate = true;
+    SetNeedsUpdate(true);
 }
 
 void Transform::RotateZ(float pRotation)
@@ -97,5 +185,5 @@ void Transform::RotateZ(float pRotation)
     Quaternion increment = Quaternion(Vec3::unitY, pRotation);
     newRotation = Quaternion::Concatenate(newRotation, increment);
     rotation = newRotation;
-    mNeedsUpdate = true;
+    SetNeedsUpdate(true);
 }
\ No newline at end of file
@@ -1,15 +1,33 @@
 ﻿#pragma once
 
+#include <vector>
 #include "Matrix4Row.h"
 #include "Quaternion.h"
 #include "Vec3.h"
 
 class Actor;
+class TransformHierarchy;
 
 class Transform
 {
 private:
+    // Set when the local values changed, or when a parent did. A dirty transform always has dirty children
     bool mNeedsUpdate;
+
+    Transform* mParent = nullptr;
+    std::vector<Transform*> mChildren;
+
+    // Scene pass computing this transform, nullptr when the owner computes it in Actor::Update
+    TransformHierarchy* mHierarchy = nullptr;
+    size_t mHierarchySlot = 0;
+    // Range of this transform and its descendants in the update order of the hierarchy
+    size_t mOrderBegin = 0;
+    size_t mOrderEnd = 0;
+
+    friend class TransformHierarchy;
+
+    void UpdateWorldTransform();
+    void MarkSubtreeDirty();
     
 public:
     Vec3 position;
@@ -22,9 +40,35 @@ public:
 public:
     Transform(Actor* owner,Vec3 position, Vec3 scale, Quaternion rotation);
     Transform(Actor* owner);
+    ~Transform();
+
+    // Owned by its actor and linked to its parent and children, so it can not be copied
+    Transform(const Transform&) = delete;
+    Transform& operator=(const Transform&) = delete;
 
     void ComputeWorldTransform();
 
+    // Position, rotation and scale stay local, the world transform is then relative to the parent
+    void SetParent(Transform* pParent);
+    Transform* GetParent() const
+    {
+        return mParent;
+    }
+    const std::vector<Transform*>& GetChildren() const
+    {
+        return mChildren;
+    }
+
+    Vec3 GetWorldPosition() const
+    {
+        return worldTransform.GetTranslation();
+    }
+
+    bool IsInHierarchy() const
+    {
+        return mHierarchy != nullptr;
+    }
+
 public:
     Vec3 GetPosition();
     Vec3 GetScale();
@@ -49,11 +93,14 @@ public:
         return Vec3::Transform(Vec3::unitX, rotation);
     }
 
-    void SetNeedsUpdate(bool needsUpdate)
+    bool NeedsUpdate() const
     {
-        mNeedsUpdate = needsUpdate;
+        return mNeedsUpdate;
     }
 
+    // Marking a transform also marks its children, clearing only affects this one
+    void SetNeedsUpdate(bool needsUpdate);
+
     void ForceComputeWorldTransform();
 
     void Rotate(Vec3 pRotation);
@@ -44,6 +44,15 @@ void CharacterMovementComponent::Update()
     }
 }
 
+/**
+ * @brief Gets what the update touches. The update only moves the owner, the controller sets the speed beforehand.
+ * @return The owner only.
+ */
+ComponentAccess CharacterMovementComponent::GetAccess() const
+{
+    return { AccessOwner, AccessOwner };
+}
+
 /**
  * @brief Called when the component is about to be destroyed or removed.
  */
@@ -12,6 +12,8 @@
  */
 class CharacterMovementComponent : public Component
 {
+    COMPONENT_TYPE(CharacterMovementComponent, Component)
+    POOLED_COMPONENT(CharacterMovementComponent)
 private:
     /**
      * @brief Current jump count of the character.
@@ -47,6 +49,12 @@ public:
      */
     void Update() override;
 
+    /**
+     * @brief Gets what the update touches.
+     * @return The owner only.
+     */
+    ComponentAccess GetAccess() const override;
+
     /**
      * @brief Called when the component is about to be destroyed or removed.
      */
@@ -70,6 +70,11 @@ void FpsCameraMovement::Update()
     mOwner->SetLocation(newPosition);
 }
 
+UpdatePhase FpsCameraMovement::GetUpdatePhase() const
+{
+    return UpdatePhase::Late;
+}
+
 void FpsCameraMovement::OnEnd()
 {
     Component::OnEnd();
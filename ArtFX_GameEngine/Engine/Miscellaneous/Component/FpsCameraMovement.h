@@ -16,6 +16,7 @@ class Camera;
  */
 class FpsCameraMovement : public Component, IInputListener
 {
+    COMPONENT_TYPE(FpsCameraMovement, Component)
 private:
     /**
      * @brief Pointer to the camera associated with this component.
@@ -79,6 +80,12 @@ public:
      */
     void Update() override;
 
+    /**
+     * @brief Gets the phase of the frame in which the camera is updated.
+     * @return UpdatePhase::Late, so the view follows the actors moved by the physics.
+     */
+    UpdatePhase GetUpdatePhase() const override;
+
     /**
      * @brief Called when the component is about to be destroyed or removed.
      */
@@ -28,3 +28,9 @@ void MoveComponent::Update()
         mOwner->SetLocation(newPosition);
     }
 }
+
+// Only moves its owner, so the scene can update the move components of different actors in parallel
+ComponentAccess MoveComponent::GetAccess() const
+{
+    return { AccessOwner, AccessOwner };
+}
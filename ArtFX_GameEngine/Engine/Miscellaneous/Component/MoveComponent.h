@@ -4,6 +4,8 @@
 
 class MoveComponent : public Component
 {
+    COMPONENT_TYPE(MoveComponent, Component)
+    POOLED_COMPONENT(MoveComponent)
 protected:
     Vec2 mSpeed;
     
@@ -17,6 +19,7 @@ public:
     void SetSpeed(Vec2 speed);
 
     void Update() override;
+    ComponentAccess GetAccess() const override;
 
     
 };
@@ -4,6 +4,7 @@
 
 class PlayerController : public MoveComponent, public IInputListener
 {
+    COMPONENT_TYPE(PlayerController, MoveComponent)
 protected:
     float mWalkSpeed = 100.0f;
     
@@ -4,11 +4,16 @@
  */
 
 #include "Game.h"
+#include <chrono>
 #include <iostream>
 
+#include "Core/Class/Scene/SceneSerializer.h"
 #include "Core/Physic/PhysicEngine.h"
+#include "Core/Render/Asset.h"
 #include "Core/Render/OpenGL/RendererGL.h"
+#include "Core/Render/Shader/ShaderCache.h"
 #include "Debug/Log.h"
+#include "Debug/Profiler.h"
 #include "Engine/Math/Time.h"
 #include "Input/InputManager.h"
 
@@ -35,6 +40,7 @@ Game::Game(std::string pName, std::vector<Scene*> pScenes, int pLoadedScene): mN
  */
 void Game::Initialize()
 {
+    PROFILE_THREAD_NAME("Main");
     mWindow = new Window(1920,1080, mName);
 
     mRenderer = new RendererGL();
@@ -42,11 +48,28 @@ void Game::Initialize()
     if(mWindow->Open() && mRenderer->Initialize(*mWindow))
     {
         if(mScenes.size() == 1) mLoadedScene = 0;
+        Scene::ActiveScene = mScenes[mLoadedScene];
         mScenes[mLoadedScene]->SetRenderer(mRenderer);
         mScenes[mLoadedScene]->SetWindow(mWindow);
-        mPhysicEngine = &PhysicEngine::GetInstance();
+        mPhysicEngine = &mScenes[mLoadedScene]->GetPhysicEngine();
+
+        auto start = std::chrono::steady_clock::now();
         mScenes[mLoadedScene]->Load();
         mScenes[mLoadedScene]->Start();
+        // Drivers may defer compiling and linking, wait for the GPU work so it is counted
+        glFinish();
+        double startupMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        Log::Info("Scene " + std::to_string(mLoadedScene) + " started in " + std::to_string(startupMs) + " ms : " +
+            std::to_string(ShaderCache::GetRequestCount()) + " shader programs requested, " +
+            std::to_string(ShaderCache::GetLinkCount()) + " linked, " +
+            std::to_string(ShaderCache::GetBinaryLoadCount()) + " loaded from binaries, " +
+            std::to_string(ShaderCache::GetCompileCount()) + " stages compiled");
+
+        if (mExitAfterStart)
+        {
+            Close();
+            return;
+        }
         Loop();
     } 
 }
@@ -59,6 +82,8 @@ void Game::Loop()
     mIsRunning = true;
     while(mIsRunning)
     {
+        PROFILE_END_FRAME();
+        PROFILE_SCOPE("Frame");
         Time::ComputeDeltaTime();
         
         CheckInputs();
@@ -66,8 +91,12 @@ void Game::Loop()
         Update();
 
         mPhysicEngine->Update();
+
+        LateUpdate();
         
         Render();
+
+        UpdateSceneStreaming();
         
         Time::DelayTime();
     }
@@ -79,10 +108,13 @@ void Game::Loop()
  */
 void Game::Render()
 {
+    PROFILE_SCOPE("Render");
     mRenderer->BeginDraw();
 
     mRenderer->Draw();
     mScenes[mLoadedScene]->Render();
+
+    PROFILE_SCOPE("Present");
     mRenderer->EndDraw();
 }
 
@@ -91,9 +123,104 @@ void Game::Render()
  */
 void Game::Update()
 {
+    PROFILE_SCOPE("Update");
     mScenes[mLoadedScene]->Update();
 }
 
+/**
+ * @brief Updates the logic of the current scene that runs after the physics step.
+ */
+void Game::LateUpdate()
+{
+    PROFILE_SCOPE("LateUpdate");
+    mScenes[mLoadedScene]->LateUpdate();
+}
+
+/**
+ * @brief Starts loading a scene in the background. The loaded scene keeps running until the new one is ready.
+ * The scene Load only queues its assets, which are then decoded by the loader threads.
+ * @param pSceneIndex Index of the scene to load.
+ */
+void Game::LoadSceneAsync(int pSceneIndex)
+{
+    if (pSceneIndex < 0 || pSceneIndex >= static_cast<int>(mScenes.size()) || pSceneIndex == mLoadedScene)
+    {
+        Log::Warning(LogType::Application, "Scene " + std::to_string(pSceneIndex) + " can not be loaded");
+        return;
+    }
+    if (mSceneLoader)
+    {
+        Log::Warning(LogType::Application, "A scene is already being loaded");
+        return;
+    }
+
+    Scene* scene = mScenes[pSceneIndex];
+    scene->SetRenderer(mRenderer);
+    scene->SetWindow(mWindow);
+
+    mSceneLoader = new AssetLoader(*mRenderer);
+    mStreamedScene = pSceneIndex;
+    Asset::SetStreamingLoader(mSceneLoader);
+    scene->Load();
+    Asset::SetStreamingLoader(nullptr);
+    mSceneLoader->Start();
+}
+
+/**
+ * @brief Gets the progress of the scene being loaded in the background.
+ * @return Between 0 and 1, 1 when no scene is being loaded.
+ */
+float Game::GetSceneLoadProgress() const
+{
+    return mSceneLoader ? mSceneLoader->GetProgress() : 1.0f;
+}
+
+/**
+ * @brief Uploads part of the streamed assets after the frame is drawn, then swaps the scenes once they are all uploaded.
+ */
+void Game::UpdateSceneStreaming()
+{
+    if (!mSceneLoader) return;
+
+    PROFILE_SCOPE("SceneStreaming");
+    mSceneLoader->Update();
+    if (mSceneLoader->IsReady())
+    {
+        SwapScene();
+    }
+}
+
+/**
+ * @brief Unloads the loaded scene and starts the streamed one.
+ * The streamed assets are committed after the unload, which clears the assets of the previous scene.
+ */
+void Game::SwapScene()
+{
+    mScenes[mLoadedScene]->Unload();
+    mSceneLoader->Commit();
+    delete mSceneLoader;
+    mSceneLoader = nullptr;
+
+    mLoadedScene = mStreamedScene;
+    mStreamedScene = -1;
+    Scene::ActiveScene = mScenes[mLoadedScene];
+    mPhysicEngine = &mScenes[mLoadedScene]->GetPhysicEngine();
+    mScenes[mLoadedScene]->Start();
+    Log::Info("Scene " + std::to_string(mLoadedScene) + " loaded");
+}
+
+/**
+ * @brief Logs the GL calls issued to draw the meshes of the last frame.
+ */
+void Game::LogRenderStats()
+{
+    const RenderStats& stats = mScenes[mLoadedScene]->GetRenderer().GetStats();
+    Log::Info(std::to_string(stats.meshesVisible) + " meshes drawn, " + std::to_string(stats.meshesCulled) + " culled by the frustum");
+    Log::Info(std::to_string(stats.drawCalls) + " draw calls (" + std::to_string(stats.instances) + " instances), " +
+        std::to_string(stats.programBinds) + " program binds, " +
+        std::to_string(stats.textureBinds) + " texture binds, " + std::to_string(stats.vertexArrayBinds) + " vertex array binds");
+}
+
 /**
  * @brief Checks user inputs and handles events.
  */
@@ -101,6 +228,7 @@ void Game::CheckInputs()
 {
     if(!mIsRunning) return;
 
+    PROFILE_SCOPE("Input");
     SDL_Event event;
     
     while (SDL_PollEvent(&event))
@@ -119,6 +247,11 @@ void Game::CheckInputs()
             if ( event.key.keysym.sym == SDLK_2) mScenes[mLoadedScene]->GetRenderer().SetDawType(DrawType::Wireframe);
             if ( event.key.keysym.sym == SDLK_3) mScenes[mLoadedScene]->GetRenderer().SetDawType(DrawType::Debug);
             if ( event.key.keysym.sym == SDLK_4) mScenes[mLoadedScene]->GetRenderer().SetDawType(DrawType::Collision);
+            if ( event.key.keysym.sym >= SDLK_F1 && event.key.keysym.sym < SDLK_F1 + static_cast<int>(mScenes.size())) LoadSceneAsync(event.key.keysym.sym - SDLK_F1);
+            if ( event.key.keysym.sym == SDLK_F9) LogRenderStats();
+            if ( event.key.keysym.sym == SDLK_F10) Profiler::LogAverages();
+            if ( event.key.keysym.sym == SDLK_F11) Profiler::WriteChromeTrace("ProfilerTrace.json");
+            if ( event.key.keysym.sym == SDLK_F12) SceneSerializer::Export(*mScenes[mLoadedScene], "Resources/Scenes/Scene" + std::to_string(mLoadedScene) + ".scene");
             #endif
             
             break;
@@ -135,7 +268,10 @@ void Game::CheckInputs()
  */
 void Game::Close()
 {
+    delete mSceneLoader;
+    mSceneLoader = nullptr;
     mScenes[mLoadedScene]->Close();
+    ShaderCache::Clear();
     mWindow->Close();
     SDL_Quit();
 }
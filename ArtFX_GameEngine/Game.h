@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "Core/Physic/PhysicEngine.h"
+#include "Core/Render/AssetLoader.h"
 #include "Engine/Core/Class/Scene/Scene.h"
 
 /**
@@ -31,6 +32,36 @@ public:
      * @brief Initializes the game engine.
      */
     void Initialize();
+
+    /**
+     * @brief Starts loading a scene in the background. The loaded scene keeps running until the new one is ready.
+     * @param pSceneIndex Index of the scene to load.
+     */
+    void LoadSceneAsync(int pSceneIndex);
+
+    /**
+     * @brief Gets the progress of the scene being loaded in the background.
+     * @return Between 0 and 1, 1 when no scene is being loaded.
+     */
+    float GetSceneLoadProgress() const;
+
+    /**
+     * @brief Checks if a scene is being loaded in the background.
+     * @return True until the new scene replaces the loaded one.
+     */
+    bool IsLoadingScene() const
+    {
+        return mSceneLoader != nullptr;
+    }
+
+    /**
+     * @brief Makes Initialize close the game once the first scene is started, to measure the startup time.
+     * @param pExitAfterStart Whether the game closes instead of running its loop.
+     */
+    void SetExitAfterStart(bool pExitAfterStart)
+    {
+        mExitAfterStart = pExitAfterStart;
+    }
     
 private:
     /**
@@ -49,7 +80,7 @@ private:
     IRenderer* mRenderer;
 
     /**
-     * @brief Pointer to the physics engine.
+     * @brief Pointer to the physics world of the loaded scene.
      */
     PhysicEngine* mPhysicEngine;
 
@@ -67,6 +98,31 @@ private:
      * @brief Flag indicating whether the game engine is running.
      */
     bool mIsRunning = false;
+
+    /**
+     * @brief Whether Initialize closes the game once the first scene is started.
+     */
+    bool mExitAfterStart = false;
+
+    /**
+     * @brief Loader of the scene loaded in the background, nullptr when no scene is being loaded.
+     */
+    AssetLoader* mSceneLoader = nullptr;
+
+    /**
+     * @brief Index of the scene loaded in the background.
+     */
+    int mStreamedScene = -1;
+
+    /**
+     * @brief Uploads part of the streamed assets, then swaps the scenes once they are all uploaded.
+     */
+    void UpdateSceneStreaming();
+
+    /**
+     * @brief Unloads the loaded scene and starts the streamed one.
+     */
+    void SwapScene();
     
     /**
      * @brief Main loop of the game engine.
@@ -83,11 +139,21 @@ private:
      */
     void Update();
 
+    /**
+     * @brief Updates the logic of the current scene that runs after the physics step.
+     */
+    void LateUpdate();
+
     /**
      * @brief Checks user inputs and handles events.
      */
     void CheckInputs();
 
+    /**
+     * @brief Logs the meshes drawn and culled, and the GL calls issued to draw them, in the last frame.
+     */
+    void LogRenderStats();
+
     /**
      * @brief Closes the game engine and releases resources.
      */
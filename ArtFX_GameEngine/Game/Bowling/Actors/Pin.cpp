@@ -1,5 +1,6 @@
 ﻿#include "Pin.h"
 
+#include "Bowling/BowlingConstants.h"
 #include "Core/Physic/Component/PolyCollisionComponent.h"
 #include "Core/Physic/Component/RigidbodyComponent.h"
 #include "Core/Render/Asset.h"
@@ -14,7 +15,7 @@ Pin::Pin() : Actor(), mHitted(false)
 
     RigidbodyComponent* rigidbodyComponent = new RigidbodyComponent(this);
     rigidbodyComponent->SetMass(0.0f);
-    rigidbodyComponent->SetRestitution(0.0f);
+    rigidbodyComponent->SetRestitution(PIN_RESTITUTION);
 
     PolyCollisionComponent* collisionComponent = new PolyCollisionComponent(this);
 
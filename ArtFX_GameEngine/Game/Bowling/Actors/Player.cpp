@@ -4,8 +4,8 @@
 
 #include "Bowling/Component/BowlingController.h"
 #include "Bowling/Manager/PinManager.h"
+#include "Core/Class/Actor/ActorPool.h"
 #include "Core/Physic/Component/RigidbodyComponent.h"
-#include "Core/Physic/Component/SphereCollisionComponent.h"
 #include "Core/Render/Asset.h"
 #include "Core/Render/Component/MeshComponent.h"
 #include "Debug/Log.h"
@@ -18,7 +18,7 @@ Player::Player() : Actor()
     mClassName = "Player";
     mName = "Player_01";
 
-    SetLocation(Vec3(-37.98f, 38.0f, 1.0f));
+    SetLocation(Vec3(PLAYER_POS_X, PLAYER_POS_Y, PLAYER_POS_Z));
 
     //Set Variables
     controller = new BowlingController(this);
@@ -33,6 +33,21 @@ Player::Player() : Actor()
     mBowlingballMesh->SetMesh(Asset::GetMesh("BowlingBall"));
     mBowlingballMesh->AddTexture(Asset::GetTexture("BowlingBall"));
 
+    mBowlingballRigidbody = new RigidbodyComponent(mBowlingball);
+    SetupBall(mBowlingballRigidbody);
+
+    for (int i = 0; i < TRAJECTORY_MARKER_COUNT; i++)
+    {
+        Actor* marker = new Actor();
+        mScene->AddActor(marker);
+        marker->SetScale(Vec3(TRAJECTORY_MARKER_SCALE, TRAJECTORY_MARKER_SCALE, TRAJECTORY_MARKER_SCALE));
+
+        MeshComponent* markerMesh = new MeshComponent(marker);
+        markerMesh->SetMesh(Asset::GetMesh("BowlingBall"));
+        markerMesh->AddTexture(Asset::GetTexture("BowlingBall"));
+        mTrajectoryMarkers.push_back(marker);
+    }
+
     mBowlingBallForceDirArrow = new Actor();
     mScene->AddActor(mBowlingBallForceDirArrow);
     mBowlingBallForceDirArrow->SetScale(Vec3(1.0f,1.0f,mPower));
@@ -49,10 +64,27 @@ Player::Player() : Actor()
     BallRotationArrowMesh->SetMesh(Asset::GetMesh("YellowArrow"));
     BallRotationArrowMesh->AddTexture(Asset::GetTexture("ArrowTexture"));
 
+    ActorPrefab ballPrefab;
+    ballPrefab.name = "BowlingBallThrow";
+    ballPrefab.meshName = "BowlingBall";
+    ballPrefab.textureName = "BowlingBall";
+    ballPrefab.hasRigidbody = true;
+    ballPrefab.collisionType = CollisionType::Sphere;
+    ballPrefab.mass = BALL_MASS;
+    ballPrefab.friction = BALL_FRICTION;
+    ballPrefab.restitution = BALL_RESTITUTION;
+    mBowlingBallPool = new ActorPool(ballPrefab, BALL_POOL_SIZE);
+
     mCameraBasePos = mCamera->GetLocation();
     mCameraBaseRot = mCamera->GetRotation();
 }
 
+//The pooled balls belong to the scene, only the pool is deleted here
+Player::~Player()
+{
+    delete mBowlingBallPool;
+}
+
 void Player::Shoot()
 {
     if (mBowlingState != EBowlingState::PreShoot || !mCanShoot) return;
@@ -64,43 +96,80 @@ void Player::Shoot()
 
     mBowlingBallForceDirArrow->GetComponent<MeshComponent>()->SetVisible(false);
     mBowlingBallRotationArrow->GetComponent<MeshComponent>()->SetVisible(false);
+    SetTrajectoryPreviewVisible(false);
     
-    mBowlingBallThrow = new Actor();
-    mScene->AddActor(mBowlingBallThrow);
+    mBowlingBallThrow = mBowlingBallPool->Spawn(mBowlingball->GetLocation(), GetThrowRotation());
+    LaunchBall(mBowlingBallThrow->GetComponent<RigidbodyComponent>(), mPower, mRotationPower);
+
+    mShootCount++;
+}
+
+//Shared with the throw simulator so both launch the ball the same way
+void Player::LaunchBall(RigidbodyComponent* pBall, float pPower, float pRotationPower)
+{
+    SetupBall(pBall);
+
+    Vec3 impulse, angularImpulse;
+    GetLaunchImpulses(pBall->GetOwner()->GetRotation(), pPower, pRotationPower, impulse, angularImpulse);
+    pBall->ApplyImpulseAngular(angularImpulse);
+    pBall->ApplyImpulse(impulse);
+}
+
+void Player::SetupBall(RigidbodyComponent* pBall)
+{
+    pBall->SetRestitution(BALL_RESTITUTION);
+    pBall->SetFriction(BALL_FRICTION);
+    pBall->SetMass(BALL_MASS);
+}
 
-    mBowlingBallThrow->SetLocation(mBowlingball->GetLocation());
-    mBowlingBallThrow->SetRotation(GetRotation());
-    mBowlingBallThrow->Rotate(Vec3(0.0f,0.0f,-90.0f));
+void Player::GetLaunchImpulses(const Quaternion& pBallRotation, float pPower, float pRotationPower, Vec3& pOutImpulse, Vec3& pOutAngularImpulse)
+{
+    Vec3 forward = Vec3::Transform(Vec3::unitX, pBallRotation);
+    pOutAngularImpulse = ((BALL_SPIN_IMPULSE * -pRotationPower) * BALL_MASS) * forward;
+    pOutImpulse = ((BALL_THROW_IMPULSE * pPower) * BALL_MASS) * forward;
+}
 
-    MeshComponent* bowlingBallMeshComponent = new MeshComponent(mBowlingBallThrow);
-    bowlingBallMeshComponent->SetMesh(Asset::GetMesh("BowlingBall"));
-    bowlingBallMeshComponent->AddTexture(Asset::GetTexture("BowlingBall"));
+//Rotation given to the thrown ball, the player faces the lane along its Z axis
+Quaternion Player::GetThrowRotation()
+{
+    return Quaternion::Concatenate(GetRotation(), Quaternion(Vec3::unitZ, Maths::ToRad(-90.0f)));
+}
 
-    RigidbodyComponent* BowlingBallRb = new RigidbodyComponent(mBowlingBallThrow);
-    BowlingBallRb->SetRestitution(0.0f);
-    BowlingBallRb->SetFriction(0.15f);
-    BowlingBallRb->SetMass(100.8f);
+//Predicts the throw against the static lane and pins, and spreads the markers along the path
+void Player::UpdateTrajectoryPreview()
+{
+    Vec3 impulse, angularImpulse;
+    GetLaunchImpulses(GetThrowRotation(), mPower, mRotationPower, impulse, angularImpulse);
 
-    SphereCollisionComponent* bowlingBallCollisionComponent = new SphereCollisionComponent(mBowlingBallThrow);
+    const std::vector<Vec3>& path = mScene->GetPhysicEngine().PredictTrajectory(mBowlingballRigidbody, impulse, TRAJECTORY_STEPS, angularImpulse);
+    if (path.empty()) return;
 
-    Vec3 forward = Vec3::Transform(Vec3::unitX, mBowlingBallThrow->GetRotation());
-    BowlingBallRb->ApplyImpulseAngular(((5.0f * -mRotationPower) * BowlingBallRb->GetMass()) * forward);
-    BowlingBallRb->ApplyImpulse(((70.0f * mPower) * BowlingBallRb->GetMass()) * forward);
+    for (int i = 0; i < mTrajectoryMarkers.size(); i++)
+    {
+        size_t index = (i + 1) * path.size() / mTrajectoryMarkers.size() - 1;
+        mTrajectoryMarkers[i]->SetLocation(path[index]);
+    }
+}
 
-    mShootCount++;
+void Player::SetTrajectoryPreviewVisible(bool pVisible)
+{
+    for (Actor* marker : mTrajectoryMarkers)
+    {
+        marker->GetComponent<MeshComponent>()->SetVisible(pVisible);
+    }
 }
 
 void Player::Move(float movement)
 {   
     AddLocation(Vec3(movement * Time::deltaTime, 0.0f, 0.0f));
     float loc = GetLocation().x;
-    if (loc < -39.779f)
+    if (loc < PLAYER_MIN_X)
     {
-        SetLocation(Vec3(-39.779f, GetLocation().y, GetLocation().z)); 
+        SetLocation(Vec3(PLAYER_MIN_X, GetLocation().y, GetLocation().z)); 
     }
-    else if (loc > -36.180f)
+    else if (loc > PLAYER_MAX_X)
     {
-        SetLocation(Vec3(-36.180f, GetLocation().y, GetLocation().z));
+        SetLocation(Vec3(PLAYER_MAX_X, GetLocation().y, GetLocation().z));
     }
 }
 
@@ -109,7 +178,8 @@ void Player::Turn(float rotation)
     float rot = rotation * Time::deltaTime;
     Rotate(Vec3(0.0f, 0.0f, rot));
     Vec3 forward = Vec3::Transform(Vec3::unitX, GetRotation());
-    if (forward.y < -0.5f || forward.y > 0.5f)
+    float maxTurn = Maths::Sin(Maths::ToRad(PLAYER_MAX_TURN_ANGLE));
+    if (forward.y < -maxTurn || forward.y > maxTurn)
     {
         Rotate(Vec3(0.0f, 0.0f, -rot));
     }
@@ -117,14 +187,14 @@ void Player::Turn(float rotation)
 
 void Player::ChangePower(float power)
 {
-    mPower = std::clamp(mPower + power, 0.5f, 1.0f);
+    mPower = std::clamp(mPower + power, PLAYER_MIN_POWER, PLAYER_MAX_POWER);
     mBowlingBallForceDirArrow->SetScale(Vec3(1.0f,1.0f,mPower));
     mBowlingBallRotationArrow->SetScale(Vec3(1.0f,1.0f,mPower / 2.0f));
 }
 
 void Player::ChangeRotation(float rotation)
 {
-    mRotationPower = std::clamp(mRotationPower + rotation, -1.0f, 1.0f);
+    mRotationPower = std::clamp(mRotationPower + rotation, -PLAYER_MAX_ROTATION_POWER, PLAYER_MAX_ROTATION_POWER);
     mBowlingBallRotationArrow->SetRotation(GetRotation());
     mBowlingBallRotationArrow->Rotate(Vec3(0.0f, 0.0f, 45 * mRotationPower));
 }
@@ -149,6 +219,7 @@ void Player::Update()
         mBowlingBallForceDirArrow->SetLocation(Vec3(pos.x, pos.y, 0.01f));
         mBowlingBallForceDirArrow->SetRotation(GetRotation());
         mBowlingBallRotationArrow->SetLocation(Vec3(pos.x, pos.y, 0.02f));
+        UpdateTrajectoryPreview();
         mPinExtractor->SetLocation(Vec3::Lerp(mPinExtractor->GetLocation(),
             Vec3(mPinExtractor->GetLocation().x, mPinExtractor->GetLocation().y, 1.3f), 0.03f));
         if (mPinExtractor->GetLocation().z >= 1.25f)
@@ -157,15 +228,15 @@ void Player::Update()
         }
         break;
     case EBowlingState::Shoot:        
-        if (mBowlingBallThrow->GetLocation().y < 10.0f)
+        if (mBowlingBallThrow->GetLocation().y < PIN_WAKE_UP_Y)
         {
-            mCameraLeft = mBowlingBallThrow->GetLocation().x < -37.98f;
+            mCameraLeft = mBowlingBallThrow->GetLocation().x < PLAYER_POS_X;
             ChangeState(EBowlingState::CameraOnPin);
         }
         break;
     case EBowlingState::CameraOnPin:
         mTimer += 1 * Time::deltaTime;
-        if (mTimer > 2.0f)
+        if (mTimer > PIN_SETTLE_TIME)
         {
             ChangeState(EBowlingState::EndShoot);
         }
@@ -186,7 +257,11 @@ void Player::Update()
         {
             ChangeState(EBowlingState::PreShoot);
         }
-        mBowlingBallThrow->Destroy();
+        if (mBowlingBallThrow)
+        {
+            mBowlingBallPool->Despawn(mBowlingBallThrow);
+            mBowlingBallThrow = nullptr;
+        }
         break;
     case EBowlingState::EndGame:
         break;
@@ -199,14 +274,15 @@ void Player::ChangeState(EBowlingState newState)
     {
     case EBowlingState::Intro:
     case EBowlingState::PreShoot:
-        SetLocation(Vec3(-37.98f, 38.0f, 1.0f));
+        SetLocation(Vec3(PLAYER_POS_X, PLAYER_POS_Y, PLAYER_POS_Z));
         SetRotation(Quaternion::Identity);
         Rotate(Vec3(90.0f, 0.0f, 0.0f));
-        mPower = 0.7f;
+        mPower = PLAYER_DEFAULT_POWER;
         mRotationPower = 0.0f;
         ChangePower(0.0f);
         mBowlingBallForceDirArrow->GetComponent<MeshComponent>()->SetVisible(true);
         mBowlingBallRotationArrow->GetComponent<MeshComponent>()->SetVisible(true);
+        SetTrajectoryPreviewVisible(true);
         mBowlingball->SetLocation(GetLocation());
         break;
     case EBowlingState::Shoot:
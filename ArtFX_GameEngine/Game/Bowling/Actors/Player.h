@@ -1,7 +1,11 @@
 ﻿#pragma once
+#include <vector>
+
+#include "Bowling/BowlingConstants.h"
 #include "Bowling/BowlingState.h"
 #include "Core/Class/Actor/Actor.h"
 
+class ActorPool;
 class PinManager;
 class RigidbodyComponent;
 class BowlingController;
@@ -20,14 +24,19 @@ private:
     
     Actor* mBowlingball = nullptr;
     Actor* mBowlingBallThrow = nullptr;
+    ActorPool* mBowlingBallPool = nullptr;
     Actor* mBowlingBallForceDirArrow = nullptr;
     Actor* mBowlingBallRotationArrow = nullptr;
 
+    //Never registered in the physic engine, only used to predict the throw
+    RigidbodyComponent* mBowlingballRigidbody = nullptr;
+    std::vector<Actor*> mTrajectoryMarkers;
+
     Actor* mPinExtractor = nullptr;
 
     bool mCanShoot = false;
 
-    float mPower = 0.7f;
+    float mPower = PLAYER_DEFAULT_POWER;
     float mRotationPower = 0.0f;
 
     MeshComponent* mBowlingballMesh = nullptr;
@@ -38,10 +47,18 @@ private:
     
 public:
     Player();
-    ~Player() override = default;
+    ~Player() override;
 
     void Shoot();
 
+    static void LaunchBall(RigidbodyComponent* pBall, float pPower, float pRotationPower);
+    static void SetupBall(RigidbodyComponent* pBall);
+    static void GetLaunchImpulses(const Quaternion& pBallRotation, float pPower, float pRotationPower, Vec3& pOutImpulse, Vec3& pOutAngularImpulse);
+
+    Quaternion GetThrowRotation();
+    void UpdateTrajectoryPreview();
+    void SetTrajectoryPreviewVisible(bool pVisible);
+
     void Move(float movement);
     void Turn(float rotation);
 
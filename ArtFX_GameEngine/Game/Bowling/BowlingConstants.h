@@ -3,12 +3,46 @@
 //Pist
 const int PIST_AMOUNT = 12;
 const float PIST_OFFSET = 6.33f;
+const int PLAYER_PIST_INDEX = 6;
 
 //Pin
 const float PIN_MASS = 1.5f;
+const float PIN_RESTITUTION = 0.0f;
 const float PIN_POS_X = 38.0f;
 
 const float PIN_SPACING = 0.8f;
 const float PIN_ROW_HEIGHT = PIN_SPACING * 0.866f;
 
-const float ACCEPTANCE_ANGLE = 45.0f;
\ No newline at end of file
+const float ACCEPTANCE_ANGLE = 45.0f;
+
+//Pins wake up when the ball gets closer than this, and are counted after settling
+const float PIN_WAKE_UP_Y = 10.0f;
+const float PIN_SETTLE_TIME = 2.0f;
+const float PIN_KNOCKED_DISTANCE = 0.5f;
+
+//Player
+const float PLAYER_POS_X = -37.98f;
+const float PLAYER_POS_Y = 38.0f;
+const float PLAYER_POS_Z = 1.0f;
+const float PLAYER_MIN_X = -39.779f;
+const float PLAYER_MAX_X = -36.180f;
+const float PLAYER_MAX_TURN_ANGLE = 30.0f;
+
+const float PLAYER_DEFAULT_POWER = 0.7f;
+const float PLAYER_MIN_POWER = 0.5f;
+const float PLAYER_MAX_POWER = 1.0f;
+const float PLAYER_MAX_ROTATION_POWER = 1.0f;
+
+//Ball
+const float BALL_MASS = 100.8f;
+const float BALL_FRICTION = 0.15f;
+const float BALL_RESTITUTION = 0.0f;
+const float BALL_THROW_IMPULSE = 70.0f;
+const float BALL_SPIN_IMPULSE = 5.0f;
+//Thrown balls are recycled, the previous ball is despawned before the next throw
+const int BALL_POOL_SIZE = 2;
+
+//Aim preview, the predicted path is sampled by the markers
+const int TRAJECTORY_STEPS = 300;
+const int TRAJECTORY_MARKER_COUNT = 12;
+const float TRAJECTORY_MARKER_SCALE = 0.3f;
\ No newline at end of file
@@ -6,6 +6,7 @@ class Player;
 
 class BowlingController : public Component, IInputListener
 {
+    COMPONENT_TYPE(BowlingController, Component)
 private:
     Player* mPlayer;
     int mMouseDeltaX, mMouseDeltaY;
@@ -20,24 +20,35 @@ void PinManager::Start()
     mPinsBasePosition.reserve(10);
 
     int pinIndex = 10;
+    for (const Vec3& location : GetPinLayout())
+    {
+        Pin* pin = new Pin();
+        mScene->AddActor(pin);
+        
+        pin->SetName("Pin_" + std::to_string(pinIndex));
+        pin->SetLocation(location);
+        
+        mPins.push_back(pin);
+        mPinsBasePosition.push_back(pin->GetLocation());
+        pinIndex--;
+    }    
+}
+
+std::vector<Vec3> PinManager::GetPinLayout()
+{
+    std::vector<Vec3> layout;
+    layout.reserve(10);
     for (int i = 0; i < 4; i++)
     {
         int pinInJ = 4 - i;
         float start = -PIN_SPACING * 0.5f * (pinInJ - 1);
         
         for (int j = 0; j < pinInJ; j++)
-        {            
-            Pin* pin = new Pin();
-            mScene->AddActor(pin);
-            
-            pin->SetName("Pin_" + std::to_string(pinIndex));
-            pin->SetLocation(Vec3((start + j * PIN_SPACING) - PIN_POS_X, (i * PIN_ROW_HEIGHT) + 0.3f, 0.4f));
-            
-            mPins.push_back(pin);
-            mPinsBasePosition.push_back(pin->GetLocation());
-            pinIndex--;
+        {
+            layout.push_back(Vec3((start + j * PIN_SPACING) - PIN_POS_X, (i * PIN_ROW_HEIGHT) + 0.3f, 0.4f));
         }
-    }    
+    }
+    return layout;
 }
 
 void PinManager::Update()
@@ -64,7 +75,7 @@ int PinManager::CheckValidPin() const
     int result = 0;
     for (int i = 0; i < mPins.size(); i++)
     {
-        if (!mPins[i]->GetLocation().NearEquals(mPinsBasePosition[i], 0.5f))
+        if (!mPins[i]->GetLocation().NearEquals(mPinsBasePosition[i], PIN_KNOCKED_DISTANCE))
         {
             mPins[i]->SetHitted(true);
             result++;
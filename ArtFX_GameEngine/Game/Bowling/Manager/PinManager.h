@@ -20,6 +20,8 @@ public:
 
     void SetPinPhysisc(bool pEnable) const;
 
+    static std::vector<Vec3> GetPinLayout();
+
     int CheckValidPin() const;
     void ResetNoHittendPins() const;
     void ResetGame() const;
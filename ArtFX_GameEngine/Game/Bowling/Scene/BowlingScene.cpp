@@ -45,7 +45,7 @@ void BowlingScene::Start()
         bowlingPistMeshComponent->SetMesh(Asset::GetMesh("BowlingPist"));
         bowlingPistMeshComponent->AddTexture(Asset::GetTexture("BowlingPist"));
 
-        if (i == 6)
+        if (i == PLAYER_PIST_INDEX)
         {
             PlayerPinExtractor->SetLocation(Vec3(-PIST_OFFSET * i, 0.0f, 0.0f));
 
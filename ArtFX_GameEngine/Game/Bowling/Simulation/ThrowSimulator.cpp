@@ -0,0 +1,298 @@
+#include "ThrowSimulator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+#include "Bowling/Actors/Player.h"
+#include "Bowling/Manager/PinManager.h"
+#include "Core/Class/Actor/Actor.h"
+#include "Core/Physic/Component/BoxCollisionComponent.h"
+#include "Core/Physic/Component/PolyCollisionComponent.h"
+#include "Core/Physic/Component/RigidbodyComponent.h"
+#include "Core/Physic/Component/SphereCollisionComponent.h"
+#include "Core/Render/Asset.h"
+#include "Core/Render/Component/MeshComponent.h"
+#include "Debug/Log.h"
+#include "Math/Time.h"
+
+//A ball that never reaches the pins is given up after this time
+const float BALL_MAX_TRAVEL_TIME = 10.0f;
+
+static float GridValue(int pIndex, int pSteps, float pMin, float pMax, float pDefault)
+{
+    if (pSteps <= 1) return pDefault;
+    return pMin + (pMax - pMin) * static_cast<float>(pIndex) / static_cast<float>(pSteps - 1);
+}
+
+ThrowSimulationSettings ThrowSimulationSettings::FromCommandLine(int argc, char* argv[])
+{
+    ThrowSimulationSettings settings;
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        std::string argument = argv[i];
+        if (argument == "--threads") settings.threadCount = atoi(argv[++i]);
+        else if (argument == "--power-steps") settings.powerSteps = std::max(1, atoi(argv[++i]));
+        else if (argument == "--rotation-steps") settings.rotationSteps = std::max(1, atoi(argv[++i]));
+        else if (argument == "--angle-steps") settings.angleSteps = std::max(1, atoi(argv[++i]));
+        else if (argument == "--csv") settings.csvPath = argv[++i];
+    }
+    return settings;
+}
+
+ThrowSimulator::ThrowSimulator()
+{
+    //Components register their rigidbodies in the PhysicEngine bound to the thread
+    PhysicEngine::SetThreadInstance(&mPhysicEngine);
+
+    Vec3 laneLocation(-PIST_OFFSET * PLAYER_PIST_INDEX, 0.0f, 0.0f);
+
+    Actor* floor = SpawnActor(laneLocation);
+    RigidbodyComponent* floorRigidbody = new RigidbodyComponent(floor);
+    floorRigidbody->SetMass(0.0f);
+    floorRigidbody->SetFriction(0.0f);
+    new BoxCollisionComponent(floor, Asset::GetMesh("BowlingPistCollisionFloor").GetBoundingBox());
+
+    SpawnCollider("BowlingWallLeftCollision", laneLocation);
+    SpawnCollider("BowlingWallRightCollision", laneLocation);
+    SpawnCollider("BowlingDownCollision", laneLocation);
+
+    for (const Vec3& location : PinManager::GetPinLayout())
+    {
+        Actor* pin = SpawnActor(location);
+        MeshComponent* meshComponent = new MeshComponent(pin);
+        meshComponent->SetMesh(Asset::GetMesh("BowlingPin"));
+
+        RigidbodyComponent* rigidbody = new RigidbodyComponent(pin);
+        rigidbody->SetMass(0.0f);
+        rigidbody->SetRestitution(PIN_RESTITUTION);
+        new PolyCollisionComponent(pin);
+
+        mPins.push_back(pin);
+        mPinsBasePosition.push_back(location);
+    }
+
+    mBall = SpawnActor(Vec3(PLAYER_POS_X, PLAYER_POS_Y, PLAYER_POS_Z));
+    MeshComponent* ballMeshComponent = new MeshComponent(mBall);
+    ballMeshComponent->SetMesh(Asset::GetMesh("BowlingBall"));
+    new RigidbodyComponent(mBall);
+    new SphereCollisionComponent(mBall);
+
+    PhysicEngine::SetThreadInstance(nullptr);
+}
+
+ThrowSimulator::~ThrowSimulator()
+{
+    for (Actor* actor : mActors)
+    {
+        delete actor;
+    }
+}
+
+//Mirrors Scene::AddActor, which starts the actor a second time
+Actor* ThrowSimulator::SpawnActor(const Vec3& pLocation)
+{
+    Actor* actor = new Actor();
+    actor->Start();
+    actor->SetLocation(pLocation);
+    mActors.push_back(actor);
+    return actor;
+}
+
+Actor* ThrowSimulator::SpawnCollider(const std::string& pMeshName, const Vec3& pLocation)
+{
+    Actor* collider = SpawnActor(pLocation);
+    MeshComponent* meshComponent = new MeshComponent(collider);
+    meshComponent->SetMesh(Asset::GetMesh(pMeshName));
+
+    RigidbodyComponent* rigidbody = new RigidbodyComponent(collider);
+    rigidbody->SetMass(0.0f);
+    rigidbody->SetFriction(0.0f);
+    new BoxCollisionComponent(collider);
+    return collider;
+}
+
+ThrowResult ThrowSimulator::Simulate(const ThrowParameters& pParameters)
+{
+    //Same reset as PinManager::ResetGame, pins stay static until the ball gets close
+    for (size_t i = 0; i < mPins.size(); i++)
+    {
+        RigidbodyComponent* rigidbody = mPins[i]->GetComponent<RigidbodyComponent>();
+        rigidbody->ClearAll();
+        rigidbody->SetMass(0.0f);
+        mPins[i]->SetLocation(mPinsBasePosition[i]);
+        mPins[i]->SetRotation(Quaternion(0.0f, 0.0f, 0.0f, 1.0f));
+        mPins[i]->Rotate(Vec3(90.0f, 0.0f, 0.0f));
+    }
+
+    //Same rotation as the player after ChangeState(PreShoot) and Turn(), then Shoot()
+    RigidbodyComponent* ballRigidbody = mBall->GetComponent<RigidbodyComponent>();
+    ballRigidbody->ClearAll();
+    mBall->SetLocation(Vec3(PLAYER_POS_X, PLAYER_POS_Y, PLAYER_POS_Z));
+    mBall->SetRotation(Quaternion::Identity);
+    mBall->Rotate(Vec3(90.0f, 0.0f, 0.0f));
+    mBall->Rotate(Vec3(0.0f, 0.0f, pParameters.angle));
+    mBall->Rotate(Vec3(0.0f, 0.0f, -90.0f));
+    Player::LaunchBall(ballRigidbody, pParameters.power, pParameters.rotationPower);
+
+    ThrowResult result;
+    int maxTravelSteps = static_cast<int>(BALL_MAX_TRAVEL_TIME * Time::FPS);
+    while (mBall->GetLocation().y >= PIN_WAKE_UP_Y)
+    {
+        if (result.steps >= maxTravelSteps) return result;
+        mPhysicEngine.Update();
+        result.steps++;
+    }
+
+    for (Actor* pin : mPins)
+    {
+        pin->GetComponent<RigidbodyComponent>()->SetMass(PIN_MASS);
+    }
+
+    int settleSteps = static_cast<int>(PIN_SETTLE_TIME * Time::FPS);
+    for (int i = 0; i < settleSteps; i++)
+    {
+        mPhysicEngine.Update();
+    }
+    result.steps += settleSteps;
+
+    for (size_t i = 0; i < mPins.size(); i++)
+    {
+        if (!mPins[i]->GetLocation().NearEquals(mPinsBasePosition[i], PIN_KNOCKED_DISTANCE))
+        {
+            result.knockedPins++;
+        }
+    }
+    return result;
+}
+
+void ThrowSimulator::LoadAssets()
+{
+    Asset::LoadMesh("Bowling/BowlingPin.obj", "BowlingPin", false);
+    Asset::LoadMesh("Bowling/BowlingBall.obj", "BowlingBall", false);
+    Asset::LoadMesh("Bowling/Collision/BowlingPistCollisionFloor.obj", "BowlingPistCollisionFloor", false);
+    Asset::LoadMesh("Bowling/Collision/BowlingWallLeftCollision.obj", "BowlingWallLeftCollision", false);
+    Asset::LoadMesh("Bowling/Collision/BowlingWallRightCollision.obj", "BowlingWallRightCollision", false);
+    Asset::LoadMesh("Bowling/Collision/BowlingDownCollision.obj", "BowlingDownCollision", false);
+}
+
+int ThrowSimulator::Run(const ThrowSimulationSettings& pSettings)
+{
+    LoadAssets();
+
+    std::vector<ThrowParameters> throws;
+    throws.reserve(static_cast<size_t>(pSettings.powerSteps) * pSettings.rotationSteps * pSettings.angleSteps);
+    for (int p = 0; p < pSettings.powerSteps; p++)
+    {
+        for (int r = 0; r < pSettings.rotationSteps; r++)
+        {
+            for (int a = 0; a < pSettings.angleSteps; a++)
+            {
+                ThrowParameters parameters;
+                parameters.power = GridValue(p, pSettings.powerSteps, PLAYER_MIN_POWER, PLAYER_MAX_POWER, PLAYER_DEFAULT_POWER);
+                parameters.rotationPower = GridValue(r, pSettings.rotationSteps, -PLAYER_MAX_ROTATION_POWER, PLAYER_MAX_ROTATION_POWER, 0.0f);
+                parameters.angle = GridValue(a, pSettings.angleSteps, -PLAYER_MAX_TURN_ANGLE, PLAYER_MAX_TURN_ANGLE, 0.0f);
+                throws.push_back(parameters);
+            }
+        }
+    }
+
+    int threadCount = pSettings.threadCount > 0 ? pSettings.threadCount : static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::clamp(threadCount, 1, std::max(1, static_cast<int>(throws.size())));
+    Log::Info("Simulating " + std::to_string(throws.size()) + " throws on " + std::to_string(threadCount) + " threads");
+
+    //Each worker owns a lane and pulls the next throw, results are written to their own slot
+    std::vector<ThrowResult> results(throws.size());
+    std::atomic<size_t> nextThrow = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers.emplace_back([&throws, &results, &nextThrow]()
+        {
+            ThrowSimulator simulator;
+            for (size_t index = nextThrow++; index < throws.size(); index = nextThrow++)
+            {
+                results[index] = simulator.Simulate(throws[index]);
+            }
+        });
+    }
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    //Statistics
+    long long totalSteps = 0;
+    int totalPins = 0;
+    int histogram[11] = {};
+    for (const ThrowResult& result : results)
+    {
+        totalSteps += result.steps;
+        totalPins += result.knockedPins;
+        histogram[std::clamp(result.knockedPins, 0, 10)]++;
+    }
+
+    float throwCount = static_cast<float>(std::max<size_t>(1, results.size()));
+    Log::Info("Average pins : " + std::to_string(totalPins / throwCount) +
+        " | Strikes : " + std::to_string(100.0f * histogram[10] / throwCount) + "%");
+    for (int pins = 0; pins <= 10; pins++)
+    {
+        Log::Info("  " + std::to_string(pins) + " pins : " + std::to_string(histogram[pins]));
+    }
+
+    //Average pins for each value of a parameter, all the others included
+    auto logAverages = [&](const std::string& pName, int pSteps, auto pGetValue, auto pGetIndex)
+    {
+        for (int step = 0; step < pSteps; step++)
+        {
+            int count = 0, pins = 0;
+            float value = 0.0f;
+            for (size_t i = 0; i < throws.size(); i++)
+            {
+                if (pGetIndex(i) != step) continue;
+                value = pGetValue(throws[i]);
+                pins += results[i].knockedPins;
+                count++;
+            }
+            Log::Info(pName + " " + std::to_string(value) + " : " + std::to_string(count > 0 ? static_cast<float>(pins) / count : 0.0f) + " pins");
+        }
+    };
+    size_t angleSteps = pSettings.angleSteps;
+    size_t rotationSteps = pSettings.rotationSteps;
+    logAverages("Power", pSettings.powerSteps, [](const ThrowParameters& t) { return t.power; },
+        [&](size_t i) { return static_cast<int>(i / (angleSteps * rotationSteps)); });
+    logAverages("Rotation", pSettings.rotationSteps, [](const ThrowParameters& t) { return t.rotationPower; },
+        [&](size_t i) { return static_cast<int>(i / angleSteps % rotationSteps); });
+    logAverages("Angle", pSettings.angleSteps, [](const ThrowParameters& t) { return t.angle; },
+        [&](size_t i) { return static_cast<int>(i % angleSteps); });
+
+    Log::Info("Simulated " + std::to_string(totalSteps) + " physics steps in " + std::to_string(seconds) + "s : " +
+        std::to_string(totalSteps / std::max(seconds, 1e-6)) + " steps/s, " +
+        std::to_string(results.size() / std::max(seconds, 1e-6)) + " throws/s");
+
+    if (!pSettings.csvPath.empty())
+    {
+        std::ofstream csv(pSettings.csvPath);
+        if (!csv)
+        {
+            Log::Error(LogType::Error, "Could not write " + pSettings.csvPath);
+            return 1;
+        }
+        csv << "power,rotation,angle,knockedPins,steps\n";
+        for (size_t i = 0; i < throws.size(); i++)
+        {
+            csv << throws[i].power << ',' << throws[i].rotationPower << ',' << throws[i].angle << ','
+                << results[i].knockedPins << ',' << results[i].steps << '\n';
+        }
+        Log::Info("Results written to " + pSettings.csvPath);
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "Bowling/BowlingConstants.h"
+#include "Core/Physic/PhysicEngine.h"
+
+class Actor;
+
+struct ThrowParameters
+{
+    float power = PLAYER_DEFAULT_POWER;
+    float rotationPower = 0.0f;
+    //Turn of the player in degrees, positive to the left
+    float angle = 0.0f;
+};
+
+struct ThrowResult
+{
+    int knockedPins = 0;
+    int steps = 0;
+};
+
+struct ThrowSimulationSettings
+{
+    int powerSteps = 6;
+    int rotationSteps = 9;
+    int angleSteps = 13;
+    //0 uses one thread per hardware core
+    int threadCount = 0;
+    std::string csvPath;
+
+    static ThrowSimulationSettings FromCommandLine(int argc, char* argv[]);
+};
+
+//Headless copy of the player lane, owning its own PhysicEngine so several simulators can run in parallel
+class ThrowSimulator
+{
+private:
+    PhysicEngine mPhysicEngine;
+
+    std::vector<Actor*> mActors;
+    std::vector<Actor*> mPins;
+    std::vector<Vec3> mPinsBasePosition;
+    Actor* mBall = nullptr;
+
+    Actor* SpawnActor(const Vec3& pLocation);
+    Actor* SpawnCollider(const std::string& pMeshName, const Vec3& pLocation);
+
+public:
+    ThrowSimulator();
+    ~ThrowSimulator();
+
+    ThrowSimulator(const ThrowSimulator&) = delete;
+    ThrowSimulator& operator=(const ThrowSimulator&) = delete;
+
+    ThrowResult Simulate(const ThrowParameters& pParameters);
+
+    static void LoadAssets();
+    static int Run(const ThrowSimulationSettings& pSettings);
+};
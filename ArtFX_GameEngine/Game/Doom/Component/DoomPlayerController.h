@@ -9,6 +9,7 @@ class DoomPlayer;
 
 class DoomPlayerController : public Component, public IInputListener
 {
+    COMPONENT_TYPE(DoomPlayerController, Component)
 private:
 
     int mMouseDeltaX, mMouseDeltaY;
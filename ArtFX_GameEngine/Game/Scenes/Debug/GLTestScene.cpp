@@ -5,16 +5,25 @@
 #include "Bowling/Manager/PinManager.h"
 #include "Core/Class/Actor/Actor.h"
 #include "Core/Physic/Force.h"
+#include "Core/Physic/Component/BoxCollisionComponent.h"
+#include "Core/Physic/Component/BuoyancyComponent.h"
+#include "Core/Physic/Component/HeightfieldCollisionComponent.h"
 #include "Core/Physic/Component/PolyCollisionComponent.h"
 #include "Core/Physic/Component/RigidbodyComponent.h"
 #include "Core/Physic/Component/SphereCollisionComponent.h"
+#include "Core/Physic/Component/WaterVolumeComponent.h"
 #include "Core/Render/Asset.h"
 #include "Core/Render/Component/MeshComponent.h"
 #include "Core/Render/Component/SpriteComponent.h"
+#include "Core/Render/Shader/ShaderCache.h"
 #include "Debug/Log.h"
 #include "Math/Time.h"
 #include "Miscellaneous/Component/FpsCameraMovement.h"
 
+const float WATER_AMPLITUDE = 0.12f;
+const float WATER_FREQUENCY = 1.5f;
+const float WATER_SPEED = 0.8f;
+
 GLTestScene::GLTestScene()
 {
 }
@@ -37,6 +46,9 @@ void GLTestScene::Start()
     floor->SetName("Floor");
 
     floor->SetLocation(Vec3(0.0f, 0.0f, -10.0f));
+    //Sand.obj is modelled Y up and the heightfield is built along its local Y, map it to the world Z up
+    floor->SetRotation(Quaternion::Identity);
+    floor->Rotate(Vec3(90.0f, 0.0f, 0.0f));
 
     MeshComponent* floorMeshComponent = new MeshComponent(floor);
     floorMeshComponent->SetMesh(Asset::GetMesh("Sand"));
@@ -44,43 +56,76 @@ void GLTestScene::Start()
     floorMeshComponent->GetMesh()->SetNoiseTexture(Asset::GetTexture("SandNoise"));
     
 
-    mTessVertexShader.Load("SimpleTess.vert", ShaderType::VERTEX);
-    mTessFragShader.Load("SimpleTess.frag", ShaderType::FRAGMENT);
-    mTessControlShader.Load("SimpleTess.tesc", ShaderType::TESSELLATION_CONTROL);
-    mTessEvalShader.Load("SimpleTess.tese", ShaderType::TESSELLATION_EVALUATION);
-
-    mTessProgram.Compose({ &mTessVertexShader, &mTessFragShader, &mTessControlShader, &mTessEvalShader });
+    mTessProgram = ShaderCache::GetProgram({
+        {"SimpleTess.vert", ShaderType::VERTEX},
+        {"SimpleTess.frag", ShaderType::FRAGMENT},
+        {"SimpleTess.tesc", ShaderType::TESSELLATION_CONTROL},
+        {"SimpleTess.tese", ShaderType::TESSELLATION_EVALUATION}
+    });
     floorMeshComponent->GetMesh()->SetShaderProgram(mTessProgram);
     
     floorMeshComponent->SetUseTessellation(true);
     floorMeshComponent->SetTessellationLevel(35);
     floorMeshComponent->SetDisplacementScale(7.0f);
 
+    RigidbodyComponent* floorRigidbody = new RigidbodyComponent(floor);
+    floorRigidbody->SetMass(0.0f);
+    new HeightfieldCollisionComponent(floor, Asset::GetTexture("SandNoise"), floorMeshComponent->GetDisplacementScale());
+
     Actor* water = new Actor();
     AddActor(water);
     
     water->SetName("Water");
 
     water->SetLocation(Vec3(0.0f, 0.0f, 4.0f));
+    //Water.obj is modelled Y up, the buoyancy pushes along the local Y of the volume
+    water->SetRotation(Quaternion::Identity);
+    water->Rotate(Vec3(90.0f, 0.0f, 0.0f));
 
     MeshComponent* waterMeshComponent = new MeshComponent(water);
     waterMeshComponent->SetMesh(Asset::GetMesh("Water"));
     waterMeshComponent->AddTexture(Asset::GetTexture("VoronoiNoise"));
     waterMeshComponent->GetMesh()->SetNoiseTexture(Asset::GetTexture("VoronoiNoise"));
 
-    mTessWaterFragShader.Load("WaterTess.frag", ShaderType::FRAGMENT);
-    mTessWaterEvalShader.Load("WaterTess.tese", ShaderType::TESSELLATION_EVALUATION);
-
-    mTessWaterProgram.Compose({ &mTessVertexShader, &mTessWaterFragShader, &mTessControlShader, &mTessWaterEvalShader });
+    mTessWaterProgram = ShaderCache::GetProgram({
+        {"SimpleTess.vert", ShaderType::VERTEX},
+        {"WaterTess.frag", ShaderType::FRAGMENT},
+        {"SimpleTess.tesc", ShaderType::TESSELLATION_CONTROL},
+        {"WaterTess.tese", ShaderType::TESSELLATION_EVALUATION}
+    });
     waterMeshComponent->GetMesh()->SetShaderProgram(mTessWaterProgram);
-    waterMeshComponent->GetMesh()->GetShaderProgram().setFloat("uAmplitude", 0.12f);
-    waterMeshComponent->GetMesh()->GetShaderProgram().setFloat("uFrequency", 1.5f);
-    waterMeshComponent->GetMesh()->GetShaderProgram().setFloat("uSpeed", 0.8f);
+    mTessWaterProgram->Use();
+    mTessWaterProgram->setFloat("uAmplitude", WATER_AMPLITUDE);
+    mTessWaterProgram->setFloat("uFrequency", WATER_FREQUENCY);
+    mTessWaterProgram->setFloat("uSpeed", WATER_SPEED);
 
     
     waterMeshComponent->GetMesh()->SetShaderProgram(mTessWaterProgram);
     waterMeshComponent->SetUseTessellation(true);
     waterMeshComponent->SetTessellationLevel(35);
+
+    WaterVolumeComponent* waterVolume = new WaterVolumeComponent(water, Asset::GetTexture("VoronoiNoise"));
+    waterVolume->SetWave(WATER_AMPLITUDE, WATER_FREQUENCY, WATER_SPEED);
+
+    //Floating boxes
+    for (int i = 0; i < 3; i++)
+    {
+        Actor* box = new Actor();
+        AddActor(box);
+
+        box->SetName("FloatingBox" + std::to_string(i));
+        box->SetLocation(Vec3(200.0f, -40.0f + 40.0f * i, 10.0f));
+        box->SetScale(Vec3(4.0f, 4.0f, 4.0f));
+
+        MeshComponent* boxMeshComponent = new MeshComponent(box);
+        boxMeshComponent->SetMesh(Asset::GetMesh("Box"));
+        boxMeshComponent->AddTexture(Asset::GetTexture("Jenga"));
+
+        RigidbodyComponent* boxRigidbody = new RigidbodyComponent(box);
+        boxRigidbody->SetMass(1.0f);
+        new BoxCollisionComponent(box);
+        new BuoyancyComponent(box, waterVolume);
+    }
 }
 
 void GLTestScene::Update()
@@ -5,8 +5,8 @@ class GLTestScene : public Scene
 {
 private:
 
-    Shader mTessVertexShader, mTessFragShader, mTessControlShader, mTessEvalShader, mTessWaterFragShader, mTessWaterEvalShader;
-    ShaderProgram mTessProgram, mTessWaterProgram;
+    ShaderProgram* mTessProgram = nullptr;
+    ShaderProgram* mTessWaterProgram = nullptr;
     
 public:
     GLTestScene();
@@ -8,6 +8,11 @@
 #include <SDL.h>
 
 #include "Bowling/Scene/BowlingScene.h"
+#include "Bowling/Simulation/ThrowSimulator.h"
+#include "Core/Class/Scene/FileScene.h"
+#include "Core/Render/Shader/ShaderCache.h"
+#include "Debug/ComponentBenchmark.h"
+#include "Debug/SceneLoadBenchmark.h"
 #include "Doom/Scene/DoomScene.h"
 #include "Scenes/Base/BaseScene.h"
 #include "Scenes/Debug/GLTestScene.h"
@@ -20,8 +25,49 @@
  */
 int main(int argc, char* argv[])
 {
+	// Run the headless throw simulator instead of the game.
+	if (argc > 1 && std::string(argv[1]) == "--simulate-throws")
+	{
+		return ThrowSimulator::Run(ThrowSimulationSettings::FromCommandLine(argc, argv));
+	}
+
+	// Time Actor::GetComponent against the dynamic_cast scan.
+	if (argc > 1 && std::string(argv[1]) == "--benchmark-components")
+	{
+		return ComponentBenchmark::Run(argc > 2 ? std::stoi(argv[2]) : 10000);
+	}
+
+	// Time mapping and instantiating a scene file.
+	if (argc > 2 && std::string(argv[1]) == "--benchmark-scene-load")
+	{
+		return SceneLoadBenchmark::Run(argv[2], argc > 3 ? std::stoi(argv[3]) : 100);
+	}
+
+	// Time the startup of a scene, then exit. --no-shader-cache compiles a program per mesh and collision as before the cache.
+	// --no-program-binaries links from source, run twice without it to time a cold then a warm start.
+	// Runs under a software GL context with Mesa, LIBGL_ALWAYS_SOFTWARE=1 or its opengl32.dll next to the executable.
+	if (argc > 1 && std::string(argv[1]) == "--benchmark-startup")
+	{
+		std::string option = argv[argc - 1];
+		int sceneIndex = argc > 2 && argv[2][0] != '-' ? std::stoi(argv[2]) : 0;
+		ShaderCache::SetEnabled(option != "--no-shader-cache");
+		if (option == "--no-program-binaries") ShaderCache::SetBinaryDirectory("");
+		Game* game = new Game("XCore - DebugEngine", {new BowlingScene(), new DoomScene()}, sceneIndex);
+		game->SetExitAfterStart(true);
+		game->Initialize();
+		return 0;
+	}
+
+	// Play a scene file exported with F12.
+	if (argc > 2 && std::string(argv[1]) == "--scene")
+	{
+		Game* game = new Game("XCore - DebugEngine", {new FileScene(argv[2])});
+		game->Initialize();
+		return 0;
+	}
+
 	// Create a new game instance with the specified scenes.
-	Game* game = new Game("XCore - DebugEngine", {new BowlingScene()});
+	Game* game = new Game("XCore - DebugEngine", {new BowlingScene(), new DoomScene()});
 	
 	// Initialize the game engine.
 	game->Initialize();
@@ -1,14 +1,29 @@
 #version 460 core
 
+// Quantized within the bounds of the mesh, the world transform scales it back
 layout(location = 0) in vec3 pos;
 layout(location = 2) in vec2 texCoord;
 
+#ifdef INSTANCED
+// One world matrix per instance, streamed from the instance buffer of the renderer
+layout(location = 3) in mat4 aWorldTransform;
+#else
 uniform mat4 uWorldTransform;
-uniform mat4 uViewProj;
+#endif
+layout(std140, row_major) uniform FrameData
+{
+    mat4 uViewProj;
+    float uTime;
+};
 
 out vec2 fragTexCoord;
 void main()
 {
+#ifdef INSTANCED
+    // The rows of the world matrix arrive as the columns of aWorldTransform, so it multiplies on the left
+    gl_Position = (aWorldTransform * vec4(pos, 1.0)) * uViewProj;
+#else
     gl_Position = vec4(pos, 1.0) * uWorldTransform * uViewProj;
+#endif
     fragTexCoord = texCoord;
 }
\ No newline at end of file
@@ -4,7 +4,11 @@ layout(location = 0) in vec3 pos;
 layout(location = 2) in vec2 texCoord;
 
 uniform mat4 uWorldTransform;
-uniform mat4 uViewProj;
+layout(std140, row_major) uniform FrameData
+{
+    mat4 uViewProj;
+    float uTime;
+};
 
 out vec2 fragTexCoord;
 out vec3 position;
@@ -1,12 +1,13 @@
 #version 450 core
 
+// Quantized within the bounds of the mesh, uVertexTransform scales it back
 layout(location = 0) in vec3 pos;
-layout(location = 1) in vec3 normal;
+// Octahedral encoded, decode with vec3(n, 1.0 - abs(n.x) - abs(n.y)) unfolded when z < 0
+layout(location = 1) in vec2 normal;
 layout(location = 2) in vec2 texCoord;
 
 
-uniform mat4 uWorldTransform;
-uniform mat4 uViewProj;
+uniform mat4 uVertexTransform;
 uniform vec2 uTiling;
 
 out VS_OUT{
@@ -16,7 +17,8 @@ out VS_OUT{
 
 void main()
 {
-    gl_Position = vec4(pos, 1.0) * uWorldTransform * uViewProj;
+    // Kept in mesh space, the evaluation stage displaces it along the mesh Y then projects it
+    gl_Position = vec4(pos, 1.0) * uVertexTransform;
     vs_out.color = vec4(pos, 1.0);
     vs_out.texCoord = texCoord * uTiling;
 }